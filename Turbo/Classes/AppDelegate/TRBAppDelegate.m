@@ -22,15 +22,16 @@
  */
 
 #import "TRBAppDelegate.h"
-#import "NSData+Base64.h"
 #import "TRBTVShowsStorage.h"
 #import "TRBTVShowsViewController.h"
 #import "TRBTVShowEpisode.h"
 #import "TRBTVShowSeason.h"
 #import "TRBTVShow.h"
+#import "TRBTVShowNotificationScheduler.h"
 #import "TRBTabBarController.h"
 #import "TRBHost.h"
 #import "TRBTorrentClient.h"
+#import "TRBTorrentMetainfo.h"
 #import "TRBHostSelectionController.h"
 #import "TKAlertCenter.h"
 
@@ -82,17 +83,25 @@
 - (BOOL)application:(UIApplication *)application openURL:(NSURL *)url sourceApplication:(NSString *)sourceApplication annotation:(id)annotation {
 	LogV(@"open url: %@", url);
 	LogV(@"annotation: %@", annotation);
+	NSData * torrentData = nil;
+	if ([url isFileURL]) {
+		// Files that aren't torrents are turned down here rather than by the host.
+		NSError * error = nil;
+		torrentData = [NSData dataWithContentsOfURL:url options:NSDataReadingMappedIfSafe error:&error];
+		TRBTorrentMetainfo * metainfo = torrentData ? [TRBTorrentMetainfo metainfoWithData:torrentData error:&error] : nil;
+		if (!metainfo) {
+			[[TKAlertCenter defaultCenter] postAlertWithMessage:[error localizedDescription]];
+			return NO;
+		}
+		LogV(@"torrent %@: %@, %lld bytes in %lu files", metainfo.infoHash, metainfo.name, metainfo.totalLength, (unsigned long)[metainfo.files count]);
+	}
 	[self pickHostWithCompletion:^(TRBHost * host) {
-		if ([url isFileURL]) {
-			NSData * torrentData = [NSData dataWithContentsOfURL:url];
-			NSString * base64String = [torrentData base64EncodedString];
-			if ([base64String length]) {
-				[host.client addTorrentWithBase64String:base64String completion:^(BOOL success, NSError * error) {
-					LogV(@"success: %i", success);
-					NSString * message = success ? @"Torrent added" : [error localizedDescription];
-					[[TKAlertCenter defaultCenter] postAlertWithMessage:message];
-				}];
-			}
+		if (torrentData) {
+			[host.client addTorrentWithData:torrentData completion:^(BOOL success, NSError * error) {
+				LogV(@"success: %i", success);
+				NSString * message = success ? @"Torrent added" : [error localizedDescription];
+				[[TKAlertCenter defaultCenter] postAlertWithMessage:message];
+			}];
 		} else {
 			[host.client addTorrentAtURL:[url absoluteString] completion:^(BOOL success, NSError * error) {
 				LogV(@"success: %i", success);
@@ -142,7 +151,7 @@
 																object:nil
 															  userInfo:@{TRBTVShowEpisodeKey: episode}];
 		}
-		[[UIApplication sharedApplication] cancelLocalNotification:note];
+		[[TRBTVShowNotificationScheduler sharedInstance] cancelNotificationForEpisodeID:episodeID];
 	}];
 }
 
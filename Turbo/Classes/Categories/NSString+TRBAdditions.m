@@ -22,7 +22,7 @@
  */
 
 #import "NSString+TRBAdditions.h"
-#import "NSData+Base64.h"
+#import "TRBBase64.h"
 
 #define kTVShowRegexes 3
 #define kMovieRegexes 4
@@ -87,10 +87,31 @@ NSRange TRBRangeOfMovieIdentifier(NSString * string) {
 }
 
 - (NSData *)base64Data {
-	NSData * selfData = [self dataUsingEncoding:NSUTF8StringEncoding];
-	size_t outputLength = 0;
-	char * outputBuffer = NewBase64Encode([selfData bytes], [selfData length], true, &outputLength);
-	return [NSData dataWithBytesNoCopy:outputBuffer length:outputLength freeWhenDone:YES];
+	// Reads the UTF-8 bytes in place when the string already stores them that way.
+	const char * bytes = CFStringGetCStringPtr((__bridge CFStringRef)self, kCFStringEncodingUTF8);
+	NSData * selfData = nil;
+	size_t length = 0;
+	if (bytes) {
+		length = strlen(bytes);
+	} else {
+		selfData = [self dataUsingEncoding:NSUTF8StringEncoding];
+		bytes = [selfData bytes];
+		length = [selfData length];
+	}
+	// Same output as NewBase64Encode with separateLines: a CR/LF pair after every
+	// 64 characters, none after the last line.
+	static const size_t lineLength = 48;
+	size_t breaks = length ? (length - 1) / lineLength : 0;
+	NSMutableData * result = [NSMutableData dataWithLength:TRBBase64EncodedLength(length) + breaks * 2];
+	char * output = [result mutableBytes];
+	for (size_t i = 0; i < length; i += lineLength) {
+		if (i) {
+			*output++ = '\r';
+			*output++ = '\n';
+		}
+		output += TRBBase64Encode((const uint8_t *)bytes + i, MIN(lineLength, length - i), output);
+	}
+	return result;
 }
 
 - (NSString *)schemeAndHost {
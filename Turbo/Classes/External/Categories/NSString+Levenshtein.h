@@ -11,6 +11,10 @@
 // calculate the smallest distance between all words in stringA and stringB
 - (float) compareWithString: (NSString *) stringB;
 
+// same as compareWithString: but stops as soon as the result is known to
+// be larger than maxDistance, returning a value larger than maxDistance
+- (float) compareWithString: (NSString *) stringB maxDistance: (float) maxDistance;
+
 // calculate the distance between two string treating them each as a
 // single word
 - (float) compareWithWord: (NSString *) stringB;
@@ -5,55 +5,81 @@
 //  Rick@Bourner.com
 
 #import "NSString+Levenshtein.h"
+#import "TRBEditDistance.h"
 
 @implementation NSString (Levenshtein)
 
-// calculate the mean distance between all words in stringA and stringB
-- (float) compareWithString: (NSString *) stringB
-{
-	float averageSmallestDistance = 0.0;
-	float smallestDistance;
-	float distance;
-
-	NSMutableString * mStringA = [[NSMutableString alloc]  initWithString: self];
-	NSMutableString * mStringB = [[NSMutableString alloc]  initWithString: stringB];
-
-
-	// normalize
-	[mStringA replaceOccurrencesOfString:@"\n"
-                              withString: @" "
-                                 options: NSLiteralSearch
-                                   range: NSMakeRange(0, [mStringA  length])];
-
-	[mStringB replaceOccurrencesOfString:@"\n"
-                              withString: @" "
-                                 options: NSLiteralSearch
-                                   range: NSMakeRange(0, [mStringB  length])];
-
-	NSArray * arrayA = [mStringA componentsSeparatedByString: @" "];
-	NSArray * arrayB = [mStringB componentsSeparatedByString: @" "];
-
-	NSEnumerator * emuA = [arrayA objectEnumerator];
-	NSEnumerator * emuB;
+#define TRBLevenshteinStackLength 256
 
-	NSString * tokenA = NULL;
-	NSString * tokenB = NULL;
+static unichar * TRBCopyCharacters(NSString * string, unichar * stackBuffer, NSUInteger length)
+{
+	unichar * characters = length <= TRBLevenshteinStackLength ? stackBuffer : malloc(length * sizeof(unichar));
+	[string getCharacters: characters range: NSMakeRange(0, length)];
+	return characters;
+}
 
-	// O(n*m) but is there another way ?!?
-	while ( tokenA = [emuA nextObject] ) {
+static NSUInteger TRBTokenEnd(const unichar * characters, NSUInteger length, NSUInteger start)
+{
+	while ( start < length && characters[start] != ' ' && characters[start] != '\n' )
+		start++;
+	return start;
+}
 
-		emuB = [arrayB objectEnumerator];
-		smallestDistance = 99999999.0;
+// calculate the mean distance between all words in stringA and stringB
+- (float) compareWithString: (NSString *) stringB
+{
+	return [self compareWithString: stringB maxDistance: MAXFLOAT];
+}
 
-		while ( tokenB = [emuB nextObject] )
-			if ( (distance = [tokenA compareWithWord: tokenB] ) <  smallestDistance )
+- (float) compareWithString: (NSString *) stringB maxDistance: (float) maxDistance
+{
+	// the characters are extracted once, words are ranges split on spaces and newlines
+	NSString * stringA = [self lowercaseString];
+	stringB = [stringB lowercaseString];
+	NSUInteger lengthA = [stringA length];
+	NSUInteger lengthB = [stringB length];
+	unichar stackA[TRBLevenshteinStackLength];
+	unichar stackB[TRBLevenshteinStackLength];
+	unichar * charactersA = TRBCopyCharacters(stringA, stackA, lengthA);
+	unichar * charactersB = TRBCopyCharacters(stringB, stackB, lengthB);
+
+	NSUInteger countA = 1;
+	for ( NSUInteger i = 0; i < lengthA; i++ )
+		if ( charactersA[i] == ' ' || charactersA[i] == '\n' )
+			countA++;
+
+	// words longer than the stack rows share one growing buffer
+	TRBEditDistanceScratch scratch;
+	TRBEditDistanceScratchInit(&scratch);
+	float budget = maxDistance * countA;
+	float totalDistance = 0.0;
+	NSUInteger startA = 0;
+	while ( startA <= lengthA ) {
+		NSUInteger endA = TRBTokenEnd(charactersA, lengthA, startA);
+		size_t smallestDistance = SIZE_MAX - 1;
+		NSUInteger startB = 0;
+		while ( startB <= lengthB && smallestDistance ) {
+			NSUInteger endB = TRBTokenEnd(charactersB, lengthB, startB);
+			size_t distance = 0;
+			// empty words always had a distance of 0
+			if ( endA > startA && endB > startB )
+				distance = TRBEditDistance(charactersA + startA, endA - startA, charactersB + startB, endB - startB, smallestDistance, &scratch);
+			if ( distance < smallestDistance )
 				smallestDistance = distance;
-
-		averageSmallestDistance += smallestDistance;
-
+			startB = endB + 1;
+		}
+		totalDistance += smallestDistance;
+		if ( totalDistance > budget )
+			break;
+		startA = endA + 1;
 	}
 
-	return averageSmallestDistance / [arrayA count];
+	TRBEditDistanceScratchDestroy(&scratch);
+	if ( charactersA != stackA )
+		free( charactersA );
+	if ( charactersB != stackB )
+		free( charactersB );
+	return totalDistance / countA;
 }
 
 
@@ -61,57 +87,23 @@
 // single word
 - (float) compareWithWord: (NSString *) stringB
 {
-	// normalize strings
-	NSString * stringA = [NSString stringWithString: self];
-	[stringA stringByTrimmingCharactersInSet:
-	 [NSCharacterSet whitespaceAndNewlineCharacterSet]];
-	[stringB stringByTrimmingCharactersInSet:
-	 [NSCharacterSet whitespaceAndNewlineCharacterSet]];
-	stringA = [stringA lowercaseString];
+	NSString * stringA = [self lowercaseString];
 	stringB = [stringB lowercaseString];
-
-
-	// Step 1
-	NSInteger k, i, j, cost, * d, distance;
-
-	NSInteger n = [stringA length];
-	NSInteger m = [stringB length];
-
-	if( n++ != 0 && m++ != 0 ) {
-
-		d = malloc( sizeof(NSInteger) * m * n );
-
-		// Step 2
-		for( k = 0; k < n; k++)
-			d[k] = k;
-
-		for( k = 0; k < m; k++)
-			d[ k * n ] = k;
-
-		// Step 3 and 4
-		for( i = 1; i < n; i++ )
-			for( j = 1; j < m; j++ ) {
-
-				// Step 5
-				if( [stringA characterAtIndex: i-1] ==
-				   [stringB characterAtIndex: j-1] )
-					cost = 0;
-				else
-					cost = 1;
-
-				// Step 6
-				d[ j * n + i ] = [self smallestOf: d [ (j - 1) * n + i ] + 1
-											andOf: d[ j * n + i - 1 ] +  1
-											andOf: d[ (j - 1) * n + i -1 ] + cost ];
-			}
-
-		distance = d[ n * m - 1 ];
-
-		free( d );
-
-		return distance;
-	}
-	return 0.0;
+	NSUInteger n = [stringA length];
+	NSUInteger m = [stringB length];
+	if ( n == 0 || m == 0 )
+		return 0.0;
+
+	unichar stackA[TRBLevenshteinStackLength];
+	unichar stackB[TRBLevenshteinStackLength];
+	unichar * charactersA = TRBCopyCharacters(stringA, stackA, n);
+	unichar * charactersB = TRBCopyCharacters(stringB, stackB, m);
+	size_t distance = TRBEditDistance(charactersA, n, charactersB, m, SIZE_MAX - 1, NULL);
+	if ( charactersA != stackA )
+		free( charactersA );
+	if ( charactersB != stackB )
+		free( charactersB );
+	return distance;
 }
 
 
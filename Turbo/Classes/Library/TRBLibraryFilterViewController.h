@@ -26,6 +26,7 @@
 @interface TRBLibraryFilterViewController : UITableViewController
 @property (nonatomic, assign) TRBLibraryFilterName selectedFilter;
 @property (nonatomic, readonly) NSDictionary * filter;
+@property (nonatomic, readonly) NSPredicate * predicate;
 @property (nonatomic, readonly) NSString * filterDescription;
 @end
 
@@ -22,6 +22,7 @@
  */
 
 #import "TRBLibraryFilterViewController.h"
+#import "TRBLibraryStorage.h"
 
 @implementation TRBLibraryFilterViewController {
 	@protected
@@ -30,6 +31,7 @@
 }
 
 @dynamic filter;
+@dynamic predicate;
 
 @end
 
@@ -77,13 +79,22 @@
 	return result;
 }
 
+- (NSPredicate *)predicate {
+	NSPredicate * result = nil;
+	if (_selectedFilter == TRBLibraryFilterRecentlyAdded)
+		result = [NSPredicate predicateWithFormat:@"recentlyAdded == YES"];
+	return result;
+}
+
 @end
 
 static NSDictionary * TRBFilterMap = nil;
+static NSDictionary * TRBFilterKeyMap = nil;
 
 @implementation TRBLibrarySpecificSelectionViewController {
 	NSArray * _filterList;
 	NSDictionary * _filter;
+	NSPredicate * _predicate;
 }
 
 + (void)initialize {
@@ -92,12 +103,26 @@ static NSDictionary * TRBFilterMap = nil;
 					@(TRBLibraryFilterByActor): @"actor",
 					@(TRBLibraryFilterByDirector): @"director",
 					@(TRBLibraryFilterByWriter): @"writer"};
+	TRBFilterKeyMap = @{@"year": @"year",
+						@"genre": @"genres",
+						@"actor": @"actors",
+						@"director": @"directors",
+						@"writer": @"writers"};
 }
 
 - (void)viewWillAppear:(BOOL)animated {
 	[super viewWillAppear:animated];
 	NSString * category = TRBFilterMap[@(_selectedFilter)];
-	if (category) {
+	TRBLibraryStorage * storage = [TRBLibraryStorage sharedInstance];
+	if (category && [storage hasItemsOfType:TRBLibraryItemTypeMovie]) {
+		[storage fetchValuesOfType:TRBLibraryItemTypeMovie forKey:TRBFilterKeyMap[category] handler:^(NSArray * values) {
+			NSMutableArray * filterList = [NSMutableArray arrayWithCapacity:[values count]];
+			for (id value in values)
+				[filterList addObject:@{@"name": [value description]}];
+			_filterList = filterList;
+			[self.tableView reloadData];
+		}];
+	} else if (category) {
 		[[TRBLibraryManager sharedManager] fetchMetadataForType:@"movie" category:category completion:^(NSDictionary *json, NSError *error) {
 			if (!error) {
 				_filterList = [json[@"data"][@"metadatas"] filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(NSDictionary * filter, NSDictionary * bindings) {
@@ -124,10 +149,17 @@ static NSDictionary * TRBFilterMap = nil;
 	NSDictionary * filter = _filterList[indexPath.row];
 	NSString * category = TRBFilterMap[@(_selectedFilter)];
 	if (category) {
-		_filter = @{category: filter[@"id"]};
+		NSString * name = filter[@"name"];
+		NSString * key = TRBFilterKeyMap[category];
+		_filter = filter[@"id"] ? @{category: filter[@"id"]} : nil;
+		if ([key isEqualToString:@"year"])
+			_predicate = [NSPredicate predicateWithFormat:@"year == %@", @([name integerValue])];
+		else
+			_predicate = [NSPredicate predicateWithFormat:@"%K CONTAINS %@", key, [TRBLibraryItem listValueForName:name]];
 		_filterDescription = [NSString stringWithFormat:@"%@: %@", [category capitalizedString], filter[@"name"]];
 	} else {
 		_filter = nil;
+		_predicate = nil;
 		_filterDescription = nil;
 	}
 	return indexPath;
@@ -137,4 +169,8 @@ static NSDictionary * TRBFilterMap = nil;
 	return _filter;
 }
 
+- (NSPredicate *)predicate {
+	return _predicate;
+}
+
 @end
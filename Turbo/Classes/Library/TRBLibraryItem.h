@@ -0,0 +1,61 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+@import CoreData;
+
+typedef NS_ENUM(int16_t, TRBLibraryItemType) {
+	TRBLibraryItemTypeMovie = 0,
+	TRBLibraryItemTypeTVShow,
+
+	TRBLibraryItemTypeCount
+};
+
+@interface TRBLibraryItem : NSManagedObject
+
+@property (nonatomic, strong) NSNumber * type;
+@property (nonatomic, strong) NSString * vsID;
+@property (nonatomic, strong) NSString * title;
+@property (nonatomic, strong) NSString * sortTitle;
+@property (nonatomic, strong) NSString * tagline;
+@property (nonatomic, strong) NSString * summary;
+@property (nonatomic, strong) NSString * releaseDate;
+@property (nonatomic, strong) NSNumber * year;
+@property (nonatomic, strong) NSString * genres;
+@property (nonatomic, strong) NSString * actors;
+@property (nonatomic, strong) NSString * directors;
+@property (nonatomic, strong) NSString * writers;
+@property (nonatomic, strong) NSString * posterMTime;
+@property (nonatomic, strong) NSNumber * recentlyAdded;
+@property (nonatomic, strong) NSNumber * syncGeneration;
+
++ (NSEntityDescription *)entityDescription;
+// Name lists are stored newline delimited on both ends so a single name matches with CONTAINS.
++ (NSString *)listValueForName:(NSString *)name;
+
+- (void)setupWithVSJSON:(NSDictionary *)json;
+- (BOOL)isListedVSJSONEqual:(NSDictionary *)json;
+- (NSArray *)namesInList:(NSString *)list;
+- (NSString *)searchableText;
+
+@end
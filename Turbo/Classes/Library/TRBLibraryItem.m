@@ -0,0 +1,139 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBLibraryItem.h"
+
+static NSAttributeDescription * TRBAttribute(NSString * name, NSAttributeType type, BOOL indexed) {
+	NSAttributeDescription * attribute = [NSAttributeDescription new];
+	attribute.name = name;
+	attribute.attributeType = type;
+	attribute.optional = YES;
+	attribute.indexed = indexed;
+	return attribute;
+}
+
+static NSString * TRBListString(NSArray * items) {
+	NSMutableString * result = nil;
+	for (NSDictionary * item in items) {
+		NSString * name = [item isKindOfClass:[NSDictionary class]] ? item[@"name"] : nil;
+		if (![name isKindOfClass:[NSString class]] || ![name length])
+			continue;
+		if (!result)
+			result = [NSMutableString stringWithString:@"\n"];
+		[result appendString:name];
+		[result appendString:@"\n"];
+	}
+	return result;
+}
+
+@implementation TRBLibraryItem
+
+@dynamic type;
+@dynamic vsID;
+@dynamic title;
+@dynamic sortTitle;
+@dynamic tagline;
+@dynamic summary;
+@dynamic releaseDate;
+@dynamic year;
+@dynamic genres;
+@dynamic actors;
+@dynamic directors;
+@dynamic writers;
+@dynamic posterMTime;
+@dynamic recentlyAdded;
+@dynamic syncGeneration;
+
++ (NSEntityDescription *)entityDescription {
+	NSEntityDescription * entity = [NSEntityDescription new];
+	entity.name = NSStringFromClass(self);
+	entity.managedObjectClassName = NSStringFromClass(self);
+	entity.properties = @[TRBAttribute(@"type", NSInteger16AttributeType, YES),
+						  TRBAttribute(@"vsID", NSStringAttributeType, YES),
+						  TRBAttribute(@"title", NSStringAttributeType, NO),
+						  TRBAttribute(@"sortTitle", NSStringAttributeType, YES),
+						  TRBAttribute(@"tagline", NSStringAttributeType, NO),
+						  TRBAttribute(@"summary", NSStringAttributeType, NO),
+						  TRBAttribute(@"releaseDate", NSStringAttributeType, NO),
+						  TRBAttribute(@"year", NSInteger32AttributeType, YES),
+						  TRBAttribute(@"genres", NSStringAttributeType, NO),
+						  TRBAttribute(@"actors", NSStringAttributeType, NO),
+						  TRBAttribute(@"directors", NSStringAttributeType, NO),
+						  TRBAttribute(@"writers", NSStringAttributeType, NO),
+						  TRBAttribute(@"posterMTime", NSStringAttributeType, NO),
+						  TRBAttribute(@"recentlyAdded", NSBooleanAttributeType, YES),
+						  TRBAttribute(@"syncGeneration", NSDoubleAttributeType, NO)];
+	return entity;
+}
+
++ (NSString *)listValueForName:(NSString *)name {
+	return [NSString stringWithFormat:@"\n%@\n", name];
+}
+
+#pragma mark - Public Methods
+
+- (void)setupWithVSJSON:(NSDictionary *)json {
+	NSDictionary * additional = json[@"additional"];
+	[self setupListedFieldsWithVSJSON:json];
+	self.posterMTime = additional[@"poster_mtime"];
+	self.tagline = json[@"tagline"];
+	self.summary = additional[@"summary"];
+	self.genres = TRBListString(additional[@"genre"]);
+	self.actors = TRBListString(additional[@"actor"]);
+	self.directors = TRBListString(additional[@"director"]);
+	self.writers = TRBListString(additional[@"writer"]);
+}
+
+- (BOOL)isListedVSJSONEqual:(NSDictionary *)json {
+	NSString * posterMTime = json[@"additional"][@"poster_mtime"];
+	return (self.posterMTime == posterMTime || [self.posterMTime isEqual:posterMTime]) &&
+		[self.title isEqual:json[@"title"]] &&
+		(self.releaseDate == json[@"original_available"] || [self.releaseDate isEqual:json[@"original_available"]]);
+}
+
+- (NSArray *)namesInList:(NSString *)list {
+	NSArray * result = nil;
+	if ([list length] > 2)
+		result = [[list substringWithRange:NSMakeRange(1, [list length] - 2)] componentsSeparatedByString:@"\n"];
+	return result;
+}
+
+- (NSString *)searchableText {
+	return [@[self.title ?: @"", self.actors ?: @"", self.directors ?: @"", self.writers ?: @"", self.genres ?: @""] componentsJoinedByString:@"\n"];
+}
+
+#pragma mark - Private Methods
+
+- (void)setupListedFieldsWithVSJSON:(NSDictionary *)json {
+	NSString * title = json[@"title"];
+	NSString * sortTitle = json[@"sort_title"];
+	NSString * releaseDate = json[@"original_available"];
+	self.vsID = [json[@"id"] description];
+	self.title = title;
+	self.sortTitle = [([sortTitle length] ? sortTitle : title) lowercaseString];
+	self.releaseDate = releaseDate;
+	self.year = [releaseDate length] >= 4 ? @([[releaseDate substringToIndex:4] integerValue]) : nil;
+}
+
+@end
@@ -23,6 +23,7 @@
 
 #import "TRBLibraryListViewController.h"
 #import "TRBLibraryManager.h"
+#import "TRBLibraryStorage.h"
 #import "TRBMovie.h"
 #import "TRBLibraryMovieDetailsViewController.h"
 #import "TRBLibraryFilterViewController.h"
@@ -40,6 +41,8 @@ typedef NS_ENUM(NSUInteger, TRBLibraryAppendPosition) {
 
 @implementation TRBLibraryListViewController {
 	TRBLibraryManager * _libraryManager;
+	TRBLibraryStorage * _storage;
+	BOOL _mirrored;
 	NSMutableArray * _movies;
 	NSInteger * _offsetTop;
 	NSInteger * _offsetBottom;
@@ -63,6 +66,7 @@ typedef NS_ENUM(NSUInteger, TRBLibraryAppendPosition) {
 
 	TRBLibraryFilterName _currentFilter;
 	NSDictionary * _filters;
+	NSPredicate * _predicate;
 	NSString * _filterDescription;
 }
 
@@ -73,6 +77,8 @@ typedef NS_ENUM(NSUInteger, TRBLibraryAppendPosition) {
 		_libraryManager = [TRBLibraryManager sharedManager];
 		_libraryManager.host = [defaults objectForKey:TRBSynologyHostKey];
 		_libraryManager.port = [[defaults objectForKey:TRBSynologyPortKey] integerValue];
+		_storage = [TRBLibraryStorage sharedInstance];
+		_mirrored = [_storage hasItemsOfType:TRBLibraryItemTypeMovie];
 		_list = [NSMutableArray arrayWithCapacity:MOVIES_LIMIT];
 		_searched = [NSMutableArray arrayWithCapacity:MOVIES_LIMIT];
 		_movies = _list;
@@ -96,9 +102,22 @@ typedef NS_ENUM(NSUInteger, TRBLibraryAppendPosition) {
 	_searchBar.delegate = self;
 	_searchBar.placeholder = @"Search Movie Library";
 	self.navigationItem.titleView = _searchBar;
+	if (_mirrored)
+		[self fetchMoviesWithAppendPosition:TRBLibraryAppendPositionBottom];
 	void(^fetchMoviesBlock)(NSError * error) = ^(NSError * error) {
-		if (!error)
+		if (error)
+			return;
+		if (!_mirrored)
 			[self fetchMoviesWithAppendPosition:TRBLibraryAppendPositionBottom];
+		[_libraryManager syncLibraryType:TRBLibraryItemTypeMovie completion:^(NSError * error) {
+			if (!error && !_mirrored && [_storage hasItemsOfType:TRBLibraryItemTypeMovie]) {
+				_mirrored = YES;
+				if (_movies == _list && !_fetching) {
+					[self resetAndSwithToList];
+					[self fetchMoviesWithAppendPosition:TRBLibraryAppendPositionBottom];
+				}
+			}
+		}];
 	};
 	if (!_libraryManager.isAuthenticated)
 		[_libraryManager startAuthenticationCompletion:fetchMoviesBlock];
@@ -157,7 +176,7 @@ typedef NS_ENUM(NSUInteger, TRBLibraryAppendPosition) {
 	UIImage * poster = movie.posterImage;
 	cell.posterImageView.image = poster;
 	if (!poster) {
-		[[TRBLibraryManager sharedManager] fetchPosterForMovieID:movie.vsID completion:^(UIImage *image, NSError *error) {
+		[[TRBLibraryManager sharedManager] fetchPosterForMovieID:movie.vsID posterMTime:movie.vsPosterMTime completion:^(UIImage *image, NSError *error) {
 			movie.posterImage = image;
 			TRBMovieCollectionCell * cell = (TRBMovieCollectionCell *)[collectionView cellForItemAtIndexPath:indexPath];
 			cell.posterImageView.image = image;
@@ -211,9 +230,11 @@ typedef NS_ENUM(NSUInteger, TRBLibraryAppendPosition) {
 	TRBLibraryFilterViewController * filterViewController = segue.sourceViewController;
 	TRBLibraryFilterName selectedFilter = filterViewController.selectedFilter;
 	NSDictionary * filters = [filterViewController filter];
-	if (selectedFilter != _currentFilter || ![_filters isEqualToDictionary:filters]) {
+	NSPredicate * predicate = [filterViewController predicate];
+	if (selectedFilter != _currentFilter || ![_filters isEqualToDictionary:filters] || (predicate != _predicate && ![predicate isEqual:_predicate])) {
 		_currentFilter = selectedFilter;
 		_filters = filters;
+		_predicate = predicate;
 		_filterDescription = filterViewController.filterDescription;
 		[self resetAndSwithToList];
 		[self fetchMoviesWithAppendPosition:TRBLibraryAppendPositionBottom];
@@ -256,23 +277,60 @@ typedef NS_ENUM(NSUInteger, TRBLibraryAppendPosition) {
 	[self.collectionView reloadData];
 }
 
+- (void)loadMoviesWithOffset:(NSUInteger)offset keyword:(NSString *)keyword completion:(void(^)(NSArray * movies, NSUInteger total, NSError * error))completion {
+	if (_mirrored) {
+		NSPredicate * predicate = keyword ? [_storage predicateForKeyword:keyword] : _predicate;
+		[_storage fetchItemsOfType:TRBLibraryItemTypeMovie predicate:predicate sortBy:@"sortTitle" ascending:YES offset:offset limit:MOVIES_LIMIT handler:^(NSArray * items, NSUInteger total) {
+			NSMutableArray * movies = [NSMutableArray arrayWithCapacity:[items count]];
+			for (TRBLibraryItem * item in items)
+				[movies addObject:[[TRBMovie alloc] initWithLibraryItem:item]];
+			completion(movies, total, nil);
+		}];
+	} else {
+		void(^handler)(NSDictionary *, NSError *) = ^(NSDictionary * json, NSError * error) {
+			NSDictionary * data = json[@"data"];
+			NSArray * movieDicts = data[@"movies"];
+			NSMutableArray * movies = [NSMutableArray arrayWithCapacity:[movieDicts count]];
+			for (NSDictionary * movieDict in movieDicts)
+				[movies addObject:[[TRBMovie alloc] initWithVSJSON:movieDict]];
+			completion(movies, [data[@"total"] unsignedIntegerValue], error);
+		};
+		if (keyword)
+			[_libraryManager searchMovietWithKeyword:keyword offest:offset limit:MOVIES_LIMIT sortBy:@"title" order:@"asc" completion:handler];
+		else
+			[_libraryManager fetchMovieListWithOffest:offset limit:MOVIES_LIMIT sortBy:@"title" order:@"asc" filters:_filters completion:handler];
+	}
+}
+
+- (void)prefetchPostersForPage:(NSArray *)page appendPosition:(TRBLibraryAppendPosition)appendPosition keyword:(NSString *)keyword {
+	if (appendPosition != TRBLibraryAppendPositionBottom)
+		return;
+	void(^prefetch)(NSArray * movies) = ^(NSArray * movies) {
+		for (TRBMovie * movie in movies) {
+			if (!movie.posterImage)
+				[_libraryManager prefetchPosterForMovieID:movie.vsID posterMTime:movie.vsPosterMTime];
+		}
+	};
+	// The mirror makes reading the next page ahead cheap, remotely the page just loaded is still mostly off screen.
+	if (!_mirrored)
+		prefetch(page);
+	else if ((*_offsetBottom) < (*_total)) {
+		[self loadMoviesWithOffset:(*_offsetBottom) keyword:keyword completion:^(NSArray * movies, NSUInteger total, NSError * error) {
+			prefetch(movies);
+		}];
+	}
+}
+
 - (void)fetchMoviesWithAppendPosition:(TRBLibraryAppendPosition)appendPosition {
 	if (!_fetching) {
 		_fetching = YES;
 		NSUInteger offset = appendPosition == TRBLibraryAppendPositionBottom ? _listOffsetBottom : _listOffsetTop;
-		[_libraryManager fetchMovieListWithOffest:offset limit:MOVIES_LIMIT sortBy:@"title" order:@"asc" filters:_filters completion:^(NSDictionary * json, NSError * error) {
+		[self loadMoviesWithOffset:offset keyword:nil completion:^(NSArray * toAdd, NSUInteger total, NSError * error) {
 			if (!error) {
 				_movies = _list;
 				_offsetBottom = &_listOffsetBottom;
 				_offsetTop = &_listOffsetTop;
 				_total = &_listTotal;
-				NSDictionary * data = json[@"data"];
-				NSArray * movies = data[@"movies"];
-				NSMutableArray * toAdd = [NSMutableArray arrayWithCapacity:[movies count]];
-				for (NSDictionary * movieDict in movies) {
-					TRBMovie * movie = [[TRBMovie alloc] initWithVSJSON:movieDict];
-					[toAdd addObject:movie];
-				}
 				if (appendPosition == TRBLibraryAppendPositionBottom)
 					[_list addObjectsFromArray:toAdd];
 				else
@@ -281,7 +339,8 @@ typedef NS_ENUM(NSUInteger, TRBLibraryAppendPosition) {
 					_listOffsetBottom += [toAdd count];
 				else
 					_listOffsetTop -= [toAdd count];
-				_listTotal = [data[@"total"] unsignedIntegerValue];
+				_listTotal = total;
+				[self prefetchPostersForPage:toAdd appendPosition:appendPosition keyword:nil];
 				BOOL updateContentOffset = [_list count] > MOVIES_LIMIT * 2;
 				if (updateContentOffset) {
 					NSUInteger location = 0;
@@ -313,62 +372,51 @@ typedef NS_ENUM(NSUInteger, TRBLibraryAppendPosition) {
 	if (!_fetching) {
 		_fetching = YES;
 		NSUInteger offset = appendPosition == TRBLibraryAppendPositionBottom ? _searchOffsetBottom : _searchOffsetTop;
-		[_libraryManager searchMovietWithKeyword:_searchBar.text
-										  offest:offset
-										   limit:MOVIES_LIMIT
-										  sortBy:@"title"
-										   order:@"asc"
-									  completion:^(NSDictionary *json, NSError *error) {
-										  if (!error) {
-											  _movies = _searched;
-											  _offsetBottom = &_searchOffsetBottom;
-											  _offsetTop = &_searchOffsetTop;
-											  _total = &_searchTotal;
-											  _defaultRightBarButtonItems = self.navigationItem.rightBarButtonItems;
-											  self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemCancel
-																																	 target:self
-																																	 action:@selector(cancelButtonPressed:)];
-											  NSDictionary * data = json[@"data"];
-											  NSArray * movies = data[@"movies"];
-											  NSMutableArray * toAdd = [NSMutableArray arrayWithCapacity:[movies count]];
-											  for (NSDictionary * movieDict in movies) {
-												  TRBMovie * movie = [[TRBMovie alloc] initWithVSJSON:movieDict];
-												  [toAdd addObject:movie];
-											  }
-											  if (appendPosition == TRBLibraryAppendPositionBottom)
-												  [_searched addObjectsFromArray:toAdd];
-											  else
-												  [_searched insertObjects:toAdd atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [toAdd count])]];
-											  if (appendPosition == TRBLibraryAppendPositionBottom)
-												  _searchOffsetBottom += [toAdd count];
-											  else
-												  _searchOffsetTop -= [toAdd count];
-											  _searchTotal = [data[@"total"] unsignedIntegerValue];
-											  BOOL updateContentOffset = [_searched count] > MOVIES_LIMIT * 2;
-											  if (updateContentOffset) {
-												  NSUInteger location = 0;
-												  if (appendPosition == TRBLibraryAppendPositionBottom) {
-													  location = 0;
-													  _searchOffsetTop += MOVIES_LIMIT;
-												  } else {
-													  location = [_searched count] - MOVIES_LIMIT;
-													  _searchOffsetBottom -= MOVIES_LIMIT;
-												  }
-												  NSUInteger toRemoveCount = [_searched count] - (MOVIES_LIMIT * 2);
-												  [_searched removeObjectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(location, toRemoveCount)]];
-											  }
-											  [self.collectionView reloadData];
-											  self.navigationItem.prompt = nil;
-											  if (updateContentOffset) {
-												  UICollectionViewFlowLayout * layout = (UICollectionViewFlowLayout *)self.collectionView.collectionViewLayout;
-												  CGFloat itemHeight = layout.itemSize.height;
-												  CGPoint offset = self.collectionView.contentOffset;
-												  offset.y += ((itemHeight * MOVIES_LIMIT) * (appendPosition == TRBLibraryAppendPositionBottom ? -1.0 : 1.0));
-												  self.collectionView.contentOffset = offset;
-											  }
-										  }
-										  _fetching = NO;
-									  }];
+		[self loadMoviesWithOffset:offset keyword:_searchBar.text completion:^(NSArray * toAdd, NSUInteger total, NSError * error) {
+			if (!error) {
+				_movies = _searched;
+				_offsetBottom = &_searchOffsetBottom;
+				_offsetTop = &_searchOffsetTop;
+				_total = &_searchTotal;
+				_defaultRightBarButtonItems = self.navigationItem.rightBarButtonItems;
+				self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemCancel
+																										 target:self
+																										 action:@selector(cancelButtonPressed:)];
+				if (appendPosition == TRBLibraryAppendPositionBottom)
+					[_searched addObjectsFromArray:toAdd];
+				else
+					[_searched insertObjects:toAdd atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [toAdd count])]];
+				if (appendPosition == TRBLibraryAppendPositionBottom)
+					_searchOffsetBottom += [toAdd count];
+				else
+					_searchOffsetTop -= [toAdd count];
+				_searchTotal = total;
+				[self prefetchPostersForPage:toAdd appendPosition:appendPosition keyword:_searchBar.text];
+				BOOL updateContentOffset = [_searched count] > MOVIES_LIMIT * 2;
+				if (updateContentOffset) {
+					NSUInteger location = 0;
+					if (appendPosition == TRBLibraryAppendPositionBottom) {
+						location = 0;
+						_searchOffsetTop += MOVIES_LIMIT;
+					} else {
+						location = [_searched count] - MOVIES_LIMIT;
+						_searchOffsetBottom -= MOVIES_LIMIT;
+					}
+					NSUInteger toRemoveCount = [_searched count] - (MOVIES_LIMIT * 2);
+					[_searched removeObjectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(location, toRemoveCount)]];
+				}
+				[self.collectionView reloadData];
+				self.navigationItem.prompt = nil;
+				if (updateContentOffset) {
+					UICollectionViewFlowLayout * layout = (UICollectionViewFlowLayout *)self.collectionView.collectionViewLayout;
+					CGFloat itemHeight = layout.itemSize.height;
+					CGPoint offset = self.collectionView.contentOffset;
+					offset.y += ((itemHeight * MOVIES_LIMIT) * (appendPosition == TRBLibraryAppendPositionBottom ? -1.0 : 1.0));
+					self.collectionView.contentOffset = offset;
+				}
+			}
+			_fetching = NO;
+		}];
 	}
 }
 
@@ -21,6 +21,8 @@
  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#import "TRBLibraryItem.h"
+
 typedef NS_ENUM(NSUInteger, TRBLibraryFilterName) {
 	TRBLibraryFilterNoFilter = 0,
 	TRBLibraryFilterRecentlyAdded,
@@ -53,7 +55,7 @@ typedef NS_ENUM(NSUInteger, TRBLibraryFilterName) {
 						 sortBy:(NSString *)sort
 						  order:(NSString *)order
 					 completion:(void(^)(NSDictionary * json, NSError * error))completion;
-- (void)fetchMovieDetailsForID:(NSString *)movieID completion:(void(^)(NSDictionary * json, NSError * error))completion;
+- (NSURLSessionDataTask *)fetchMovieDetailsForID:(NSString *)movieID completion:(void(^)(NSDictionary * json, NSError * error))completion;
 // TVShows
 - (void)fetchTVShowListWithOffest:(NSUInteger)offset
 							limit:(NSUInteger)limit
@@ -61,11 +63,15 @@ typedef NS_ENUM(NSUInteger, TRBLibraryFilterName) {
 							order:(NSString *)order
 					   completion:(void(^)(NSDictionary * json, NSError * error))completion;
 - (void)fetchTVShowEpisodeListForID:(NSString *)tvShowID completion:(void(^)(NSDictionary * json, NSError * error))completion;
-// Posters
-- (void)fetchPosterForMovieID:(NSString *)movieID completion:(void(^)(UIImage * image, NSError * error))completion;
-- (void)fetchPosterForTVShowID:(NSString *)tvShowID completion:(void(^)(UIImage * image, NSError * error))completion;
-- (void)fetchPosterForTVShowEpisodeID:(NSString *)tvShowEpisodeID completion:(void(^)(UIImage * image, NSError * error))completion;
+// Posters, cached per poster_mtime so a changed poster is fetched again
+- (void)fetchPosterForMovieID:(NSString *)movieID posterMTime:(NSString *)posterMTime completion:(void(^)(UIImage * image, NSError * error))completion;
+- (void)fetchPosterForTVShowID:(NSString *)tvShowID posterMTime:(NSString *)posterMTime completion:(void(^)(UIImage * image, NSError * error))completion;
+- (void)fetchPosterForTVShowEpisodeID:(NSString *)tvShowEpisodeID posterMTime:(NSString *)posterMTime completion:(void(^)(UIImage * image, NSError * error))completion;
+- (void)prefetchPosterForMovieID:(NSString *)movieID posterMTime:(NSString *)posterMTime;
 // Metadata
 - (void)fetchMetadataForType:(NSString *)type category:(NSString *)category completion:(void(^)(NSDictionary * json, NSError * error))completion;
+// Offline Mirror
+- (void)syncLibraryType:(TRBLibraryItemType)type completion:(void(^)(NSError * error))completion;
+- (NSDate *)lastSyncDateForType:(TRBLibraryItemType)type;
 
 @end
@@ -25,9 +25,20 @@
 #import "TRBHTTPSession.h"
 #import "TRBDataCache.h"
 #import "KeychainItemWrapper.h"
+#import "TRBLibraryStorage.h"
+
+#define SYNC_PAGE_LIMIT 500
+#define SYNC_DETAILS_THRESHOLD 20
+#define POSTER_MAX_CONCURRENT_REQUESTS 3
+#define POSTER_MAX_PENDING_PREFETCHES 100
 
 static NSDictionary * VSPosterDomainMapper = nil;
 
+static NSString * const VSSyncAdditional = @"poster_mtime,tagline,genre,actor,director,writer,summary";
+static NSString * const VSItemAPIs[TRBLibraryItemTypeCount] = {@"SYNO.VideoStation.Movie", @"SYNO.VideoStation.TVShow"};
+static NSString * const VSItemCGIs[TRBLibraryItemTypeCount] = {@"movie.cgi", @"tvshow.cgi"};
+static NSString * const VSItemListKeys[TRBLibraryItemTypeCount] = {@"movies", @"tvshows"};
+
 @interface TRBLibraryManager ()<UIAlertViewDelegate>
 @property (nonatomic, readonly) NSString * baseURL;
 @end
@@ -38,6 +49,11 @@ static NSDictionary * VSPosterDomainMapper = nil;
 	void(^_authCompletion)(NSError * error);
 	TRBHTTPRequestBuilder * _requestBuilder;
 	TRBHTTPJSONResponseParser * _jsonParser;
+	NSCache * _posterImages;
+	NSMutableDictionary * _posterCompletions;
+	NSMutableArray * _pendingPosterKeys;
+	NSMutableDictionary * _pendingPosterRequests;
+	NSUInteger _activePosterRequests;
 }
 
 + (void)initialize {
@@ -64,6 +80,11 @@ static NSDictionary * VSPosterDomainMapper = nil;
 		_requestBuilder = [TRBHTTPRequestBuilder new];
 		_jsonParser = [TRBHTTPJSONResponseParser new];
 		[_jsonParser.acceptedMIMETypes addObject:@"text/plain"];
+		_posterImages = [NSCache new];
+		_posterImages.countLimit = 150;
+		_posterCompletions = [NSMutableDictionary dictionary];
+		_pendingPosterKeys = [NSMutableArray array];
+		_pendingPosterRequests = [NSMutableDictionary dictionary];
     }
     return self;
 }
@@ -169,14 +190,14 @@ static NSDictionary * VSPosterDomainMapper = nil;
 		}];
 }
 
-- (void)fetchMovieDetailsForID:(NSString *)movieID completion:(void (^)(NSDictionary *, NSError *))completion {
+- (NSURLSessionDataTask *)fetchMovieDetailsForID:(NSString *)movieID completion:(void (^)(NSDictionary *, NSError *))completion {
 	NSParameterAssert(completion);
 	NSDictionary * parameters = @{@"api": @"SYNO.VideoStation.Movie",
 								  @"version": @"1",
 								  @"method": @"getinfo",
 								  @"id": movieID,
 								  @"additional": @"summary,files,actor,writer,director,extra,collection"};
-	[_session POST:[NSString stringWithFormat:@"%@/webapi/VideoStation/movie.cgi", self.baseURL]
+	return [_session POST:[NSString stringWithFormat:@"%@/webapi/VideoStation/movie.cgi", self.baseURL]
 		parameters:parameters
 		   builder:_requestBuilder
 			parser:_jsonParser
@@ -238,16 +259,23 @@ static NSDictionary * VSPosterDomainMapper = nil;
 
 #pragma mark - Posters
 
-- (void)fetchPosterForMovieID:(NSString *)movieID completion:(void(^)(UIImage * image, NSError * error))completion {
-	[self fetchPosterForID:movieID type:@"movie" completion:completion];
+- (void)fetchPosterForMovieID:(NSString *)movieID posterMTime:(NSString *)posterMTime completion:(void(^)(UIImage * image, NSError * error))completion {
+	NSParameterAssert(completion);
+	[self fetchPosterForID:movieID type:@"movie" posterMTime:posterMTime prefetch:NO completion:completion];
 }
 
-- (void)fetchPosterForTVShowID:(NSString *)tvShowID completion:(void(^)(UIImage * image, NSError * error))completion {
-	[self fetchPosterForID:tvShowID type:@"tvshow" completion:completion];
+- (void)fetchPosterForTVShowID:(NSString *)tvShowID posterMTime:(NSString *)posterMTime completion:(void(^)(UIImage * image, NSError * error))completion {
+	NSParameterAssert(completion);
+	[self fetchPosterForID:tvShowID type:@"tvshow" posterMTime:posterMTime prefetch:NO completion:completion];
 }
 
-- (void)fetchPosterForTVShowEpisodeID:(NSString *)tvShowEpisodeID completion:(void(^)(UIImage * image, NSError * error))completion {
-	[self fetchPosterForID:tvShowEpisodeID type:@"tvshow_episode" completion:completion];
+- (void)fetchPosterForTVShowEpisodeID:(NSString *)tvShowEpisodeID posterMTime:(NSString *)posterMTime completion:(void(^)(UIImage * image, NSError * error))completion {
+	NSParameterAssert(completion);
+	[self fetchPosterForID:tvShowEpisodeID type:@"tvshow_episode" posterMTime:posterMTime prefetch:NO completion:completion];
+}
+
+- (void)prefetchPosterForMovieID:(NSString *)movieID posterMTime:(NSString *)posterMTime {
+	[self fetchPosterForID:movieID type:@"movie" posterMTime:posterMTime prefetch:YES completion:nil];
 }
 
 #pragma mark - Metadata
@@ -272,6 +300,39 @@ static NSDictionary * VSPosterDomainMapper = nil;
 		}];
 }
 
+#pragma mark - Offline Mirror
+
+- (void)syncLibraryType:(TRBLibraryItemType)type completion:(void(^)(NSError * error))completion {
+	NSTimeInterval generation = [NSDate timeIntervalSinceReferenceDate];
+	void(^finish)(NSError *) = ^(NSError * error) {
+		if (!error)
+			[[NSUserDefaults standardUserDefaults] setObject:[NSDate date] forKey:[self syncDateKeyForType:type]];
+		if (completion)
+			completion(error);
+	};
+	[self syncListingOfType:type offset:0 generation:generation staleIDs:[NSMutableArray array] completion:^(NSArray * staleIDs, NSError * error) {
+		if (error) {
+			finish(error);
+			return;
+		}
+		LogV(@"library sync: %lu new or changed items", (unsigned long)[staleIDs count]);
+		[self syncRecordsOfType:type withIDs:staleIDs generation:generation completion:^(NSError * error) {
+			if (error) {
+				finish(error);
+				return;
+			}
+			[[TRBLibraryStorage sharedInstance] removeItemsOfType:type olderThanGeneration:generation handler:^(NSUInteger count) {
+				LogV(@"library sync: removed %lu items", (unsigned long)count);
+				[self syncRecentlyAddedOfType:type completion:finish];
+			}];
+		}];
+	}];
+}
+
+- (NSDate *)lastSyncDateForType:(TRBLibraryItemType)type {
+	return [[NSUserDefaults standardUserDefaults] objectForKey:[self syncDateKeyForType:type]];
+}
+
 #pragma mark - UIAlertViewDelegate Implementation
 
 - (void)alertView:(UIAlertView *)alertView didDismissWithButtonIndex:(NSInteger)buttonIndex {
@@ -317,13 +378,173 @@ static NSDictionary * VSPosterDomainMapper = nil;
 	   }];
 }
 
-- (void)fetchPosterForID:(NSString *)pid type:(NSString *)type completion:(void(^)(UIImage * image, NSError * error))completion {
-	NSParameterAssert(completion);
-	[[TRBDataCache sharedInstance] lookupDataWithDomain:VSPosterDomainMapper[type] path:pid andHandler:^(NSData * data, NSError *error) {
-		if (data) {
-			UIImage * image = [UIImage imageWithData:data scale:[UIScreen mainScreen].scale];
+- (NSString *)syncDateKeyForType:(TRBLibraryItemType)type {
+	return [NSString stringWithFormat:@"TRBLibrarySyncDate%d", type];
+}
+
+- (void)listItemsOfType:(TRBLibraryItemType)type
+				 offset:(NSUInteger)offset
+				  limit:(NSUInteger)limit
+			 additional:(NSString *)additional
+		  recentlyAdded:(BOOL)recentlyAdded
+			 completion:(void(^)(NSArray * items, NSUInteger total, NSError * error))completion {
+	NSDictionary * parameters = @{@"offset": [@(offset) description],
+								  @"limit": [@(limit) description],
+								  @"sort_by": @"title",
+								  @"sort_direction": @"asc",
+								  @"additional": additional,
+								  @"library_id": @"0",
+								  @"method": @"list",
+								  @"recently_added": recentlyAdded ? @"-1" : @"0",
+								  @"api": VSItemAPIs[type],
+								  @"version": @"1"};
+	[_session POST:[NSString stringWithFormat:@"%@/webapi/VideoStation/%@", self.baseURL, VSItemCGIs[type]]
+		parameters:parameters
+		   builder:_requestBuilder
+			parser:_jsonParser
+		completion:^(NSDictionary * json, NSURLResponse * response, NSError * error) {
+			if (!error && ![json[@"success"] boolValue])
+				error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorUnknown userInfo:@{NSLocalizedDescriptionKey: @"Unknown Error"}];
+			NSDictionary * data = json[@"data"];
+			completion(data[VSItemListKeys[type]], [data[@"total"] unsignedIntegerValue], error);
+		}];
+}
+
+- (void)syncListingOfType:(TRBLibraryItemType)type
+				   offset:(NSUInteger)offset
+			   generation:(NSTimeInterval)generation
+				 staleIDs:(NSMutableArray *)staleIDs
+			   completion:(void(^)(NSArray * staleIDs, NSError * error))completion {
+	[self listItemsOfType:type offset:offset limit:SYNC_PAGE_LIMIT additional:@"poster_mtime" recentlyAdded:NO completion:^(NSArray * items, NSUInteger total, NSError * error) {
+		if (error) {
+			completion(nil, error);
+			return;
+		}
+		[[TRBLibraryStorage sharedInstance] updateItemsOfType:type withListing:items generation:generation handler:^(NSArray * pageStaleIDs) {
+			[staleIDs addObjectsFromArray:pageStaleIDs];
+			NSUInteger next = offset + [items count];
+			if ([items count] && next < total)
+				[self syncListingOfType:type offset:next generation:generation staleIDs:staleIDs completion:completion];
+			else
+				completion(staleIDs, nil);
+		}];
+	}];
+}
+
+- (void)syncRecordsOfType:(TRBLibraryItemType)type withIDs:(NSArray *)vsIDs generation:(NSTimeInterval)generation completion:(void(^)(NSError * error))completion {
+	if (![vsIDs count])
+		completion(nil);
+	else if ([vsIDs count] <= SYNC_DETAILS_THRESHOLD)
+		[self syncDetailsOfType:type withIDs:vsIDs generation:generation completion:completion];
+	else
+		[self syncPagesOfType:type offset:0 wanted:[NSSet setWithArray:vsIDs] generation:generation completion:completion];
+}
+
+- (void)syncDetailsOfType:(TRBLibraryItemType)type withIDs:(NSArray *)vsIDs generation:(NSTimeInterval)generation completion:(void(^)(NSError * error))completion {
+	dispatch_group_t group = dispatch_group_create();
+	NSMutableArray * records = [NSMutableArray arrayWithCapacity:[vsIDs count]];
+	__block NSError * firstError = nil;
+	for (NSString * vsID in vsIDs) {
+		dispatch_group_enter(group);
+		NSDictionary * parameters = @{@"api": VSItemAPIs[type],
+									  @"version": @"1",
+									  @"method": @"getinfo",
+									  @"id": vsID,
+									  @"additional": VSSyncAdditional};
+		[_session POST:[NSString stringWithFormat:@"%@/webapi/VideoStation/%@", self.baseURL, VSItemCGIs[type]]
+			parameters:parameters
+			   builder:_requestBuilder
+				parser:_jsonParser
+			completion:^(NSDictionary * json, NSURLResponse * response, NSError * error) {
+				if (!error && ![json[@"success"] boolValue])
+					error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorUnknown userInfo:@{NSLocalizedDescriptionKey: @"Unknown Error"}];
+				NSDictionary * record = [json[@"data"][VSItemListKeys[type]] firstObject];
+				if (record)
+					[records addObject:record];
+				else if (!firstError)
+					firstError = error;
+				dispatch_group_leave(group);
+			}];
+	}
+	dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+		if (firstError)
+			completion(firstError);
+		else
+			[[TRBLibraryStorage sharedInstance] updateItemsOfType:type withRecords:records generation:generation handler:^{
+				completion(nil);
+			}];
+	});
+}
+
+- (void)syncPagesOfType:(TRBLibraryItemType)type offset:(NSUInteger)offset wanted:(NSSet *)wanted generation:(NSTimeInterval)generation completion:(void(^)(NSError * error))completion {
+	[self listItemsOfType:type offset:offset limit:SYNC_PAGE_LIMIT additional:VSSyncAdditional recentlyAdded:NO completion:^(NSArray * items, NSUInteger total, NSError * error) {
+		if (error) {
+			completion(error);
+			return;
+		}
+		NSArray * records = [items filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(NSDictionary * item, NSDictionary * bindings) {
+			return [wanted containsObject:[item[@"id"] description]];
+		}]];
+		[[TRBLibraryStorage sharedInstance] updateItemsOfType:type withRecords:records generation:generation handler:^{
+			NSUInteger next = offset + [items count];
+			if ([items count] && next < total)
+				[self syncPagesOfType:type offset:next wanted:wanted generation:generation completion:completion];
+			else
+				completion(nil);
+		}];
+	}];
+}
+
+- (void)syncRecentlyAddedOfType:(TRBLibraryItemType)type completion:(void(^)(NSError * error))completion {
+	[self listItemsOfType:type offset:0 limit:SYNC_PAGE_LIMIT additional:@"" recentlyAdded:YES completion:^(NSArray * items, NSUInteger total, NSError * error) {
+		if (error) {
+			completion(error);
+			return;
+		}
+		NSMutableArray * vsIDs = [NSMutableArray arrayWithCapacity:[items count]];
+		for (NSDictionary * item in items)
+			[vsIDs addObject:[item[@"id"] description]];
+		[[TRBLibraryStorage sharedInstance] markRecentlyAddedItemsOfType:type withIDs:vsIDs handler:^{
+			completion(nil);
+		}];
+	}];
+}
+
+- (void)fetchPosterForID:(NSString *)pid type:(NSString *)type posterMTime:(NSString *)posterMTime prefetch:(BOOL)prefetch completion:(void(^)(UIImage * image, NSError * error))completion {
+	pid = [pid description];
+	NSString * version = [[[posterMTime description] componentsSeparatedByCharactersInSet:[[NSCharacterSet alphanumericCharacterSet] invertedSet]] componentsJoinedByString:@""];
+	if (![version length])
+		version = @"poster";
+	NSString * domain = VSPosterDomainMapper[type];
+	NSString * path = [pid stringByAppendingPathComponent:version];
+	NSString * key = [domain stringByAppendingPathComponent:path];
+	UIImage * image = [_posterImages objectForKey:key];
+	if (image) {
+		if (completion)
 			completion(image, nil);
-		} else {
+		return;
+	}
+	NSMutableArray * completions = _posterCompletions[key];
+	if (completions) {
+		if (completion)
+			[completions addObject:[completion copy]];
+		if (!prefetch && [_pendingPosterKeys containsObject:key]) {
+			[_pendingPosterKeys removeObject:key];
+			[_pendingPosterKeys insertObject:key atIndex:0];
+		}
+		return;
+	}
+	completions = [NSMutableArray array];
+	if (completion)
+		[completions addObject:[completion copy]];
+	_posterCompletions[key] = completions;
+	[[TRBDataCache sharedInstance] lookupDataWithDomain:domain path:path andHandler:^(NSData * data, NSError * error) {
+		UIImage * image = data ? [UIImage imageWithData:data scale:[UIScreen mainScreen].scale] : nil;
+		if (image) {
+			[self finishPosterForKey:key image:image error:nil];
+			return;
+		}
+		[self enqueuePosterRequestForKey:key urgent:!prefetch request:^{
 			NSDictionary * parameters = @{@"api": @"SYNO.VideoStation.Poster",
 										  @"version": @"1",
 										  @"method": @"getimage",
@@ -337,15 +558,56 @@ static NSDictionary * VSPosterDomainMapper = nil;
 				   UIImage * image = nil;
 				   if (!error) {
 					   image = [UIImage imageWithData:data scale:[UIScreen mainScreen].scale];
-					   if (image)
-						   [[TRBDataCache sharedInstance] storeData:data withDomain:@"VS" andPath:pid];
-					   else
+					   if (image) {
+						   // Drops the versions cached for previous poster_mtime values.
+						   [[TRBDataCache sharedInstance] removeDataWithDomain:domain path:pid];
+						   [[TRBDataCache sharedInstance] storeData:data withDomain:domain andPath:path];
+					   } else
 						   error = [NSError errorWithDomain:@"TRBLibraryManager" code:-1 userInfo:@{NSLocalizedDescriptionKey: @"Failed to create UIImage object"}];
 				   }
-				   completion(image, error);
+				   _activePosterRequests--;
+				   [self finishPosterForKey:key image:image error:error];
+				   [self startPendingPosterRequests];
 			   }];
-		}
+		}];
 	}];
 }
 
+- (void)finishPosterForKey:(NSString *)key image:(UIImage *)image error:(NSError *)error {
+	if (image)
+		[_posterImages setObject:image forKey:key];
+	NSArray * completions = _posterCompletions[key];
+	[_posterCompletions removeObjectForKey:key];
+	for (void(^completion)(UIImage *, NSError *) in completions)
+		completion(image, error);
+}
+
+- (void)enqueuePosterRequestForKey:(NSString *)key urgent:(BOOL)urgent request:(dispatch_block_t)request {
+	_pendingPosterRequests[key] = [request copy];
+	if (urgent)
+		[_pendingPosterKeys insertObject:key atIndex:0];
+	else
+		[_pendingPosterKeys addObject:key];
+	while ([_pendingPosterKeys count] > POSTER_MAX_PENDING_PREFETCHES) {
+		NSString * last = [_pendingPosterKeys lastObject];
+		if ([_posterCompletions[last] count])
+			break;
+		[_pendingPosterKeys removeLastObject];
+		[_pendingPosterRequests removeObjectForKey:last];
+		[_posterCompletions removeObjectForKey:last];
+	}
+	[self startPendingPosterRequests];
+}
+
+- (void)startPendingPosterRequests {
+	while (_activePosterRequests < POSTER_MAX_CONCURRENT_REQUESTS && [_pendingPosterKeys count]) {
+		NSString * key = _pendingPosterKeys[0];
+		[_pendingPosterKeys removeObjectAtIndex:0];
+		dispatch_block_t request = _pendingPosterRequests[key];
+		[_pendingPosterRequests removeObjectForKey:key];
+		_activePosterRequests++;
+		request();
+	}
+}
+
 @end
@@ -22,9 +22,8 @@
  */
 
 #import "TRBLibraryMovieDetailsViewController.h"
-#import "TRBLibraryManager.h"
 #import "TRBMovie.h"
-#import "TRBTMDbClient.h"
+#import "TRBMovieLoader.h"
 #import "NSString+TRBUnits.h"
 
 @interface TRBLibraryMovieDetailsViewController ()<UIGestureRecognizerDelegate>
@@ -33,6 +32,7 @@
 
 @implementation TRBLibraryMovieDetailsViewController {
 	TRBMovie * _movie;
+	TRBMovieLoader * _loader;
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
@@ -64,14 +64,14 @@
 #pragma mark - Public Methods
 
 - (void)showMovie:(TRBMovie *)movie {
+	[_loader cancel];
 	_movie = movie;
-	[[TRBLibraryManager sharedManager] fetchMovieDetailsForID:_movie.vsID completion:^(NSDictionary * json, NSError * error) {
-		if (!error) {
-			[_movie updateWithVSInfo:[json[@"data"][@"movies"] firstObject]];
+	_loader = [[TRBMovieLoader alloc] initWithMovie:movie];
+	[_loader loadSections:TRBMovieSectionBackdrop sectionHandler:^(TRBMovieSection section, id result, NSError * error) {
+		if (result && (section == TRBMovieSectionVSInfo || section == TRBMovieSectionBackdrop))
 			[self.collectionView reloadData];
-			if (_movie.tmdbID)
-				[self fetchAdditionalInfo];
-		}
+	} completion:^(TRBMovie * loadedMovie) {
+		[self.collectionView reloadData];
 	}];
 }
 
@@ -191,29 +191,6 @@
 //	[collectionView deselectItemAtIndexPath:indexPath animated:YES];
 //}
 
-#pragma mark - Private Methods
-
-- (void)fetchAdditionalInfo {
-	[[TRBTMDbClient sharedInstance] fetchMovieInfoWithID:_movie.tmdbID completion:^(NSDictionary *json, NSError *error) {
-		if (!error) {
-			[_movie updateWithTMDbInfo:json];
-			[self.collectionView reloadData];
-			if (!_movie.backdropImage && _movie.backdropPath)
-				[self fetchBackdropImage];
-		}
-	}];
-}
-
-- (void)fetchBackdropImage {
-	TRBTMDbBackdropSize size = [UIScreen mainScreen].scale > 1.0 ? TRBTMDbBackdropSizeW780 : TRBTMDbBackdropSizeW300;
-	[[TRBTMDbClient sharedInstance] fetchBackdrop:_movie.backdropPath withSize:size completion:^(UIImage * image, NSError * error) {
-		if (!error) {
-			_movie.backdropImage = image;
-			[self.collectionView reloadData];
-		}
-	}];
-}
-
 @end
 
 @implementation TRBLibraryMovieDetailsCell
@@ -0,0 +1,53 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBLibraryItem.h"
+
+@interface TRBLibraryStorage : NSObject
+
++ (instancetype)sharedInstance;
+
+#pragma mark - Queries
+
+// Answered from the in-memory search index once it has been built, by a CONTAINS scan before.
+- (NSPredicate *)predicateForKeyword:(NSString *)keyword;
+- (BOOL)hasItemsOfType:(TRBLibraryItemType)type;
+- (void)fetchItemsOfType:(TRBLibraryItemType)type
+			   predicate:(NSPredicate *)predicate
+				  sortBy:(NSString *)sortKey
+			   ascending:(BOOL)ascending
+				  offset:(NSUInteger)offset
+				   limit:(NSUInteger)limit
+				 handler:(void(^)(NSArray * items, NSUInteger total))handler;
+- (void)fetchValuesOfType:(TRBLibraryItemType)type forKey:(NSString *)key handler:(void(^)(NSArray * values))handler;
+
+#pragma mark - Sync
+
+// Touches unchanged items and returns the ids of the listed items that are new or changed.
+- (void)updateItemsOfType:(TRBLibraryItemType)type withListing:(NSArray *)listing generation:(NSTimeInterval)generation handler:(void(^)(NSArray * staleIDs))handler;
+- (void)updateItemsOfType:(TRBLibraryItemType)type withRecords:(NSArray *)records generation:(NSTimeInterval)generation handler:(void(^)())handler;
+- (void)removeItemsOfType:(TRBLibraryItemType)type olderThanGeneration:(NSTimeInterval)generation handler:(void(^)(NSUInteger count))handler;
+- (void)markRecentlyAddedItemsOfType:(TRBLibraryItemType)type withIDs:(NSArray *)vsIDs handler:(void(^)())handler;
+
+@end
@@ -0,0 +1,362 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBLibraryStorage.h"
+#import "TRBSearchIndex.h"
+
+#define FileManager [NSFileManager defaultManager]
+
+static NSString * const SQLiteStorageName = @"TRBLibrary.sqlite";
+
+@interface TRBLibraryStorage ()
+@property (atomic, readonly) NSManagedObjectModel * managedObjectModel;
+@property (atomic, readonly) NSManagedObjectContext * managedObjectContext;
+@property (atomic, readonly) NSManagedObjectContext * managedObjectContextMain;
+@property (atomic, readonly) NSPersistentStoreCoordinator * persistentStoreCoordinator;
+@property (atomic, assign, getter = isIndexed) BOOL indexed;
+@end
+
+@implementation TRBLibraryStorage {
+	id _observer;
+	id _observerMain;
+	id _indexObserver;
+	TRBSearchIndex * _index;
+}
+
++ (instancetype)sharedInstance {
+	static id sharedInstance = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		sharedInstance = [[self alloc] init];
+	});
+	return sharedInstance;
+}
+
+- (instancetype)init {
+	self = [super init];
+	if (self) {
+		// Built in code, a bundled model would be merged into the TV shows store.
+		_managedObjectModel = [NSManagedObjectModel new];
+		_managedObjectModel.entities = @[[TRBLibraryItem entityDescription]];
+		[self createPersistentStoreCoordinator];
+		_managedObjectContextMain = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSConfinementConcurrencyType];
+		[_managedObjectContextMain setPersistentStoreCoordinator:self.persistentStoreCoordinator];
+		[_managedObjectContextMain setMergePolicy:NSMergeByPropertyObjectTrumpMergePolicy];
+		_managedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+		[_managedObjectContext setPersistentStoreCoordinator:self.persistentStoreCoordinator];
+		[_managedObjectContext setMergePolicy:NSMergeByPropertyObjectTrumpMergePolicy];
+		[_managedObjectContext setUndoManager:nil];
+		_observer = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+																	  object:_managedObjectContext
+																	   queue:[NSOperationQueue mainQueue]
+																  usingBlock:^(NSNotification *note) {
+																	  [_managedObjectContextMain mergeChangesFromContextDidSaveNotification:note];
+																  }];
+		_observerMain = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+																		  object:_managedObjectContextMain
+																		   queue:[NSOperationQueue mainQueue]
+																	  usingBlock:^(NSNotification *note) {
+																		  [_managedObjectContext mergeChangesFromContextDidSaveNotification:note];
+																	  }];
+		_index = [TRBSearchIndex new];
+		__weak TRBLibraryStorage * weakSelf = self;
+		_indexObserver = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+																		   object:nil
+																			queue:nil
+																	   usingBlock:^(NSNotification *note) {
+																		   [weakSelf updateIndexWithSaveNotification:note];
+																	   }];
+		[self buildIndex];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[[NSNotificationCenter defaultCenter] removeObserver:_observer];
+	[[NSNotificationCenter defaultCenter] removeObserver:_observerMain];
+	[[NSNotificationCenter defaultCenter] removeObserver:_indexObserver];
+}
+
+#pragma mark - Public Methods
+
+#pragma mark Queries
+
+- (NSPredicate *)predicateForKeyword:(NSString *)keyword {
+	if (self.isIndexed) {
+		NSSet * matches = [_index documentsMatchingQuery:keyword];
+		// A query without any token (only punctuation or diacritics) matches nothing, not everything.
+		return matches ? [NSPredicate predicateWithFormat:@"SELF IN %@", matches] : [NSPredicate predicateWithValue:NO];
+	}
+	return [NSPredicate predicateWithFormat:@"title CONTAINS[cd] %@ OR actors CONTAINS[cd] %@ OR directors CONTAINS[cd] %@ OR writers CONTAINS[cd] %@ OR genres CONTAINS[cd] %@",
+			keyword, keyword, keyword, keyword, keyword];
+}
+
+- (BOOL)hasItemsOfType:(TRBLibraryItemType)type {
+	NSFetchRequest * request = [self fetchRequestForType:type predicate:nil];
+	[request setFetchLimit:1];
+	return [self.managedObjectContextMain countForFetchRequest:request error:NULL] > 0;
+}
+
+- (void)fetchItemsOfType:(TRBLibraryItemType)type
+			   predicate:(NSPredicate *)predicate
+				  sortBy:(NSString *)sortKey
+			   ascending:(BOOL)ascending
+				  offset:(NSUInteger)offset
+				   limit:(NSUInteger)limit
+				 handler:(void(^)(NSArray * items, NSUInteger total))handler {
+	NSParameterAssert(handler);
+	NSFetchRequest * request = [self fetchRequestForType:type predicate:predicate];
+	[request setSortDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:sortKey ascending:ascending],
+								  [NSSortDescriptor sortDescriptorWithKey:@"vsID" ascending:YES]]];
+	[request setFetchOffset:offset];
+	[request setFetchLimit:limit];
+	[request setResultType:NSManagedObjectIDResultType];
+	[self.managedObjectContext performBlock:^{
+		NSError * error = nil;
+		NSArray * array = [self.managedObjectContext executeFetchRequest:request error:&error];
+		LogCE(error != nil, [error localizedDescription]);
+		NSUInteger total = [self.managedObjectContext countForFetchRequest:[self fetchRequestForType:type predicate:predicate] error:NULL];
+		if (total == NSNotFound)
+			total = 0;
+		dispatch_async(dispatch_get_main_queue(), ^{
+			NSMutableArray * results = [NSMutableArray arrayWithCapacity:[array count]];
+			for (NSManagedObjectID * moID in array)
+				[results addObject:[self.managedObjectContextMain objectWithID:moID]];
+			handler(results, total);
+		});
+	}];
+}
+
+- (void)fetchValuesOfType:(TRBLibraryItemType)type forKey:(NSString *)key handler:(void(^)(NSArray * values))handler {
+	NSParameterAssert(handler);
+	NSFetchRequest * request = [self fetchRequestForType:type predicate:[NSPredicate predicateWithFormat:@"%K != nil", key]];
+	[request setResultType:NSDictionaryResultType];
+	[request setPropertiesToFetch:@[key]];
+	[request setReturnsDistinctResults:YES];
+	[self.managedObjectContext performBlock:^{
+		NSError * error = nil;
+		NSArray * array = [self.managedObjectContext executeFetchRequest:request error:&error];
+		LogCE(error != nil, [error localizedDescription]);
+		NSMutableSet * values = [NSMutableSet setWithCapacity:[array count]];
+		for (NSDictionary * row in array) {
+			id value = row[key];
+			if ([value isKindOfClass:[NSString class]]) {
+				for (NSString * name in [value componentsSeparatedByString:@"\n"]) {
+					if ([name length])
+						[values addObject:name];
+				}
+			} else
+				[values addObject:value];
+		}
+		NSArray * results = [[values allObjects] sortedArrayUsingSelector:@selector(compare:)];
+		if ([key isEqualToString:@"year"])
+			results = [[results reverseObjectEnumerator] allObjects];
+		dispatch_async(dispatch_get_main_queue(), ^{
+			handler(results);
+		});
+	}];
+}
+
+#pragma mark Sync
+
+- (void)updateItemsOfType:(TRBLibraryItemType)type withListing:(NSArray *)listing generation:(NSTimeInterval)generation handler:(void(^)(NSArray * staleIDs))handler {
+	[self.managedObjectContext performBlock:^{
+		NSDictionary * items = [self itemsOfType:type forRecords:listing];
+		NSMutableArray * staleIDs = [NSMutableArray arrayWithCapacity:[listing count]];
+		for (NSDictionary * json in listing) {
+			NSString * vsID = [json[@"id"] description];
+			TRBLibraryItem * item = items[vsID];
+			if (item && [item isListedVSJSONEqual:json])
+				item.syncGeneration = @(generation);
+			else if (vsID)
+				[staleIDs addObject:vsID];
+		}
+		[self saveBackgroundContext];
+		if (handler) {
+			dispatch_async(dispatch_get_main_queue(), ^{
+				handler(staleIDs);
+			});
+		}
+	}];
+}
+
+- (void)updateItemsOfType:(TRBLibraryItemType)type withRecords:(NSArray *)records generation:(NSTimeInterval)generation handler:(void(^)())handler {
+	[self.managedObjectContext performBlock:^{
+		NSDictionary * items = [self itemsOfType:type forRecords:records];
+		for (NSDictionary * json in records) {
+			TRBLibraryItem * item = items[[json[@"id"] description]];
+			if (!item) {
+				item = [NSEntityDescription insertNewObjectForEntityForName:NSStringFromClass([TRBLibraryItem class])
+													 inManagedObjectContext:self.managedObjectContext];
+				item.type = @(type);
+			}
+			[item setupWithVSJSON:json];
+			item.syncGeneration = @(generation);
+		}
+		[self saveBackgroundContext];
+		if (handler)
+			dispatch_async(dispatch_get_main_queue(), handler);
+	}];
+}
+
+- (void)removeItemsOfType:(TRBLibraryItemType)type olderThanGeneration:(NSTimeInterval)generation handler:(void(^)(NSUInteger count))handler {
+	NSFetchRequest * request = [self fetchRequestForType:type predicate:[NSPredicate predicateWithFormat:@"syncGeneration < %f", generation]];
+	[request setIncludesPropertyValues:NO];
+	[self.managedObjectContext performBlock:^{
+		NSError * error = nil;
+		NSArray * array = [self.managedObjectContext executeFetchRequest:request error:&error];
+		LogCE(error != nil, [error localizedDescription]);
+		for (TRBLibraryItem * item in array)
+			[self.managedObjectContext deleteObject:item];
+		[self saveBackgroundContext];
+		if (handler) {
+			NSUInteger count = [array count];
+			dispatch_async(dispatch_get_main_queue(), ^{
+				handler(count);
+			});
+		}
+	}];
+}
+
+- (void)markRecentlyAddedItemsOfType:(TRBLibraryItemType)type withIDs:(NSArray *)vsIDs handler:(void(^)())handler {
+	NSSet * added = [NSSet setWithArray:vsIDs];
+	NSFetchRequest * request = [self fetchRequestForType:type predicate:[NSPredicate predicateWithFormat:@"recentlyAdded == YES OR vsID IN %@", added]];
+	[self.managedObjectContext performBlock:^{
+		NSError * error = nil;
+		NSArray * array = [self.managedObjectContext executeFetchRequest:request error:&error];
+		LogCE(error != nil, [error localizedDescription]);
+		for (TRBLibraryItem * item in array) {
+			BOOL recentlyAdded = [added containsObject:item.vsID];
+			if ([item.recentlyAdded boolValue] != recentlyAdded)
+				item.recentlyAdded = @(recentlyAdded);
+		}
+		[self saveBackgroundContext];
+		if (handler)
+			dispatch_async(dispatch_get_main_queue(), handler);
+	}];
+}
+
+#pragma mark - Private Methods
+
+- (void)buildIndex {
+	NSFetchRequest * request = [NSFetchRequest fetchRequestWithEntityName:NSStringFromClass([TRBLibraryItem class])];
+	[request setFetchBatchSize:500];
+	[self.managedObjectContext performBlock:^{
+		NSError * error = nil;
+		NSArray * array = [self.managedObjectContext executeFetchRequest:request error:&error];
+		LogCE(error != nil, [error localizedDescription]);
+		for (TRBLibraryItem * item in array) {
+			[_index setText:[item searchableText] forDocument:item.objectID];
+			[self.managedObjectContext refreshObject:item mergeChanges:NO];
+		}
+		self.indexed = YES;
+		LogV(@"library index built with %lu items", (unsigned long)_index.documentCount);
+	}];
+}
+
+- (void)updateIndexWithSaveNotification:(NSNotification *)note {
+	if (note.object != _managedObjectContext && note.object != _managedObjectContextMain)
+		return;
+	NSDictionary * userInfo = note.userInfo;
+	for (NSString * key in @[NSInsertedObjectsKey, NSUpdatedObjectsKey]) {
+		for (NSManagedObject * object in userInfo[key]) {
+			if ([object isKindOfClass:[TRBLibraryItem class]])
+				[_index setText:[(TRBLibraryItem *)object searchableText] forDocument:object.objectID];
+		}
+	}
+	for (NSManagedObject * object in userInfo[NSDeletedObjectsKey])
+		[_index removeDocument:object.objectID];
+}
+
+- (NSFetchRequest *)fetchRequestForType:(TRBLibraryItemType)type predicate:(NSPredicate *)predicate {
+	NSFetchRequest * request = [NSFetchRequest fetchRequestWithEntityName:NSStringFromClass([TRBLibraryItem class])];
+	NSPredicate * typePredicate = [NSPredicate predicateWithFormat:@"type == %d", type];
+	[request setPredicate:predicate ? [NSCompoundPredicate andPredicateWithSubpredicates:@[typePredicate, predicate]] : typePredicate];
+	return request;
+}
+
+- (NSDictionary *)itemsOfType:(TRBLibraryItemType)type forRecords:(NSArray *)records {
+	NSMutableArray * vsIDs = [NSMutableArray arrayWithCapacity:[records count]];
+	for (NSDictionary * json in records) {
+		id vsID = json[@"id"];
+		if (vsID)
+			[vsIDs addObject:[vsID description]];
+	}
+	NSFetchRequest * request = [self fetchRequestForType:type predicate:[NSPredicate predicateWithFormat:@"vsID IN %@", vsIDs]];
+	NSError * error = nil;
+	NSArray * array = [self.managedObjectContext executeFetchRequest:request error:&error];
+	LogCE(error != nil, [error localizedDescription]);
+	NSMutableDictionary * result = [NSMutableDictionary dictionaryWithCapacity:[array count]];
+	for (TRBLibraryItem * item in array)
+		result[item.vsID] = item;
+	return result;
+}
+
+- (void)saveBackgroundContext {
+	if ([self.managedObjectContext hasChanges]) {
+		NSError * error = nil;
+		[self.managedObjectContext save:&error];
+		LogCE(error != nil, [error localizedDescription]);
+	}
+}
+
+- (void)createPersistentStoreCoordinator {
+	NSString * cachesDirectory;
+	NSArray * paths = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
+	if ([paths count])
+		cachesDirectory = paths[0];
+	NSString * storePath = [cachesDirectory stringByAppendingPathComponent:SQLiteStorageName];
+	NSURL * storeUrl = [NSURL fileURLWithPath:storePath];
+	if ([FileManager fileExistsAtPath:storePath] && ![self isStoreAtURLCompatibleWithModel:storeUrl])
+		[FileManager removeItemAtPath:storePath error:NULL];
+	NSError * error = nil;
+	_persistentStoreCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:self.managedObjectModel];
+	NSPersistentStore * store = [_persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType
+																		  configuration:nil
+																					URL:storeUrl
+																				options:nil
+																				  error:&error];
+	LogCE(!store, [error localizedDescription]);
+	if (error) {
+		[FileManager removeItemAtPath:storePath error:&error];
+		store = [_persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType
+														  configuration:nil
+																	URL:storeUrl
+																options:nil
+																  error:&error];
+		LogCE(!store, [error localizedDescription]);
+	}
+}
+
+- (BOOL)isStoreAtURLCompatibleWithModel:(NSURL *)url {
+	BOOL result = NO;
+	NSDictionary * storeMetadata = [NSPersistentStoreCoordinator metadataForPersistentStoreOfType:NSSQLiteStoreType
+																							  URL:url
+																							error:NULL];
+	if (storeMetadata)
+		result = [self.managedObjectModel isConfiguration:nil compatibleWithStoreMetadata:storeMetadata];
+	return result;
+}
+
+@end
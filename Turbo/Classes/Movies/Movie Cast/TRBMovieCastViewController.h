@@ -21,7 +21,7 @@
  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
-@class TRBMovie;
+@class TRBMovieLoader;
 
 typedef NS_ENUM(NSUInteger, TRBCastSource) {
 	TRBCastSourceRT = 0,
@@ -30,6 +30,6 @@ typedef NS_ENUM(NSUInteger, TRBCastSource) {
 
 @interface TRBMovieCastViewController : UITableViewController
 
-- (void)showCastForMovie:(TRBMovie *)movie andSource:(TRBCastSource)source;
+- (void)showCastWithLoader:(TRBMovieLoader *)loader;
 
 @end
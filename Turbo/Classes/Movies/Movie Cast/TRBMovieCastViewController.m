@@ -22,9 +22,8 @@
  */
 
 #import "TRBMovieCastViewController.h"
-#import "TRBRottenTomatoesClient.h"
 #import "TRBTMDbClient.h"
-#import "TRBMovie.h"
+#import "TRBMovieLoader.h"
 #import "TKAlertCenter.h"
 
 typedef NS_ENUM(NSUInteger, TMDbCastSection) {
@@ -62,18 +61,17 @@ static NSString * const TRBCastSectionTitles[TRBCastSectionCount] = {@"Cast", @"
 
 #pragma mark - Public Methods
 
-- (void)showCastForMovie:(TRBMovie *)movie andSource:(TRBCastSource)source {
-	_source = source;
-	switch (_source) {
-		case TRBCastSourceRT:
-			[self fetcthRTCastForMovie:movie];
-			break;
-		case TRBCastSourceTMDb:
-			[self fetchTMDbCastForMovie:movie];
-			break;
-		default:
-			break;
-	}
+- (void)showCastWithLoader:(TRBMovieLoader *)loader {
+	// Rotten Tomatoes only has the cast of movies without a TMDb match.
+	[loader fetchSection:TRBMovieSectionTMDbCast handler:^(NSDictionary * json, NSError * error) {
+		if (json) {
+			_source = TRBCastSourceTMDb;
+			_tmdbCasts[TRBCastSectionCast] = json[@"cast"];
+			_tmdbCasts[TRBCastSectionCrew] = json[@"crew"];
+			[self.tableView reloadData];
+		} else
+			[self fetchRTCastWithLoader:loader];
+	}];
 }
 
 #pragma mark - Table view data source
@@ -150,10 +148,10 @@ static NSString * const TRBCastSectionTitles[TRBCastSectionCount] = {@"Cast", @"
 
 #pragma mark - Private Methods
 
-- (void)fetcthRTCastForMovie:(TRBMovie *)movie {
-    [[TRBRottenTomatoesClient sharedInstance] fetchCastsInfoForID:movie.rtID withHandler:^(NSDictionary *json, NSError *error) {
-		LogCE(error != nil, [error localizedDescription]);
+- (void)fetchRTCastWithLoader:(TRBMovieLoader *)loader {
+	[loader fetchSection:TRBMovieSectionRTCast handler:^(NSDictionary * json, NSError * error) {
 		if (json) {
+			_source = TRBCastSourceRT;
 			_rtCasts = json[@"cast"];
 			[self.tableView reloadData];
 		} else if (error)
@@ -161,17 +159,6 @@ static NSString * const TRBCastSectionTitles[TRBCastSectionCount] = {@"Cast", @"
 	}];
 }
 
-- (void)fetchTMDbCastForMovie:(TRBMovie *)movie {
-	[[TRBTMDbClient sharedInstance] fetchMovieCastsWithID:movie.tmdbID completion:^(NSDictionary * json, NSError * error) {
-		if (json) {
-			_tmdbCasts[TRBCastSectionCast] = json[@"cast"];
-			_tmdbCasts[TRBCastSectionCrew] = json[@"crew"];
-			[self.tableView reloadData];
-		} else if (error)
-		[[TKAlertCenter defaultCenter] postAlertWithMessage:[error localizedDescription]];
-	}];
-}
-
 - (void)setupCell:(UITableViewCell *)cell forRTCastAtIndex:(NSIndexPath *)indexPath {
 	NSDictionary * cast = _rtCasts[indexPath.row];
 
@@ -22,8 +22,7 @@
  */
 
 #import "TRBMovieInfoViewController.h"
-#import "TRBRottenTomatoesClient.h"
-#import "TRBTMDbClient.h"
+#import "TRBMovieLoader.h"
 #import "TRBMovieCastViewController.h"
 #import "TRBMovieTrailersViewController.h"
 #import "TRBMovieImagesViewController.h"
@@ -48,6 +47,7 @@
 
 @implementation TRBMovieInfoViewController {
 	TRBMovie * _movieInfo;
+	TRBMovieLoader * _loader;
 	__weak IBOutlet UIBarButtonItem *_actionButton;
 }
 
@@ -60,11 +60,28 @@
 #pragma mark - Public Methods
 
 - (void)showMovie:(TRBMovie *)movie {
+	[_loader cancel];
 	_movieInfo = movie;
+	_loader = [[TRBMovieLoader alloc] initWithMovie:movie];
 	if (self.isViewLoaded)
 		[self displayMovie];
-	[self fetchRTMovieInfo];
-	[self fetchTMDbMovieInfo];
+	// The RT cast is only a fallback for movies without a TMDb match, it is loaded on demand.
+	TRBMovieSection sections = TRBMovieSectionsAll & ~TRBMovieSectionRTCast;
+	[_loader loadSections:sections sectionHandler:^(TRBMovieSection section, id result, NSError * error) {
+		switch (section) {
+			case TRBMovieSectionRTInfo:
+				if (!result && error)
+					[[TKAlertCenter defaultCenter] postAlertWithMessage:[error localizedDescription]];
+				break;
+			case TRBMovieSectionBackdrop:
+				_backdrop.image = result ?: _movieInfo.posterImage;
+				break;
+			default:
+				break;
+		}
+	} completion:^(TRBMovie * loadedMovie) {
+		[self displayMovie];
+	}];
 }
 
 #pragma mark - Table view delegate
@@ -82,13 +99,13 @@
 		case 0: {
 			// fetch trailers
 			TRBMovieTrailersViewController * controller = [self.storyboard instantiateViewControllerWithIdentifier:@"TRBMovieTrailersViewController"];
-			[controller showTrailersForMovie:_movieInfo];
+			[controller showTrailersWithLoader:_loader];
 			[self.navigationController pushViewController:controller animated:YES];
 			break;
 		} case 1: {
 			// fetch images
 			TRBMovieImagesViewController * controller = [self.storyboard instantiateViewControllerWithIdentifier:@"TRBMovieImagesViewController"];
-			[controller showImagesForMovie:_movieInfo];
+			[controller showImagesWithLoader:_loader];
 			[self.navigationController pushViewController:controller animated:YES];
 			break;
 		} case 2: {
@@ -135,14 +152,11 @@
 
 - (void)prepareForSegue:(UIStoryboardSegue *)segue sender:(id)sender {
 	if ([segue.identifier isEqualToString:@"TRBShowCast"]) {
-		TRBCastSource source = TRBCastSourceTMDb;
 		TRBMovieCastViewController * controller = (TRBMovieCastViewController *)segue.destinationViewController;
-		if (!_movieInfo.tmdbID)
-			source = TRBCastSourceRT;
-		[controller showCastForMovie:_movieInfo andSource:source];
+		[controller showCastWithLoader:_loader];
 	} else if ([segue.identifier isEqualToString:@"TRBShowReviews"]) {
 		TRBMovieReviewsViewController * controller = (TRBMovieReviewsViewController *)segue.destinationViewController;
-		[controller showReviewsForMovie:_movieInfo];
+		[controller showReviewsWithLoader:_loader];
 	}
 }
 
@@ -182,43 +196,4 @@
 
 }
 
-- (void)fetchRTMovieInfo {
-	[[TRBRottenTomatoesClient sharedInstance] fetchMovieInfoForID:_movieInfo.rtID withHandler:^(NSDictionary *json, NSError *error) {
-		LogCE(error != nil, [error localizedDescription]);
-		if (json) {
-			[_movieInfo updateWithRTInfo:json];
-			[self displayMovie];
-		} else if (error)
-			[[TKAlertCenter defaultCenter] postAlertWithMessage:[error localizedDescription]];
-	}];
-}
-
-- (void)fetchTMDbMovieInfo {
-	[[TRBTMDbClient sharedInstance] findMovieWithRTMovie:_movieInfo completion:^(NSDictionary *json, NSError *error) {
-		LogCE(error != nil, [error localizedDescription]);
-		if (json) {
-			[_movieInfo updateWithTMDbInfo:json];
-			[self displayMovie];
-			[self fetchBackdrop];
-		} else
-			_backdrop.image = _movieInfo.posterImage;
-	}];
-}
-
-- (void)fetchBackdrop {
-    NSString * backdropPath = _movieInfo.backdropPath;
-	if ([backdropPath isKindOfClass:[NSString class]] && [backdropPath length]) {
-		TRBTMDbBackdropSize size = TRBTMDbBackdropSizeW300;
-		if ([UIScreen mainScreen].scale > 1.0)
-			size = TRBTMDbBackdropSizeW780;
-		[[TRBTMDbClient sharedInstance] fetchBackdrop:backdropPath withSize:size completion:^(UIImage *image, NSError * error) {
-			LogCE(error != nil, [error localizedDescription]);
-			if (!image)
-				image =  _movieInfo.posterImage;
-			_backdrop.image = image;
-		}];
-	} else
-		_backdrop.image = _movieInfo.posterImage;
-}
-
 @end
@@ -67,6 +67,8 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
 	NSUInteger _page;
 
 	NSOperationQueue * _queue;
+	TRBAsyncOperation * _listOperation;
+	TRBAsyncOperation * _searchOperation;
 	BOOL _shouldPerformSearch;
 }
 
@@ -74,7 +76,6 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
     self = [super initWithCoder:aDecoder];
     if (self) {
 		_queue = [[NSOperationQueue alloc] init];
-		[_queue setMaxConcurrentOperationCount:1];
 		_movies[TRBMovieModeList] = [NSMutableArray new];
 		_page = 1;
 		_movies[TRBMovieModeSearch] = [NSMutableArray new];
@@ -86,11 +87,10 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
 																	  NSString * query = [note userInfo][TRBSearchQueryKey];
 																	  if ([query length]) {
 																		  _currentQuery = query;
-																		  [_movies[TRBMovieModeSearch] removeAllObjects];
 																		  if (self.isViewLoaded) {
 																			  [self.searchDisplayController setActive:YES animated:NO];
 																			  _searchBar.text = query;
-																			  [self startSearch];
+																			  [self startNewSearch];
 																		  } else
 																			  _shouldPerformSearch = YES;
 																	  }
@@ -143,7 +143,7 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
 		_shouldPerformSearch = NO;
 		[self.searchDisplayController setActive:YES animated:NO];
 		_searchBar.text = _currentQuery;
-		[self startSearch];
+		[self startNewSearch];
 	}
 }
 
@@ -182,10 +182,8 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
 
 - (void)searchBarSearchButtonClicked:(UISearchBar *)searchBar {
 	_currentQuery = searchBar.text;
-	if ([_currentQuery length]) {
-		[_movies[TRBMovieModeSearch] removeAllObjects];
-		[self startSearch];
-	}
+	if ([_currentQuery length])
+		[self startNewSearch];
 	[searchBar resignFirstResponder];
 }
 
@@ -194,7 +192,8 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
 - (void)scrollViewDidScroll:(UIScrollView *)scrollView {
 	UITableView * tableView = (UITableView *)scrollView;
 	 NSInteger count = [_movies[tableView.tag] count];
-	if (![self.refreshControl isRefreshing] && (tableView != self.tableView) && _totalResults > count) {
+	BOOL searching = _searchOperation && !_searchOperation.isFinished;
+	if (!searching && (tableView != self.tableView) && _totalResults > count) {
 		CGFloat actualPosition = scrollView.contentOffset.y;
 		CGFloat contentHeight = scrollView.contentSize.height - (tableView.rowHeight * 6.0);
 		if (actualPosition >= contentHeight) {
@@ -338,11 +337,15 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
 }
 
 - (void)fetchList {
-	[_queue addOperation:[TRBAsyncOperation operationWithBlock:^(TRBAsyncOperation *op) {
+	[_listOperation cancel];
+	_listOperation = [TRBAsyncOperation operationWithBlock:^(TRBAsyncOperation *op) {
 		if (![self.refreshControl isRefreshing])
 			[self.refreshControl beginRefreshing];
-		[[TRBRottenTomatoesClient sharedInstance] fetchMovieList:_currentList withHandler:^(NSDictionary *json, NSError *error) {
-			[self.refreshControl endRefreshing];
+		op.task = [[TRBRottenTomatoesClient sharedInstance] fetchMovieList:_currentList withHandler:^(NSDictionary *json, NSError *error) {
+			if (op.isCancelled)
+				return;
+			[op stop];
+			[self endRefreshingIfIdle];
 			LogCE(error != nil, [error localizedDescription]);
 			[_movies[TRBMovieModeList] removeAllObjects];
 			if (json) {
@@ -360,9 +363,9 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
 				}
 			} else if (error)
 				[[TKAlertCenter defaultCenter] postAlertWithMessage:[error localizedDescription]];
-			[op stop];
 		}];
-	}]];
+	}];
+	[_queue addOperation:_listOperation];
 }
 
 - (void)fetchPosterForMovie:(TRBMovie *)movie inTable:(UITableView *)tableView atIndexPath:(NSIndexPath *)indexPath {
@@ -379,13 +382,30 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
 	}];
 }
 
+- (void)startNewSearch {
+	[_searchOperation cancel];
+	_searchOperation = nil;
+	_page = 1;
+	_totalResults = 0;
+	[_movies[TRBMovieModeSearch] removeAllObjects];
+	[self.searchDisplayController.searchResultsTableView reloadData];
+	[self startSearch];
+}
+
 - (void)startSearch {
-	[_queue addOperation:[TRBAsyncOperation operationWithBlock:^(TRBAsyncOperation *op) {
+	// Further pages wait for the previous one so results are appended in order.
+	NSArray * dependencies = _searchOperation ? @[_searchOperation] : nil;
+	NSString * query = _currentQuery;
+	NSUInteger page = _page;
+	_searchOperation = [TRBAsyncOperation operationWithBlock:^(TRBAsyncOperation *op) {
 		_searchBar.showsSearchResultsButton = NO;
 		if (![self.refreshControl isRefreshing])
 			[self.refreshControl beginRefreshing];
-		[[TRBRottenTomatoesClient sharedInstance] searchWithQuery:_currentQuery page:_page andHandler:^(NSDictionary *json, NSError *error) {
-			[self.refreshControl endRefreshing];
+		op.task = [[TRBRottenTomatoesClient sharedInstance] searchWithQuery:query page:page andHandler:^(NSDictionary *json, NSError *error) {
+			if (op.isCancelled)
+				return;
+			[op stop];
+			[self endRefreshingIfIdle];
 			LogCE(error != nil, [error localizedDescription]);
 			if (json) {
 				NSArray * movies = json[@"movies"];
@@ -397,9 +417,14 @@ typedef NS_ENUM(NSUInteger, TRBMovieMode) {
 			} else if (error)
 				[[TKAlertCenter defaultCenter] postAlertWithMessage:[error localizedDescription]];
 			[self.searchDisplayController.searchResultsTableView reloadData];
-			[op stop];
 		}];
-	}]];
+	} dependencies:dependencies];
+	[_queue addOperation:_searchOperation];
+}
+
+- (void)endRefreshingIfIdle {
+	if (!_listOperation.isExecuting && !_searchOperation.isExecuting)
+		[self.refreshControl endRefreshing];
 }
 
 - (void)searchOnTorrentz:(TRBMovie *)movie {
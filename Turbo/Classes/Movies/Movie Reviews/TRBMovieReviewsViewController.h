@@ -21,11 +21,11 @@
  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
-@class TRBMovie;
+@class TRBMovieLoader;
 
 @interface TRBMovieReviewsViewController : UITableViewController
 
-- (void)showReviewsForMovie:(TRBMovie *)movie;
+- (void)showReviewsWithLoader:(TRBMovieLoader *)loader;
 
 @end
 
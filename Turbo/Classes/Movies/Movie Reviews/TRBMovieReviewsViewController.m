@@ -24,6 +24,7 @@
 #import "TRBMovieReviewsViewController.h"
 #import "TRBRottenTomatoesClient.h"
 #import "TRBMovie.h"
+#import "TRBMovieLoader.h"
 #import "TRBTabBarController.h"
 #import "TKAlertCenter.h"
 
@@ -50,11 +51,14 @@
 
 #pragma mark - Public Methods
 
-- (void)showReviewsForMovie:(TRBMovie *)movie {
-	_movie = movie;
+- (void)showReviewsWithLoader:(TRBMovieLoader *)loader {
+	_movie = loader.movie;
 	_page = 1;
 	[_reviews removeAllObjects];
-	[self fetchReviews];
+	// The first page is usually prefetched with the movie details.
+	[loader fetchSection:TRBMovieSectionReviews handler:^(NSDictionary * json, NSError * error) {
+		[self handleReviews:json error:error];
+	}];
 }
 
 #pragma mark - UIScrollViewDelegate
@@ -135,14 +139,18 @@
 - (void)fetchReviews {
 	[[TRBRottenTomatoesClient sharedInstance] fetchMovieReviewsForID:_movie.rtID page:_page withHandler:^(NSDictionary *json, NSError *error) {
 		LogCE(error != nil, [error localizedDescription]);
-		if (json) {
-			[_reviews addObjectsFromArray:json[@"reviews"]];
-			[self.tableView reloadData];
-		} else if (error)
-			[[TKAlertCenter defaultCenter] postAlertWithMessage:[error localizedDescription]];
+		[self handleReviews:json error:error];
 	}];
 }
 
+- (void)handleReviews:(NSDictionary *)json error:(NSError *)error {
+	if (json) {
+		[_reviews addObjectsFromArray:json[@"reviews"]];
+		[self.tableView reloadData];
+	} else if (error)
+		[[TKAlertCenter defaultCenter] postAlertWithMessage:[error localizedDescription]];
+}
+
 @end
 
 @implementation TRBMovieReviewCell
@@ -21,11 +21,11 @@
  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
-@class TRBMovie;
+@class TRBMovieLoader;
 
 @interface TRBMovieImagesViewController : UICollectionViewController<UICollectionViewDelegateFlowLayout>
 
-- (void)showImagesForMovie:(TRBMovie *)movie;
+- (void)showImagesWithLoader:(TRBMovieLoader *)loader;
 
 @end
 
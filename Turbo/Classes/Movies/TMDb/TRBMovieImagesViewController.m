@@ -25,6 +25,7 @@
 #import "TRBMovieFullImageViewController.h"
 #import "TRBTMDbClient.h"
 #import "TRBMovie.h"
+#import "TRBMovieLoader.h"
 #import "NSDictionary+TRBAdditions.h"
 
 @interface TRBMovieImagesViewController ()
@@ -72,9 +73,9 @@
 
 #pragma mark - Public Methods
 
-- (void)showImagesForMovie:(TRBMovie *)movie {
-	self.title = movie.title;
-	[[TRBTMDbClient sharedInstance] fetchMovieImagesWithID:movie.tmdbID completion:^(NSDictionary *json, NSError *error) {
+- (void)showImagesWithLoader:(TRBMovieLoader *)loader {
+	self.title = loader.movie.title;
+	[loader fetchSection:TRBMovieSectionImages handler:^(NSDictionary *json, NSError *error) {
 		LogCE(error != nil, [error localizedDescription]);
 		_backdrops = json[@"backdrops"];
 		_posters = json[@"posters"];
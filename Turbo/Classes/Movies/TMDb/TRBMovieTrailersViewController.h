@@ -21,11 +21,11 @@
  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
-@class TRBMovie;
+@class TRBMovieLoader;
 
 @interface TRBMovieTrailersViewController : UITableViewController
 
-- (void)showTrailersForMovie:(TRBMovie *)movie;
+- (void)showTrailersWithLoader:(TRBMovieLoader *)loader;
 
 @end
 
@@ -22,9 +22,8 @@
  */
 
 #import "TRBMovieTrailersViewController.h"
-#import "TRBTMDbClient.h"
+#import "TRBMovieLoader.h"
 #import "TRBWebNavigationController.h"
-#import "TRBMovie.h"
 #import "TRBTabBarController.h"
 #import "TRBHTTPSession.h"
 
@@ -77,8 +76,8 @@ typedef NS_ENUM(NSUInteger, TRBTrailerSection) {
 
 #pragma mark - Public Methods
 
-- (void)showTrailersForMovie:(TRBMovie *)movie {
-	[[TRBTMDbClient sharedInstance] fetchMovieTrailersWithID:movie.tmdbID completion:^(NSDictionary *json, NSError *error) {
+- (void)showTrailersWithLoader:(TRBMovieLoader *)loader {
+	[loader fetchSection:TRBMovieSectionTrailers handler:^(NSDictionary *json, NSError *error) {
 		_trailers[TRBTrailerSectionYT] = json[@"youtube"];
 		_trailers[TRBTrailerSectionQT] = json[@"quicktime"];
 		[self.tableView reloadData];
@@ -67,13 +67,13 @@ typedef NS_ENUM(NSUInteger, TRBTMDbImageType) {
 + (instancetype)sharedInstance;
 
 - (void)fetchMovieList:(TRBTMDbListType)listType withPage:(NSUInteger)page completion:(TRBJSONResultBlock)completion;
-- (void)fetchMovieInfoWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion;
-- (void)fetchMovieTrailersWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion;
-- (void)fetchMovieImagesWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion;
-- (void)fetchMovieCastsWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion;
+- (NSURLSessionDataTask *)fetchMovieInfoWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion;
+- (NSURLSessionDataTask *)fetchMovieTrailersWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion;
+- (NSURLSessionDataTask *)fetchMovieImagesWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion;
+- (NSURLSessionDataTask *)fetchMovieCastsWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion;
 - (void)searchMoviesWithQuery:(NSString *)query page:(NSUInteger)page completion:(TRBJSONResultBlock)completion;
 - (void)fetchPoster:(NSString *)poster withSize:(TRBTMDbPosterSize)size completion:(TRBImageResultBlock)completion;
-- (void)fetchBackdrop:(NSString *)backdrop withSize:(TRBTMDbBackdropSize)size completion:(TRBImageResultBlock)completion;
+- (NSURLSessionDataTask *)fetchBackdrop:(NSString *)backdrop withSize:(TRBTMDbBackdropSize)size completion:(TRBImageResultBlock)completion;
 - (void)fetchProfileImage:(NSString *)profile withSize:(TRBTMDbProfileSize)size completion:(TRBImageResultBlock)completion;
 - (void)findMovieWithRTMovie:(TRBMovie *)rtMovie completion:(TRBJSONResultBlock)completion;
 
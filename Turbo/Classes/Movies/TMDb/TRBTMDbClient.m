@@ -26,8 +26,21 @@
 #import "TRBHTTPSession.h"
 #import "NSString+Levenshtein.h"
 #import "NSDictionary+TRBAdditions.h"
+#import "TRBJSONCache.h"
 #import "API_KEYS.h"
 
+#define MATCH_CANDIDATES_PER_ROUND 3
+#define MATCH_MAX_TITLE_DISTANCE 10.0
+
+#define CONFIG_MAX_AGE (3 * 86400.0)
+#define LIST_MAX_AGE (6 * 3600.0)
+#define MOVIE_MAX_AGE (7 * 86400.0)
+#define SEARCH_MAX_AGE 3600.0
+
+static NSString * const TRBTMDbConfigCacheKey = @"configuration";
+
+static NSString * const TRBTMDbMatchesFileName = @"TRBTMDbMatches.plist";
+
 static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 	@"movie/popular",
 	@"movie/upcoming",
@@ -42,6 +55,10 @@ static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 	TRBHTTPJSONResponseParser * _responseParser;
 	NSString * _apiKey;
 	NSURL * _baseURL;
+	NSMutableDictionary * _matches;
+	NSString * _matchesPath;
+	dispatch_queue_t _matchesQueue;
+	TRBJSONCache * _cache;
 }
 
 + (instancetype)sharedInstance {
@@ -62,6 +79,15 @@ static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 		_responseParser = [TRBHTTPJSONResponseParser new];
 		_baseURL = [NSURL URLWithString:@"http://api.themoviedb.org/3/"];
 		_apiKey = TMDbAPIKey;
+		_matchesPath = [TRBLibraryDir() stringByAppendingPathComponent:TRBTMDbMatchesFileName];
+		_matches = [NSMutableDictionary dictionaryWithContentsOfFile:_matchesPath] ?: [NSMutableDictionary dictionary];
+		_matchesQueue = dispatch_queue_create("com.caffeineapps.TRBTMDbMatchesQueue", DISPATCH_QUEUE_SERIAL);
+		_cache = [TRBJSONCache cacheWithName:@"TMDb"];
+		// A persisted configuration is used even when expired, it is refreshed in the background.
+		BOOL expired = YES;
+		_config = [_cache JSONForKey:TRBTMDbConfigCacheKey expired:&expired];
+		if (expired)
+			[self fetchConfigWithCompletion:nil];
 	}
 	return self;
 }
@@ -72,35 +98,35 @@ static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 	NSURL * URL = [NSURL URLWithString:TRBTMDbListEndpoints[listType] relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
 	NSDictionary * parameters = @{@"page": [NSString stringWithFormat:@"%lu", (unsigned long)page]};
-	[self submitTMDbRequest:request withParameters:parameters completion:completion];
+	[self submitTMDbRequest:request withParameters:parameters maxAge:LIST_MAX_AGE completion:completion];
 }
 
-- (void)fetchMovieInfoWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion {
+- (NSURLSessionDataTask *)fetchMovieInfoWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion {
 	NSString * URLString = [NSString stringWithFormat:@"movie/%@", movieID];
 	NSURL * URL = [NSURL URLWithString:URLString relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
-	[self submitTMDbRequest:request withParameters:nil completion:completion];
+	return [self submitTMDbRequest:request withParameters:nil maxAge:MOVIE_MAX_AGE completion:completion];
 }
 
-- (void)fetchMovieTrailersWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion {
+- (NSURLSessionDataTask *)fetchMovieTrailersWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion {
 	NSString * URLString = [NSString stringWithFormat:@"movie/%@/trailers", movieID];
 	NSURL * URL = [NSURL URLWithString:URLString relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
-	[self submitTMDbRequest:request withParameters:nil completion:completion];
+	return [self submitTMDbRequest:request withParameters:nil maxAge:MOVIE_MAX_AGE completion:completion];
 }
 
-- (void)fetchMovieImagesWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion {
+- (NSURLSessionDataTask *)fetchMovieImagesWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion {
 	NSString * URLString = [NSString stringWithFormat:@"movie/%@/images", movieID];
 	NSURL * URL = [NSURL URLWithString:URLString relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
-	[self submitTMDbRequest:request withParameters:nil completion:completion];
+	return [self submitTMDbRequest:request withParameters:nil maxAge:MOVIE_MAX_AGE completion:completion];
 }
 
-- (void)fetchMovieCastsWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion {
+- (NSURLSessionDataTask *)fetchMovieCastsWithID:(NSNumber *)movieID completion:(TRBJSONResultBlock)completion {
 	NSString * URLString = [NSString stringWithFormat:@"movie/%@/casts", movieID];
 	NSURL * URL = [NSURL URLWithString:URLString relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
-	[self submitTMDbRequest:request withParameters:nil completion:completion];
+	return [self submitTMDbRequest:request withParameters:nil maxAge:MOVIE_MAX_AGE completion:completion];
 }
 
 - (void)fetchPoster:(NSString *)poster withSize:(TRBTMDbPosterSize)size completion:(TRBImageResultBlock)completion {
@@ -108,9 +134,9 @@ static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 	[self fetchImageAtPath:poster withSize:sizeString completion:completion];
 }
 
-- (void)fetchBackdrop:(NSString *)backdrop withSize:(TRBTMDbBackdropSize)size completion:(TRBImageResultBlock)completion {
+- (NSURLSessionDataTask *)fetchBackdrop:(NSString *)backdrop withSize:(TRBTMDbBackdropSize)size completion:(TRBImageResultBlock)completion {
 	NSString * sizeString = _config[@"images"][@"backdrop_sizes"][size];
-	[self fetchImageAtPath:backdrop withSize:sizeString completion:completion];
+	return [self fetchImageAtPath:backdrop withSize:sizeString completion:completion];
 }
 
 - (void)fetchProfileImage:(NSString *)profile withSize:(TRBTMDbProfileSize)size completion:(TRBImageResultBlock)completion {
@@ -122,23 +148,22 @@ static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 	NSURL * URL = [NSURL URLWithString:@"search/movie" relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
 	NSDictionary * parameters = @{@"query": query, @"page": [NSString stringWithFormat:@"%lu", (unsigned long)page]};
-	[self submitTMDbRequest:request withParameters:parameters completion:completion];
+	[self submitTMDbRequest:request withParameters:parameters maxAge:SEARCH_MAX_AGE completion:completion];
 }
 
 - (void)findMovieWithRTMovie:(TRBMovie *)rtMovie completion:(TRBJSONResultBlock)handler {
 	NSString * movieToFind = rtMovie.title;
 	if (handler) {
+		NSString * matchKey = [self matchKeyForRTMovie:rtMovie];
+		NSNumber * tmdbID = matchKey ? _matches[matchKey] : nil;
+		if (tmdbID) {
+			[self fetchMovieInfoWithID:tmdbID completion:handler];
+			return;
+		}
 		[self searchMoviesWithQuery:movieToFind page:1 completion:^(NSDictionary *json, NSError * error) {
-			NSArray * results = json[@"results"];
-			NSMutableArray * possibleMatches = [[NSMutableArray alloc] initWithCapacity:[results count]];
-			for (NSDictionary * result in results) {
-				NSString * original_title = result[@"original_title"];
-				NSString * title = result[@"title"];
-				if ([original_title compareWithString:movieToFind] <= 10.0 || [title compareWithString:movieToFind] < 10.0)
-					[possibleMatches addObject:result];
-			}
-			if ([possibleMatches count])
-				[self fetchMovieInfoWithRTMovie:rtMovie forPossibleMatches:possibleMatches completion:handler];
+			NSArray * candidates = [self rankedCandidates:json[@"results"] forRTMovie:rtMovie];
+			if ([candidates count])
+				[self fetchMovieInfoWithRTMovie:rtMovie forCandidates:candidates fromIndex:0 completion:handler];
 			else {
 				handler(nil, [NSError errorWithDomain:NSStringFromClass([self class])
 												 code:1337
@@ -150,29 +175,94 @@ static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 
 #pragma mark - Private Methods
 
-- (void)fetchMovieInfoWithRTMovie:(TRBMovie *)rtMovie forPossibleMatches:(NSMutableArray *)possibleMatches completion:(TRBJSONResultBlock)completion {
-	NSDictionary * possibleMatch = possibleMatches[0];
-	[possibleMatches removeObjectAtIndex:0];
-	[self fetchMovieInfoWithID:possibleMatch[@"id"] completion:^(NSDictionary * match, NSError *error) {
-		NSString * imdbID = [match valueForKey:@"imdb_id" andIsKindOfClass:[NSString class]];
-		NSString * releaseDate = [match valueForKey:@"release_date" andIsKindOfClass:[NSString class]];
-		if ([imdbID isEqualToString:rtMovie.imdbID] || [releaseDate isEqualToString:rtMovie.releaseDate])
-			completion(match, nil);
-		else if ([possibleMatches count])
-			[self fetchMovieInfoWithRTMovie:rtMovie forPossibleMatches:possibleMatches completion:completion];
-		else {
-			completion(nil, [NSError errorWithDomain:NSStringFromClass([self class])
-												code:1337
-											userInfo:@{NSLocalizedDescriptionKey: @"No match found"}]);
+- (NSString *)matchKeyForRTMovie:(TRBMovie *)rtMovie {
+	NSString * result = nil;
+	if (rtMovie.rtID)
+		result = [NSString stringWithFormat:@"rt:%@", rtMovie.rtID];
+	else if ([rtMovie.imdbID length])
+		result = [NSString stringWithFormat:@"imdb:%@", rtMovie.imdbID];
+	return result;
+}
+
+- (void)storeMatch:(NSNumber *)tmdbID forRTMovie:(TRBMovie *)rtMovie {
+	NSString * matchKey = [self matchKeyForRTMovie:rtMovie];
+	if (!matchKey || !tmdbID)
+		return;
+	_matches[matchKey] = tmdbID;
+	NSDictionary * matches = [_matches copy];
+	dispatch_async(_matchesQueue, ^{
+		[matches writeToFile:_matchesPath atomically:YES];
+	});
+}
+
+- (NSArray *)rankedCandidates:(NSArray *)results forRTMovie:(TRBMovie *)rtMovie {
+	NSString * movieToFind = rtMovie.title;
+	NSInteger year = [rtMovie.year integerValue];
+	NSMutableArray * scored = [NSMutableArray arrayWithCapacity:[results count]];
+	for (NSDictionary * result in results) {
+		NSString * originalTitle = [result valueForKey:@"original_title" andIsKindOfClass:[NSString class]];
+		NSString * title = [result valueForKey:@"title" andIsKindOfClass:[NSString class]];
+		float distance = MIN(originalTitle ? [originalTitle compareWithString:movieToFind maxDistance:MATCH_MAX_TITLE_DISTANCE] : MAXFLOAT,
+							 title ? [title compareWithString:movieToFind maxDistance:MATCH_MAX_TITLE_DISTANCE] : MAXFLOAT);
+		if (distance > MATCH_MAX_TITLE_DISTANCE)
+			continue;
+		NSString * releaseDate = [result valueForKey:@"release_date" andIsKindOfClass:[NSString class]];
+		if (year && [releaseDate length] >= 4) {
+			NSInteger delta = labs([[releaseDate substringToIndex:4] integerValue] - year);
+			distance += delta == 0 ? -2.0 : (delta == 1 ? 0.0 : 2.0);
 		}
+		[scored addObject:@[@(distance), result]];
+	}
+	[scored sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSArray * a, NSArray * b) {
+		return [a[0] compare:b[0]];
 	}];
+	return [scored valueForKey:@"lastObject"];
+}
+
+- (BOOL)isMovieInfo:(NSDictionary *)match matchingRTMovie:(TRBMovie *)rtMovie {
+	NSString * imdbID = [match valueForKey:@"imdb_id" andIsKindOfClass:[NSString class]];
+	NSString * releaseDate = [match valueForKey:@"release_date" andIsKindOfClass:[NSString class]];
+	return [imdbID isEqualToString:rtMovie.imdbID] || [releaseDate isEqualToString:rtMovie.releaseDate];
+}
+
+// Fetches a round of the best ranked candidates at once, the first confirmed one cancels the others.
+- (void)fetchMovieInfoWithRTMovie:(TRBMovie *)rtMovie forCandidates:(NSArray *)candidates fromIndex:(NSUInteger)index completion:(TRBJSONResultBlock)completion {
+	NSRange range = NSMakeRange(index, MIN(MATCH_CANDIDATES_PER_ROUND, [candidates count] - index));
+	NSMutableArray * tasks = [NSMutableArray arrayWithCapacity:range.length];
+	__block NSUInteger pending = range.length;
+	__block BOOL resolved = NO;
+	for (NSDictionary * candidate in [candidates subarrayWithRange:range]) {
+		NSString * URLString = [NSString stringWithFormat:@"movie/%@", candidate[@"id"]];
+		NSURLRequest * request = [NSURLRequest requestWithURL:[NSURL URLWithString:URLString relativeToURL:_baseURL]];
+		NSURLSessionDataTask * task = [self submitTMDbRequest:request withParameters:nil maxAge:MOVIE_MAX_AGE completion:^(NSDictionary * match, NSError * error) {
+			pending--;
+			if (resolved)
+				return;
+			if ([self isMovieInfo:match matchingRTMovie:rtMovie]) {
+				resolved = YES;
+				[tasks makeObjectsPerformSelector:@selector(cancel)];
+				[self storeMatch:[match valueForKey:@"id" andIsKindOfClass:[NSNumber class]] forRTMovie:rtMovie];
+				completion(match, nil);
+			} else if (!pending) {
+				if (NSMaxRange(range) < [candidates count])
+					[self fetchMovieInfoWithRTMovie:rtMovie forCandidates:candidates fromIndex:NSMaxRange(range) completion:completion];
+				else {
+					completion(nil, [NSError errorWithDomain:NSStringFromClass([self class])
+														code:1337
+													userInfo:@{NSLocalizedDescriptionKey: @"No match found"}]);
+				}
+			}
+		}];
+		if (task)
+			[tasks addObject:task];
+	}
 }
 
-- (void)fetchImageAtPath:(NSString *)imagePath withSize:(NSString *)size completion:(TRBImageResultBlock)completion {
+- (NSURLSessionDataTask *)fetchImageAtPath:(NSString *)imagePath withSize:(NSString *)size completion:(TRBImageResultBlock)completion {
 	if (_config) {
 		NSString * baseUrl = _config[@"images"][@"base_url"];
 		NSString * urlString = [NSString stringWithFormat:@"%@%@%@", baseUrl, size, imagePath];
-		[_session GET:urlString parameters:nil builder:nil parser:nil completion:^(id data, NSURLResponse *response, NSError *error) {
+		return [_session GET:urlString parameters:nil builder:nil parser:nil completion:^(id data, NSURLResponse *response, NSError *error) {
 			if (!error && completion) {
 				NSData * imageData = data;
 				UIImage * downloadedImage = [UIImage imageWithData:imageData scale:[UIScreen mainScreen].scale];
@@ -201,6 +291,7 @@ static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 			}
 		}];
 	}
+	return nil;
 }
 
 - (void)fetchConfigWithCompletion:(void (^)(BOOL success, NSError * error))completion {
@@ -211,14 +302,27 @@ static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 				   builder:_requestBuilder
 					parser:_responseParser
 				completion:^(id data, NSURLResponse *response, NSError *error) {
-					if (!error)
+					if (!error) {
 						_config = data;
+						[_cache storeJSON:data forKey:TRBTMDbConfigCacheKey maxAge:CONFIG_MAX_AGE];
+					}
 					if (completion)
 						completion(_config != nil, error);
 				}];
 }
 
-- (void)submitTMDbRequest:(NSURLRequest *)request withParameters:(NSDictionary *)parameters completion:(TRBJSONResultBlock)completion {
+- (NSURLSessionDataTask *)submitTMDbRequest:(NSURLRequest *)request withParameters:(NSDictionary *)parameters maxAge:(NSTimeInterval)maxAge completion:(TRBJSONResultBlock)completion {
+	NSString * cacheKey = [TRBJSONCache keyForRequest:request parameters:parameters ignoring:nil];
+	BOOL expired = YES;
+	id cached = [_cache JSONForKey:cacheKey expired:&expired];
+	if (cached && !expired) {
+		if (completion) {
+			dispatch_async(dispatch_get_main_queue(), ^{
+				completion(cached, nil);
+			});
+		}
+		return nil;
+	}
 	if (_config) {
 		if (parameters) {
 			NSMutableDictionary * mParameters = [parameters mutableCopy];
@@ -226,37 +330,44 @@ static NSString * const TRBTMDbListEndpoints[TRBTMDbListTypeCount] = {
 			parameters = [mParameters copy];
 		} else
 			parameters = @{@"api_key": _apiKey};
-		[_session startRequest:request
+		return [_session startRequest:request
 					parameters:parameters
 					   builder:_requestBuilder
 						parser:_responseParser
 					completion:^(id data, NSURLResponse *response, NSError *error) {
-						if (!error && completion)
-							completion(data, nil);
-						else if (completion) {
+						if (!error && data) {
+							[_cache storeJSON:data forKey:cacheKey maxAge:[TRBJSONCache maxAgeForResponse:response defaultMaxAge:maxAge]];
+							if (completion)
+								completion(data, nil);
+						} else if (completion) {
 							if (!error) {
 								error = [NSError errorWithDomain:NSURLErrorDomain
 															code:NSURLErrorBadServerResponse
 														userInfo:@{NSLocalizedDescriptionKey: @"Unsupported Status Code"}];
 							}
-							if (completion)
+							// An expired response is still better than nothing when offline.
+							if (cached && error.code != NSURLErrorCancelled && error.code != NSURLErrorBadServerResponse)
+								completion(cached, nil);
+							else
 								completion(nil, error);
 						}
 					}];
 	} else {
 		[self fetchConfigWithCompletion:^(BOOL success, NSError *error) {
 			if (success)
-				[self submitTMDbRequest:request withParameters:parameters completion:completion];
+				[self submitTMDbRequest:request withParameters:parameters maxAge:maxAge completion:completion];
 			else {
 				if (!error) {
 					error = [NSError errorWithDomain:NSStringFromClass([self class])
 												code:-1093
 											userInfo:@{NSLocalizedDescriptionKey: @"Cannot retrieve configuration"}];
 				}
-				completion(nil, error);
+				if (completion)
+					completion(nil, error);
 			}
 		}];
 	}
+	return nil;
 }
 
 @end
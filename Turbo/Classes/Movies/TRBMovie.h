@@ -21,9 +21,12 @@
  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+@class TRBLibraryItem;
+
 @interface TRBMovie : NSObject
 
 @property (nonatomic, strong) NSString * vsID;
+@property (nonatomic, strong) NSString * vsPosterMTime;
 @property (nonatomic, strong) NSString * rtID;
 @property (nonatomic, strong) NSNumber * tmdbID;
 @property (nonatomic, strong) NSString * imdbID;
@@ -53,6 +56,7 @@
 
 - (instancetype)initWithVSJSON:(NSDictionary *)movie;
 - (instancetype)initWithRTJSON:(NSDictionary *)movie;
+- (instancetype)initWithLibraryItem:(TRBLibraryItem *)item;
 - (void)updateWithVSInfo:(NSDictionary *)movie;
 - (void)updateWithRTInfo:(NSDictionary *)movie;
 - (void)updateWithTMDbInfo:(NSDictionary *)movie;
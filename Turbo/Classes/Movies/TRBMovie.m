@@ -23,6 +23,7 @@
 
 #import "TRBMovie.h"
 #import "NSArray+TRBAdditions.h"
+#import "TRBLibraryItem.h"
 
 @implementation TRBMovie
 
@@ -33,6 +34,7 @@
 	if (self) {
 		NSDictionary * additional = movie[@"additional"];
 		_vsID = movie[@"id"];
+		_vsPosterMTime = additional[@"poster_mtime"];
 		_title = movie[@"title"];
 		_tagline = movie[@"tagline"];
 		_releaseDate = movie[@"original_available"];
@@ -45,6 +47,23 @@
 	return self;
 }
 
+- (instancetype)initWithLibraryItem:(TRBLibraryItem *)item {
+	self = [super init];
+	if (self) {
+		_vsID = item.vsID;
+		_vsPosterMTime = item.posterMTime;
+		_title = item.title;
+		_tagline = item.tagline;
+		_releaseDate = item.releaseDate;
+		_synopsis = item.summary;
+		_genres = [[item namesInList:item.genres] componentsJoinedByString:@", "];
+		_cast = [[item namesInList:item.actors] componentsJoinedByString:@" | "];
+		_directors = [[item namesInList:item.directors] componentsJoinedByString:@", "];
+		_writers = [[item namesInList:item.writers] componentsJoinedByString:@", "];
+	}
+	return self;
+}
+
 - (instancetype)initWithRTJSON:(NSDictionary *)movie {
 	self = [super init];
 	if (self) {
@@ -0,0 +1,57 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+@class TRBMovie;
+
+typedef NS_OPTIONS(NSUInteger, TRBMovieSection) {
+	TRBMovieSectionVSInfo = 1 << 0,
+	TRBMovieSectionRTInfo = 1 << 1,
+	TRBMovieSectionTMDbInfo = 1 << 2,
+	TRBMovieSectionBackdrop = 1 << 3,
+	TRBMovieSectionRTCast = 1 << 4,
+	TRBMovieSectionTMDbCast = 1 << 5,
+	TRBMovieSectionReviews = 1 << 6,
+	TRBMovieSectionTrailers = 1 << 7,
+	TRBMovieSectionImages = 1 << 8,
+
+	TRBMovieSectionsCritical = TRBMovieSectionVSInfo | TRBMovieSectionRTInfo | TRBMovieSectionTMDbInfo,
+	TRBMovieSectionsAll = (1 << 9) - 1,
+};
+
+typedef void(^TRBMovieSectionBlock)(TRBMovieSection section, id result, NSError * error);
+
+// Loads everything shown for a movie, independent requests are issued in parallel
+// and dependent ones (everything keyed by the TMDb id) as soon as their input is in.
+@interface TRBMovieLoader : NSObject
+
+@property (nonatomic, strong, readonly) TRBMovie * movie;
+
+- (instancetype)initWithMovie:(TRBMovie *)movie;
+// The critical sections are always loaded, completion gets the merged movie once they are all in.
+- (void)loadSections:(TRBMovieSection)sections sectionHandler:(TRBMovieSectionBlock)sectionHandler completion:(void(^)(TRBMovie * movie))completion;
+// Result of a single section, loaded on demand if it was not requested yet.
+- (void)fetchSection:(TRBMovieSection)section handler:(void(^)(id result, NSError * error))handler;
+- (void)cancel;
+
+@end
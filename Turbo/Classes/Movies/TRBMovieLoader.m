@@ -0,0 +1,281 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBMovieLoader.h"
+#import "TRBMovie.h"
+#import "TRBLibraryManager.h"
+#import "TRBRottenTomatoesClient.h"
+#import "TRBTMDbClient.h"
+
+@implementation TRBMovieLoader {
+	TRBMovieSection _requested;
+	TRBMovieSection _started;
+	TRBMovieSection _finished;
+	NSMutableDictionary * _results;
+	NSMutableDictionary * _errors;
+	NSMutableDictionary * _waiting;
+	TRBMovieSectionBlock _sectionHandler;
+	void (^_completion)(TRBMovie * movie);
+	NSMutableDictionary * _tasks;
+	// Bumped by cancel, callbacks of an older generation are dropped.
+	NSUInteger _generation;
+}
+
+- (instancetype)initWithMovie:(TRBMovie *)movie {
+	self = [super init];
+	if (self) {
+		_movie = movie;
+		_results = [NSMutableDictionary new];
+		_errors = [NSMutableDictionary new];
+		_waiting = [NSMutableDictionary new];
+		_tasks = [NSMutableDictionary new];
+	}
+	return self;
+}
+
+#pragma mark - Public Methods
+
+- (void)loadSections:(TRBMovieSection)sections sectionHandler:(TRBMovieSectionBlock)sectionHandler completion:(void(^)(TRBMovie * movie))completion {
+	_sectionHandler = [sectionHandler copy];
+	_completion = [completion copy];
+	[self requestSections:sections | TRBMovieSectionsCritical];
+	[self checkCompletion];
+}
+
+- (void)fetchSection:(TRBMovieSection)section handler:(void(^)(id result, NSError * error))handler {
+	if (!handler)
+		return;
+	if (_finished & section) {
+		id result = _results[@(section)];
+		NSError * error = _errors[@(section)];
+		dispatch_async(dispatch_get_main_queue(), ^{
+			handler(result, error);
+		});
+	} else {
+		NSMutableArray * handlers = _waiting[@(section)];
+		if (!handlers) {
+			handlers = [NSMutableArray new];
+			_waiting[@(section)] = handlers;
+		}
+		[handlers addObject:[handler copy]];
+		[self requestSections:section];
+	}
+}
+
+- (void)cancel {
+	_generation++;
+	[[_tasks allValues] makeObjectsPerformSelector:@selector(cancel)];
+	[_tasks removeAllObjects];
+	// Sections still in flight are started again by the next load.
+	_started &= _finished;
+	_requested &= _finished;
+	_sectionHandler = nil;
+	_completion = nil;
+	[_waiting removeAllObjects];
+}
+
+#pragma mark - Private Methods
+
+- (TRBMovieSection)dependenciesOfSection:(TRBMovieSection)section {
+	TRBMovieSection result = 0;
+	switch (section) {
+		case TRBMovieSectionTMDbInfo:
+			// Library movies get their TMDb id from the Video Station details.
+			if (_movie.vsID)
+				result = TRBMovieSectionVSInfo;
+			break;
+		case TRBMovieSectionBackdrop:
+		case TRBMovieSectionTMDbCast:
+		case TRBMovieSectionTrailers:
+		case TRBMovieSectionImages:
+			result = TRBMovieSectionTMDbInfo;
+			break;
+		default:
+			break;
+	}
+	return result;
+}
+
+- (void)requestSections:(TRBMovieSection)sections {
+	TRBMovieSection closure = sections & TRBMovieSectionsAll;
+	TRBMovieSection previous = 0;
+	while (closure != previous) {
+		previous = closure;
+		for (TRBMovieSection section = 1; section & TRBMovieSectionsAll; section <<= 1) {
+			if (closure & section)
+				closure |= [self dependenciesOfSection:section];
+		}
+	}
+	_requested |= closure;
+	[self startReadySections];
+}
+
+- (void)startReadySections {
+	for (TRBMovieSection section = 1; section & TRBMovieSectionsAll; section <<= 1) {
+		BOOL pending = (_requested & section) && !(_started & section);
+		if (pending && !([self dependenciesOfSection:section] & ~_finished)) {
+			_started |= section;
+			[self startSection:section];
+		}
+	}
+}
+
+- (void)startSection:(TRBMovieSection)section {
+	TRBMovie * movie = _movie;
+	NSUInteger generation = _generation;
+	void (^finish)(id result, NSError * error) = ^(id result, NSError * error) {
+		if (generation != _generation)
+			return;
+		LogCE(error != nil, [error localizedDescription]);
+		[self finishSection:section result:result error:error];
+	};
+	NSURLSessionDataTask * task = nil;
+	BOOL skipped = NO;
+	switch (section) {
+		case TRBMovieSectionVSInfo:
+			if (movie.vsID) {
+				task = [[TRBLibraryManager sharedManager] fetchMovieDetailsForID:movie.vsID completion:^(NSDictionary * json, NSError * error) {
+					NSDictionary * info = error ? nil : [json[@"data"][@"movies"] firstObject];
+					if (info)
+						[movie updateWithVSInfo:info];
+					finish(info, error);
+				}];
+			} else
+				skipped = YES;
+			break;
+		case TRBMovieSectionRTInfo:
+			if (movie.rtID) {
+				task = [[TRBRottenTomatoesClient sharedInstance] fetchMovieInfoForID:movie.rtID withHandler:^(NSDictionary * json, NSError * error) {
+					if (json)
+						[movie updateWithRTInfo:json];
+					finish(json, error);
+				}];
+			} else
+				skipped = YES;
+			break;
+		case TRBMovieSectionTMDbInfo: {
+			TRBJSONResultBlock handler = ^(NSDictionary * json, NSError * error) {
+				if (json)
+					[movie updateWithTMDbInfo:json];
+				finish(json, error);
+			};
+			if (movie.tmdbID)
+				task = [[TRBTMDbClient sharedInstance] fetchMovieInfoWithID:movie.tmdbID completion:handler];
+			else if (movie.rtID)
+				[[TRBTMDbClient sharedInstance] findMovieWithRTMovie:movie completion:handler];
+			else
+				skipped = YES;
+			break;
+		} case TRBMovieSectionBackdrop: {
+			NSString * backdropPath = movie.backdropPath;
+			if (movie.backdropImage)
+				[self finishSectionLater:section result:movie.backdropImage];
+			else if ([backdropPath isKindOfClass:[NSString class]] && [backdropPath length]) {
+				TRBTMDbBackdropSize size = [UIScreen mainScreen].scale > 1.0 ? TRBTMDbBackdropSizeW780 : TRBTMDbBackdropSizeW300;
+				task = [[TRBTMDbClient sharedInstance] fetchBackdrop:backdropPath withSize:size completion:^(UIImage * image, NSError * error) {
+					if (image)
+						movie.backdropImage = image;
+					finish(image, error);
+				}];
+			} else
+				skipped = YES;
+			break;
+		} case TRBMovieSectionRTCast:
+			if (movie.rtID)
+				task = [[TRBRottenTomatoesClient sharedInstance] fetchCastsInfoForID:movie.rtID withHandler:finish];
+			else
+				skipped = YES;
+			break;
+		case TRBMovieSectionTMDbCast:
+			if (movie.tmdbID)
+				task = [[TRBTMDbClient sharedInstance] fetchMovieCastsWithID:movie.tmdbID completion:finish];
+			else
+				skipped = YES;
+			break;
+		case TRBMovieSectionReviews:
+			if (movie.rtID)
+				task = [[TRBRottenTomatoesClient sharedInstance] fetchMovieReviewsForID:movie.rtID page:1 withHandler:finish];
+			else
+				skipped = YES;
+			break;
+		case TRBMovieSectionTrailers:
+			if (movie.tmdbID)
+				task = [[TRBTMDbClient sharedInstance] fetchMovieTrailersWithID:movie.tmdbID completion:finish];
+			else
+				skipped = YES;
+			break;
+		case TRBMovieSectionImages:
+			if (movie.tmdbID)
+				task = [[TRBTMDbClient sharedInstance] fetchMovieImagesWithID:movie.tmdbID completion:finish];
+			else
+				skipped = YES;
+			break;
+		default:
+			skipped = YES;
+			break;
+	}
+	if (skipped)
+		[self finishSectionLater:section result:nil];
+	else if (task && !(_finished & section))
+		_tasks[@(section)] = task;
+}
+
+- (void)finishSectionLater:(TRBMovieSection)section result:(id)result {
+	NSUInteger generation = _generation;
+	// Keeps the callbacks asynchronous even when there is nothing to load.
+	dispatch_async(dispatch_get_main_queue(), ^{
+		if (generation == _generation)
+			[self finishSection:section result:result error:nil];
+	});
+}
+
+- (void)finishSection:(TRBMovieSection)section result:(id)result error:(NSError *)error {
+	_finished |= section;
+	[_tasks removeObjectForKey:@(section)];
+	if (result)
+		_results[@(section)] = result;
+	if (error)
+		_errors[@(section)] = error;
+	if (_sectionHandler)
+		_sectionHandler(section, result, error);
+	NSArray * handlers = _waiting[@(section)];
+	[_waiting removeObjectForKey:@(section)];
+	for (void (^handler)(id, NSError *) in handlers)
+		handler(result, error);
+	[self startReadySections];
+	[self checkCompletion];
+	// Drop the handlers once idle so they do not keep their owners alive.
+	if ((_finished & _requested) == _requested)
+		_sectionHandler = nil;
+}
+
+- (void)checkCompletion {
+	if (_completion && (_finished & TRBMovieSectionsCritical) == TRBMovieSectionsCritical) {
+		void (^completion)(TRBMovie * movie) = _completion;
+		_completion = nil;
+		completion(_movie);
+	}
+}
+
+@end
@@ -38,11 +38,11 @@ typedef NS_ENUM(NSUInteger, TRBRTListType) {
 
 + (instancetype)sharedInstance;
 
-- (void)fetchMovieList:(TRBRTListType)listType withHandler:(TRBJSONResultBlock)handler;
+- (NSURLSessionDataTask *)fetchMovieList:(TRBRTListType)listType withHandler:(TRBJSONResultBlock)handler;
 - (void)fetchImageAtURL:(NSString *)url withHandler:(TRBImageResultBlock)handler;
-- (void)fetchMovieInfoForID:(NSString *)movieID withHandler:(TRBJSONResultBlock)handler;
-- (void)fetchMovieReviewsForID:(NSString *)movieID page:(NSUInteger)page withHandler:(TRBJSONResultBlock)handler;
-- (void)fetchCastsInfoForID:(NSString *)movieID withHandler:(TRBJSONResultBlock)handler;
-- (void)searchWithQuery:(NSString *)query page:(NSUInteger)page andHandler:(TRBJSONResultBlock)handler;
+- (NSURLSessionDataTask *)fetchMovieInfoForID:(NSString *)movieID withHandler:(TRBJSONResultBlock)handler;
+- (NSURLSessionDataTask *)fetchMovieReviewsForID:(NSString *)movieID page:(NSUInteger)page withHandler:(TRBJSONResultBlock)handler;
+- (NSURLSessionDataTask *)fetchCastsInfoForID:(NSString *)movieID withHandler:(TRBJSONResultBlock)handler;
+- (NSURLSessionDataTask *)searchWithQuery:(NSString *)query page:(NSUInteger)page andHandler:(TRBJSONResultBlock)handler;
 
 @end
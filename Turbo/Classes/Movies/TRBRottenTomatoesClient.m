@@ -23,8 +23,15 @@
 
 #import "TRBRottenTomatoesClient.h"
 #import "TRBHTTPSession.h"
+#import "TRBJSONCache.h"
 #import "API_KEYS.h"
 
+#define LIST_MAX_AGE (6 * 3600.0)
+#define INFO_MAX_AGE 86400.0
+#define CAST_MAX_AGE (7 * 86400.0)
+#define REVIEWS_MAX_AGE 86400.0
+#define SEARCH_MAX_AGE 3600.0
+
 static NSString * const TRListEndpoints[TRBRTListTypeCount] = {
 	@"lists/movies/box_office.json",
 	@"lists/movies/in_theaters.json",
@@ -42,6 +49,7 @@ static NSString * const TRListEndpoints[TRBRTListTypeCount] = {
 	TRBHTTPJSONResponseParser * _responseParser;
 	NSString * _apiKey;
 	NSURL * _baseURL;
+	TRBJSONCache * _cache;
 }
 
 + (instancetype)sharedInstance {
@@ -62,17 +70,18 @@ static NSString * const TRListEndpoints[TRBRTListTypeCount] = {
 		_responseParser = [TRBHTTPJSONResponseParser new];
 		_baseURL = [NSURL URLWithString:@"http://api.rottentomatoes.com/api/public/v1.0/"];
 		_apiKey = RTAPIKey;
+		_cache = [TRBJSONCache cacheWithName:@"RottenTomatoes"];
 	}
 	return self;
 }
 
 #pragma mark - Public Methods
 
-- (void)fetchMovieList:(TRBRTListType)listType withHandler:(TRBJSONResultBlock)handler {
+- (NSURLSessionDataTask *)fetchMovieList:(TRBRTListType)listType withHandler:(TRBJSONResultBlock)handler {
 	NSURL * URL = [NSURL URLWithString:TRListEndpoints[listType] relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
 	NSDictionary * parameters = @{@"country": @"us", @"limit": @"50"};
-	[self sendRTRequest:request withParameters:parameters andHandler:handler];
+	return [self sendRTRequest:request withParameters:parameters maxAge:LIST_MAX_AGE andHandler:handler];
 }
 
 - (void)fetchImageAtURL:(NSString *)url withHandler:(TRBImageResultBlock)handler {
@@ -92,58 +101,75 @@ static NSString * const TRListEndpoints[TRBRTListTypeCount] = {
 	}];
 }
 
-- (void)fetchMovieInfoForID:(NSString *)movieID withHandler:(TRBJSONResultBlock)handler {
+- (NSURLSessionDataTask *)fetchMovieInfoForID:(NSString *)movieID withHandler:(TRBJSONResultBlock)handler {
 	NSString * URLString = [NSString stringWithFormat:@"movies/%@.json", movieID];
 	NSURL * URL = [NSURL URLWithString:URLString relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
-	[self sendRTRequest:request withParameters:nil andHandler:handler];
+	return [self sendRTRequest:request withParameters:nil maxAge:INFO_MAX_AGE andHandler:handler];
 }
 
-- (void)fetchCastsInfoForID:(NSString *)movieID withHandler:(TRBJSONResultBlock)handler {
+- (NSURLSessionDataTask *)fetchCastsInfoForID:(NSString *)movieID withHandler:(TRBJSONResultBlock)handler {
 	NSString * URLString = [NSString stringWithFormat:@"movies/%@/cast.json", movieID];
 	NSURL * URL = [NSURL URLWithString:URLString relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
-	[self sendRTRequest:request withParameters:nil andHandler:handler];
+	return [self sendRTRequest:request withParameters:nil maxAge:CAST_MAX_AGE andHandler:handler];
 }
 
-- (void)fetchMovieReviewsForID:(NSString *)movieID page:(NSUInteger)page withHandler:(TRBJSONResultBlock)handler {
+- (NSURLSessionDataTask *)fetchMovieReviewsForID:(NSString *)movieID page:(NSUInteger)page withHandler:(TRBJSONResultBlock)handler {
 	NSString * URLString = [NSString stringWithFormat:@"movies/%@/reviews.json", movieID];
 	NSURL * URL = [NSURL URLWithString:URLString relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
 	NSDictionary * parameters = @{@"page": [@(MAX(page, 1)) description], @"page_limit": @"50", @"review_type": @"top_critic"};
-	[self sendRTRequest:request withParameters:parameters andHandler:handler];
+	return [self sendRTRequest:request withParameters:parameters maxAge:REVIEWS_MAX_AGE andHandler:handler];
 }
 
-- (void)searchWithQuery:(NSString *)query page:(NSUInteger)page andHandler:(TRBJSONResultBlock)handler {
+- (NSURLSessionDataTask *)searchWithQuery:(NSString *)query page:(NSUInteger)page andHandler:(TRBJSONResultBlock)handler {
 	NSURL * URL = [NSURL URLWithString:@"movies.json" relativeToURL:_baseURL];
 	NSURLRequest * request = [NSURLRequest requestWithURL:URL];
 	NSDictionary * parameters = @{@"q" : query, @"page": [@(MAX(page, 1)) description], @"page_limit": @"50"};
-	[self sendRTRequest:request withParameters:parameters andHandler:handler];
+	return [self sendRTRequest:request withParameters:parameters maxAge:SEARCH_MAX_AGE andHandler:handler];
 }
 
 #pragma mark - Private Methods
 
-- (void)sendRTRequest:(NSURLRequest *)request withParameters:(NSDictionary *)parameters andHandler:(TRBJSONResultBlock)handler {
+- (NSURLSessionDataTask *)sendRTRequest:(NSURLRequest *)request withParameters:(NSDictionary *)parameters maxAge:(NSTimeInterval)maxAge andHandler:(TRBJSONResultBlock)handler {
+	NSString * cacheKey = [TRBJSONCache keyForRequest:request parameters:parameters ignoring:nil];
+	BOOL expired = YES;
+	id cached = [_cache JSONForKey:cacheKey expired:&expired];
+	if (cached && !expired) {
+		if (handler) {
+			dispatch_async(dispatch_get_main_queue(), ^{
+				handler(cached, nil);
+			});
+		}
+		return nil;
+	}
 	if (parameters) {
 		NSMutableDictionary * mParameters = [parameters mutableCopy];
 		mParameters[@"apikey"] = _apiKey;
 		parameters = [mParameters copy];
 	} else
 		parameters = @{@"apikey": _apiKey};
-	[_session startRequest:request
+	return [_session startRequest:request
 				parameters:parameters
 				   builder:_requestBuilder
 					parser:_responseParser
 				completion:^(id data, NSURLResponse *response, NSError *error) {
-					if (!error && handler) {
-						handler(data, nil);
+					if (!error && data) {
+						[_cache storeJSON:data forKey:cacheKey maxAge:[TRBJSONCache maxAgeForResponse:response defaultMaxAge:maxAge]];
+						if (handler)
+							handler(data, nil);
 					} else if (handler) {
 						if (!error) {
 							error = [NSError errorWithDomain:NSURLErrorDomain
 														code:NSURLErrorBadServerResponse
 													userInfo:@{NSLocalizedDescriptionKey: @"Unsupported Status Code"}];
 						}
-						handler(nil, error);
+						// An expired response is still better than nothing when offline.
+						if (cached && error.code != NSURLErrorCancelled && error.code != NSURLErrorBadServerResponse)
+							handler(cached, nil);
+						else
+							handler(nil, error);
 					}
 				}];
 }
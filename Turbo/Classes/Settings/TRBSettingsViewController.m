@@ -24,6 +24,7 @@
 #import "TRBSettingsViewController.h"
 #import "TRBTvDBClient.h"
 #import "TRBDataCache.h"
+#import "TRBJSONCache.h"
 
 @interface TRBSettingsViewController () <UITextFieldDelegate>
 @property (weak, nonatomic) IBOutlet UILabel * wifiRefreshRateLabel;
@@ -115,6 +116,7 @@
 
 - (IBAction)clearCacheButtonPressed:(id)sender {
 	[[TRBDataCache sharedInstance] clearCache];
+	[TRBJSONCache clearAllCaches];
 }
 
 - (IBAction)notificationsSwitchValueChanged:(UISwitch *)sender {
@@ -0,0 +1,139 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "TRBArrayDiff.h"
+
+@implementation TRBArrayDiff {
+	NSMutableIndexSet * _deletedIndexes;
+	NSMutableIndexSet * _insertedIndexes;
+	NSMutableIndexSet * _changedIndexes;
+	NSMutableArray * _movedFromIndexes;
+	NSMutableArray * _movedToIndexes;
+}
+
++ (instancetype)diffFromArray:(NSArray *)oldArray toArray:(NSArray *)newArray contentEqual:(BOOL(^)(id oldObject, id newObject))contentEqual {
+	TRBArrayDiff * diff = [self new];
+	[diff computeFromArray:oldArray toArray:newArray contentEqual:contentEqual];
+	return diff;
+}
+
+- (instancetype)init {
+	self = [super init];
+	if (self) {
+		_deletedIndexes = [NSMutableIndexSet new];
+		_insertedIndexes = [NSMutableIndexSet new];
+		_changedIndexes = [NSMutableIndexSet new];
+		_movedFromIndexes = [NSMutableArray new];
+		_movedToIndexes = [NSMutableArray new];
+	}
+	return self;
+}
+
+#pragma mark - Public Methods
+
+- (BOOL)hasChanges {
+	return [_changedIndexes count] || [self hasStructuralChanges];
+}
+
+- (BOOL)hasStructuralChanges {
+	return [_deletedIndexes count] || [_insertedIndexes count] || [_movedFromIndexes count];
+}
+
+- (void)enumerateMovesUsingBlock:(void(^)(NSUInteger fromIndex, NSUInteger toIndex))block {
+	NSUInteger count = [_movedFromIndexes count];
+	for (NSUInteger i = 0; i < count; i++)
+		block([_movedFromIndexes[i] unsignedIntegerValue], [_movedToIndexes[i] unsignedIntegerValue]);
+}
+
+#pragma mark - Private Methods
+
+- (void)computeFromArray:(NSArray *)oldArray toArray:(NSArray *)newArray contentEqual:(BOOL(^)(id oldObject, id newObject))contentEqual {
+	NSUInteger oldCount = [oldArray count];
+	NSUInteger newCount = [newArray count];
+	NSMapTable * oldIndexes = [NSMapTable strongToStrongObjectsMapTable];
+	[oldArray enumerateObjectsUsingBlock:^(id object, NSUInteger idx, BOOL * stop) {
+		[oldIndexes setObject:@(idx) forKey:object];
+	}];
+
+	// matched[k] is the old index of the k-th surviving object in new order, newIndexes[k] its new index.
+	NSUInteger * matched = malloc(sizeof(NSUInteger) * (newCount + 1));
+	NSUInteger * newIndexes = malloc(sizeof(NSUInteger) * (newCount + 1));
+	BOOL * kept = calloc(oldCount + 1, sizeof(BOOL));
+	NSUInteger matchedCount = 0;
+	for (NSUInteger j = 0; j < newCount; j++) {
+		id object = newArray[j];
+		NSNumber * oldIndex = [oldIndexes objectForKey:object];
+		if (oldIndex && !kept[[oldIndex unsignedIntegerValue]]) {
+			NSUInteger i = [oldIndex unsignedIntegerValue];
+			kept[i] = YES;
+			matched[matchedCount] = i;
+			newIndexes[matchedCount] = j;
+			matchedCount++;
+			if (contentEqual && !contentEqual(oldArray[i], object))
+				[_changedIndexes addIndex:j];
+		} else
+			[_insertedIndexes addIndex:j];
+	}
+	for (NSUInteger i = 0; i < oldCount; i++) {
+		if (!kept[i])
+			[_deletedIndexes addIndex:i];
+	}
+
+	// Objects on the longest increasing run of old indexes stay put, every other survivor is a move.
+	if (matchedCount) {
+		NSUInteger * tails = malloc(sizeof(NSUInteger) * matchedCount);
+		NSUInteger * previous = malloc(sizeof(NSUInteger) * matchedCount);
+		BOOL * stable = calloc(matchedCount, sizeof(BOOL));
+		NSUInteger length = 0;
+		for (NSUInteger k = 0; k < matchedCount; k++) {
+			NSUInteger low = 0, high = length;
+			while (low < high) {
+				NSUInteger mid = (low + high) / 2;
+				if (matched[tails[mid]] < matched[k])
+					low = mid + 1;
+				else
+					high = mid;
+			}
+			previous[k] = low > 0 ? tails[low - 1] : NSNotFound;
+			tails[low] = k;
+			if (low == length)
+				length++;
+		}
+		for (NSUInteger k = length ? tails[length - 1] : NSNotFound; k != NSNotFound; k = previous[k])
+			stable[k] = YES;
+		for (NSUInteger k = 0; k < matchedCount; k++) {
+			if (!stable[k]) {
+				[_movedFromIndexes addObject:@(matched[k])];
+				[_movedToIndexes addObject:@(newIndexes[k])];
+			}
+		}
+		free(tails);
+		free(previous);
+		free(stable);
+	}
+	free(matched);
+	free(newIndexes);
+	free(kept);
+}
+
+@end
@@ -24,6 +24,11 @@
 #import <Foundation/Foundation.h>
 
 @interface TRBAsyncOperation : NSOperation
+// The block runs on the main queue unless runsInBackground is set, it must call stop when done.
+@property (nonatomic, assign) BOOL runsInBackground;
+// Cancelled along with the operation, set it from the block once the request is started.
+@property (strong) NSURLSessionTask * task;
 + (instancetype)operationWithBlock:(void(^)(TRBAsyncOperation * op))block;
++ (instancetype)operationWithBlock:(void(^)(TRBAsyncOperation * op))block dependencies:(NSArray *)dependencies;
 - (void)stop;
 @end
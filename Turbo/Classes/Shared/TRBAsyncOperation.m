@@ -30,12 +30,20 @@
 
 @implementation TRBAsyncOperation {
 	void(^_block)(TRBAsyncOperation * op);
+	NSURLSessionTask * _task;
 }
 
 + (instancetype)operationWithBlock:(void(^)(TRBAsyncOperation * op))block {
 	return [[self alloc] initWithBlock:block];
 }
 
++ (instancetype)operationWithBlock:(void(^)(TRBAsyncOperation * op))block dependencies:(NSArray *)dependencies {
+	TRBAsyncOperation * result = [[self alloc] initWithBlock:block];
+	for (NSOperation * dependency in dependencies)
+		[result addDependency:dependency];
+	return result;
+}
+
 - (instancetype)initWithBlock:(void(^)(TRBAsyncOperation * op))block {
 	self = [super init];
 	if (self) {
@@ -47,8 +55,45 @@
 }
 
 - (void)stop {
-	self.finished = YES;
-	self.executing = NO;
+	@synchronized(self) {
+		if (!_finished) {
+			self.finished = YES;
+			self.executing = NO;
+			_block = nil;
+			_task = nil;
+		}
+	}
+}
+
+- (void)cancel {
+	NSURLSessionTask * task = nil;
+	BOOL executing = NO;
+	@synchronized(self) {
+		[super cancel];
+		task = _task;
+		executing = _executing;
+	}
+	[task cancel];
+	// The block may never hear back from a cancelled request, do not keep the queue waiting.
+	if (executing)
+		[self stop];
+}
+
+- (NSURLSessionTask *)task {
+	@synchronized(self) {
+		return _task;
+	}
+}
+
+- (void)setTask:(NSURLSessionTask *)task {
+	BOOL cancelled = NO;
+	@synchronized(self) {
+		cancelled = self.isCancelled;
+		if (!cancelled && !_finished)
+			_task = task;
+	}
+	if (cancelled)
+		[task cancel];
 }
 
 - (BOOL)isConcurrent {
@@ -72,10 +117,19 @@
 }
 
 - (void)start {
-	if (!self.isCancelled && _block) {
+	// An operation whose input was cancelled has nothing to work with.
+	BOOL dependencyCancelled = NO;
+	for (NSOperation * dependency in self.dependencies)
+		dependencyCancelled |= dependency.isCancelled;
+	void(^block)(TRBAsyncOperation * op) = _block;
+	if (!self.isCancelled && !dependencyCancelled && block) {
 		self.executing = YES;
-		dispatch_async(dispatch_get_main_queue(), ^{
-			_block(self);
+		dispatch_queue_t queue = _runsInBackground ? dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0) : dispatch_get_main_queue();
+		dispatch_async(queue, ^{
+			if (self.isCancelled)
+				[self stop];
+			else
+				block(self);
 		});
 	} else {
 		self.finished = YES;
@@ -0,0 +1,164 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+#include "TRBBase64.h"
+#include <string.h>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define TRB_BASE64_NEON 1
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define TRB_BASE64_SSSE3 1
+#endif
+
+static const char TRBBase64EncodeTable[64] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+
+#if TRB_BASE64_NEON
+
+#define TRB_BASE64_ENCODE_BLOCK 48
+#define TRB_BASE64_ENCODE_SLACK 0
+
+// 6 bit values to characters: each range of the alphabet is a fixed offset away
+// from the value, the masks pick the offset that applies.
+static inline uint8x16_t TRBBase64NEONEncodeValues(uint8x16_t values) {
+	uint8x16_t offsets = vdupq_n_u8('A');
+	offsets = vaddq_u8(offsets, vandq_u8(vcgtq_u8(values, vdupq_n_u8(25)), vdupq_n_u8(6)));
+	offsets = vaddq_u8(offsets, vandq_u8(vcgtq_u8(values, vdupq_n_u8(51)), vdupq_n_u8((uint8_t)-75)));
+	offsets = vaddq_u8(offsets, vandq_u8(vceqq_u8(values, vdupq_n_u8(62)), vdupq_n_u8((uint8_t)-15)));
+	offsets = vaddq_u8(offsets, vandq_u8(vceqq_u8(values, vdupq_n_u8(63)), vdupq_n_u8((uint8_t)-12)));
+	return vaddq_u8(values, offsets);
+}
+
+static inline void TRBBase64EncodeBlock(const uint8_t * input, char * output) {
+	uint8x16x3_t in = vld3q_u8(input);
+	uint8x16x4_t out;
+	out.val[0] = vshrq_n_u8(in.val[0], 2);
+	out.val[1] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[0], vdupq_n_u8(0x03)), 4), vshrq_n_u8(in.val[1], 4));
+	out.val[2] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[1], vdupq_n_u8(0x0F)), 2), vshrq_n_u8(in.val[2], 6));
+	out.val[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3F));
+	for (int i = 0; i < 4; i++)
+		out.val[i] = TRBBase64NEONEncodeValues(out.val[i]);
+	vst4q_u8((uint8_t *)output, out);
+}
+
+#elif TRB_BASE64_SSSE3
+
+#define TRB_BASE64_ENCODE_BLOCK 12
+#define TRB_BASE64_ENCODE_SLACK 4
+
+static inline void TRBBase64EncodeBlock(const uint8_t * input, char * output) {
+	// Loads 16 bytes for 12, the caller guarantees the extra 4 are readable.
+	__m128i in = _mm_loadu_si128((const __m128i *)input);
+	in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+	// Moves the four 6 bit fields of every 3 bytes into their own byte.
+	__m128i high = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+	__m128i low = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+	__m128i values = _mm_or_si128(high, low);
+	// Turns every value into the index of its range's offset: 0 for a-z, 1 to 10 for
+	// digits, 11 and 12 for '+' and '/', 13 for A-Z.
+	__m128i ranges = _mm_subs_epu8(values, _mm_set1_epi8(51));
+	ranges = _mm_or_si128(ranges, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+	__m128i offsets = _mm_shuffle_epi8(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0), ranges);
+	_mm_storeu_si128((__m128i *)output, _mm_add_epi8(values, offsets));
+}
+
+#endif
+
+
+// Whole groups of 3 only, no padding.
+static size_t TRBBase64EncodeGroups(const uint8_t * input, size_t length, char * output) {
+	size_t i = 0;
+	size_t j = 0;
+#ifdef TRB_BASE64_ENCODE_BLOCK
+	// The SSSE3 block reads 4 bytes past the 12 it encodes.
+	while (i + TRB_BASE64_ENCODE_BLOCK + TRB_BASE64_ENCODE_SLACK <= length) {
+		TRBBase64EncodeBlock(input + i, output + j);
+		i += TRB_BASE64_ENCODE_BLOCK;
+		j += TRB_BASE64_ENCODE_BLOCK / 3 * 4;
+	}
+#endif
+	for (; i + 3 <= length; i += 3) {
+		uint32_t group = ((uint32_t)input[i] << 16) | ((uint32_t)input[i + 1] << 8) | input[i + 2];
+		output[j++] = TRBBase64EncodeTable[(group >> 18) & 0x3F];
+		output[j++] = TRBBase64EncodeTable[(group >> 12) & 0x3F];
+		output[j++] = TRBBase64EncodeTable[(group >> 6) & 0x3F];
+		output[j++] = TRBBase64EncodeTable[group & 0x3F];
+	}
+	return j;
+}
+
+static size_t TRBBase64EncodeTail(const uint8_t * input, size_t length, char * output) {
+	size_t j = 0;
+	if (length) {
+		uint32_t group = ((uint32_t)input[0] << 16) | (length > 1 ? (uint32_t)input[1] << 8 : 0);
+		output[j++] = TRBBase64EncodeTable[(group >> 18) & 0x3F];
+		output[j++] = TRBBase64EncodeTable[(group >> 12) & 0x3F];
+		output[j++] = length > 1 ? TRBBase64EncodeTable[(group >> 6) & 0x3F] : '=';
+		output[j++] = '=';
+	}
+	return j;
+}
+
+size_t TRBBase64Encode(const uint8_t * input, size_t length, char * output) {
+	size_t whole = length - length % 3;
+	size_t j = TRBBase64EncodeGroups(input, whole, output);
+	return j + TRBBase64EncodeTail(input + whole, length - whole, output + j);
+}
+
+void TRBBase64EncoderInit(TRBBase64Encoder * encoder) {
+	encoder->pendingLength = 0;
+}
+
+size_t TRBBase64EncoderUpdate(TRBBase64Encoder * encoder, const uint8_t * input, size_t length, char * output) {
+	size_t j = 0;
+	if (encoder->pendingLength) {
+		uint8_t group[3];
+		memcpy(group, encoder->pending, encoder->pendingLength);
+		size_t needed = 3 - encoder->pendingLength;
+		if (length < needed) {
+			memcpy(encoder->pending + encoder->pendingLength, input, length);
+			encoder->pendingLength += length;
+			return 0;
+		}
+		memcpy(group + encoder->pendingLength, input, needed);
+		j = TRBBase64EncodeGroups(group, 3, output);
+		input += needed;
+		length -= needed;
+		encoder->pendingLength = 0;
+	}
+	size_t whole = length - length % 3;
+	j += TRBBase64EncodeGroups(input, whole, output + j);
+	encoder->pendingLength = length - whole;
+	memcpy(encoder->pending, input + whole, encoder->pendingLength);
+	return j;
+}
+
+size_t TRBBase64EncoderFinish(TRBBase64Encoder * encoder, char * output) {
+	size_t j = TRBBase64EncodeTail(encoder->pending, encoder->pendingLength, output);
+	encoder->pendingLength = 0;
+	return j;
+}
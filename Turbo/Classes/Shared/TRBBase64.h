@@ -0,0 +1,53 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef TRB_BASE64_H
+#define TRB_BASE64_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Standard alphabet with '=' padding and no line breaks. Whole blocks go through
+// NEON or SSSE3 when the target has them, everything else through a table.
+
+static inline size_t TRBBase64EncodedLength(size_t length) {
+	return ((length + 2) / 3) * 4;
+}
+
+// Returns the number of characters written, always TRBBase64EncodedLength(length).
+size_t TRBBase64Encode(const uint8_t * input, size_t length, char * output);
+
+// Incremental encoding for input that arrives in pieces, such as a file being
+// copied into a request body. Update writes at most TRBBase64EncodedLength(length + 2)
+// characters, Finish at most 4.
+typedef struct {
+	uint8_t pending[2];
+	size_t pendingLength;
+} TRBBase64Encoder;
+
+void TRBBase64EncoderInit(TRBBase64Encoder * encoder);
+size_t TRBBase64EncoderUpdate(TRBBase64Encoder * encoder, const uint8_t * input, size_t length, char * output);
+size_t TRBBase64EncoderFinish(TRBBase64Encoder * encoder, char * output);
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+// Decodes and encodes bencode, the format of .torrent files. Byte strings decode
+// to NSData slices that share the input's bytes instead of copying them, integers
+// to NSNumber, lists to NSArray and dictionaries to NSDictionary with NSString keys.
+@interface TRBBencode : NSObject
+
++ (id)objectWithData:(NSData *)data error:(NSError **)error;
+// Dictionary keys are written in raw byte order as the format requires, strings
+// as UTF-8. Floating point numbers can't be represented and fail the encoding.
++ (NSData *)dataWithObject:(id)object error:(NSError **)error;
+// Range of the raw encoded value stored under key in the top level dictionary of
+// data, {NSNotFound, 0} if there is none.
++ (NSRange)rangeOfValueForKey:(NSString *)key inData:(NSData *)data;
+
+@end
@@ -0,0 +1,286 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBBencode.h"
+
+#define TRBBencodeMaxDepth 64
+
+typedef struct {
+	const uint8_t * start;
+	const uint8_t * p;
+	const uint8_t * end;
+} TRBBencodeScanner;
+
+// Reads the digits up to terminator, ':' for string lengths and 'e' for integers,
+// which are the only ones allowed a sign. Leading zeros and "-0" are rejected.
+static BOOL TRBBencodeScanNumber(TRBBencodeScanner * s, uint8_t terminator, long long * value) {
+	const uint8_t * p = s->p;
+	BOOL negative = NO;
+	if (terminator == 'e' && p < s->end && *p == '-') {
+		negative = YES;
+		p++;
+	}
+	const uint8_t * digits = p;
+	unsigned long long result = 0;
+	while (p < s->end && *p >= '0' && *p <= '9') {
+		unsigned digit = *p - '0';
+		if (result > ((unsigned long long)LLONG_MAX - digit) / 10)
+			return NO;
+		result = result * 10 + digit;
+		p++;
+	}
+	size_t count = (size_t)(p - digits);
+	if (!count || p >= s->end || *p != terminator)
+		return NO;
+	if (*digits == '0' && (count > 1 || negative))
+		return NO;
+	s->p = p + 1;
+	*value = negative ? -(long long)result : (long long)result;
+	return YES;
+}
+
+static BOOL TRBBencodeScanString(TRBBencodeScanner * s, const uint8_t ** bytes, NSUInteger * length) {
+	long long count = 0;
+	if (!TRBBencodeScanNumber(s, ':', &count) || (unsigned long long)count > (unsigned long long)(s->end - s->p))
+		return NO;
+	*bytes = s->p;
+	*length = (NSUInteger)count;
+	s->p += count;
+	return YES;
+}
+
+static BOOL TRBBencodeSkipValue(TRBBencodeScanner * s) {
+	NSUInteger depth = 0;
+	long long number = 0;
+	const uint8_t * bytes = NULL;
+	NSUInteger length = 0;
+	do {
+		if (s->p >= s->end)
+			return NO;
+		uint8_t c = *s->p;
+		if (c == 'l' || c == 'd') {
+			if (++depth > TRBBencodeMaxDepth)
+				return NO;
+			s->p++;
+		} else if (c == 'e') {
+			if (!depth)
+				return NO;
+			depth--;
+			s->p++;
+		} else if (c == 'i') {
+			s->p++;
+			if (!TRBBencodeScanNumber(s, 'e', &number))
+				return NO;
+		} else if (c >= '0' && c <= '9') {
+			if (!TRBBencodeScanString(s, &bytes, &length))
+				return NO;
+		} else {
+			return NO;
+		}
+	} while (depth);
+	return YES;
+}
+
+static NSData * TRBBencodeSlice(NSData * data, const uint8_t * bytes, NSUInteger length) {
+	if (!length)
+		return [NSData data];
+	// The slice keeps the whole buffer alive instead of copying its bytes out.
+	return [[NSData alloc] initWithBytesNoCopy:(void *)bytes length:length deallocator:^(void * b, NSUInteger l) {
+		(void)data;
+	}];
+}
+
+static NSString * TRBBencodeKey(const uint8_t * bytes, NSUInteger length) {
+	NSString * result = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+	if (!result)
+		result = [[NSString alloc] initWithBytes:bytes length:length encoding:NSISOLatin1StringEncoding];
+	return result;
+}
+
+static id TRBBencodeDecodeValue(TRBBencodeScanner * s, NSData * data, NSUInteger depth) {
+	if (s->p >= s->end || depth > TRBBencodeMaxDepth)
+		return nil;
+	id result = nil;
+	uint8_t c = *s->p;
+	if (c == 'i') {
+		long long value = 0;
+		s->p++;
+		if (TRBBencodeScanNumber(s, 'e', &value))
+			result = @(value);
+	} else if (c >= '0' && c <= '9') {
+		const uint8_t * bytes = NULL;
+		NSUInteger length = 0;
+		if (TRBBencodeScanString(s, &bytes, &length))
+			result = TRBBencodeSlice(data, bytes, length);
+	} else if (c == 'l') {
+		NSMutableArray * list = [NSMutableArray new];
+		s->p++;
+		while (s->p < s->end && *s->p != 'e') {
+			id item = TRBBencodeDecodeValue(s, data, depth + 1);
+			if (!item)
+				return nil;
+			[list addObject:item];
+		}
+		if (s->p < s->end) {
+			s->p++;
+			result = list;
+		}
+	} else if (c == 'd') {
+		NSMutableDictionary * dictionary = [NSMutableDictionary new];
+		s->p++;
+		while (s->p < s->end && *s->p != 'e') {
+			const uint8_t * bytes = NULL;
+			NSUInteger length = 0;
+			if (!TRBBencodeScanString(s, &bytes, &length))
+				return nil;
+			NSString * key = TRBBencodeKey(bytes, length);
+			id value = TRBBencodeDecodeValue(s, data, depth + 1);
+			if (!key || !value)
+				return nil;
+			dictionary[key] = value;
+		}
+		if (s->p < s->end) {
+			s->p++;
+			result = dictionary;
+		}
+	}
+	return result;
+}
+
+static void TRBBencodeAppendString(NSMutableData * output, const void * bytes, NSUInteger length) {
+	char prefix[24];
+	int count = snprintf(prefix, sizeof(prefix), "%lu:", (unsigned long)length);
+	[output appendBytes:prefix length:(NSUInteger)count];
+	[output appendBytes:bytes length:length];
+}
+
+static NSData * TRBBencodeKeyData(id key) {
+	NSData * result = nil;
+	if ([key isKindOfClass:[NSString class]])
+		result = [key dataUsingEncoding:NSUTF8StringEncoding];
+	else if ([key isKindOfClass:[NSData class]])
+		result = key;
+	return result;
+}
+
+static BOOL TRBBencodeEncodeValue(id object, NSMutableData * output, NSUInteger depth) {
+	if (depth > TRBBencodeMaxDepth)
+		return NO;
+	if ([object isKindOfClass:[NSData class]]) {
+		TRBBencodeAppendString(output, [object bytes], [object length]);
+	} else if ([object isKindOfClass:[NSString class]]) {
+		NSData * string = [object dataUsingEncoding:NSUTF8StringEncoding];
+		TRBBencodeAppendString(output, [string bytes], [string length]);
+	} else if ([object isKindOfClass:[NSNumber class]]) {
+		if (CFNumberIsFloatType((__bridge CFNumberRef)object))
+			return NO;
+		char number[24];
+		int count = snprintf(number, sizeof(number), "i%llde", [object longLongValue]);
+		[output appendBytes:number length:(NSUInteger)count];
+	} else if ([object isKindOfClass:[NSArray class]]) {
+		[output appendBytes:"l" length:1];
+		for (id item in object) {
+			if (!TRBBencodeEncodeValue(item, output, depth + 1))
+				return NO;
+		}
+		[output appendBytes:"e" length:1];
+	} else if ([object isKindOfClass:[NSDictionary class]]) {
+		NSMutableArray * keys = [[NSMutableArray alloc] initWithCapacity:[object count]];
+		for (id key in object) {
+			NSData * keyData = TRBBencodeKeyData(key);
+			if (!keyData)
+				return NO;
+			[keys addObject:@[keyData, key]];
+		}
+		[keys sortUsingComparator:^NSComparisonResult(NSArray * a, NSArray * b) {
+			NSData * keyA = a[0];
+			NSData * keyB = b[0];
+			int order = memcmp([keyA bytes], [keyB bytes], MIN([keyA length], [keyB length]));
+			if (!order)
+				order = [keyA length] < [keyB length] ? -1 : ([keyA length] > [keyB length] ? 1 : 0);
+			return order < 0 ? NSOrderedAscending : (order > 0 ? NSOrderedDescending : NSOrderedSame);
+		}];
+		[output appendBytes:"d" length:1];
+		for (NSArray * pair in keys) {
+			NSData * keyData = pair[0];
+			TRBBencodeAppendString(output, [keyData bytes], [keyData length]);
+			if (!TRBBencodeEncodeValue(object[pair[1]], output, depth + 1))
+				return NO;
+		}
+		[output appendBytes:"e" length:1];
+	} else {
+		return NO;
+	}
+	return YES;
+}
+
+@implementation TRBBencode
+
+#pragma mark - Public Methods
+
++ (id)objectWithData:(NSData *)data error:(NSError **)error {
+	// Slices point into data, so it must not change underneath them.
+	data = [data copy];
+	TRBBencodeScanner scanner = {[data bytes], [data bytes], (const uint8_t *)[data bytes] + [data length]};
+	id result = TRBBencodeDecodeValue(&scanner, data, 0);
+	if (result && scanner.p != scanner.end)
+		result = nil;
+	if (!result && error) {
+		NSString * message = [NSString stringWithFormat:@"Invalid bencoded data at offset %lu", (unsigned long)(scanner.p - scanner.start)];
+		*error = [NSError errorWithDomain:NSStringFromClass(self) code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+	}
+	return result;
+}
+
++ (NSData *)dataWithObject:(id)object error:(NSError **)error {
+	NSMutableData * result = [NSMutableData new];
+	if (!TRBBencodeEncodeValue(object, result, 0)) {
+		result = nil;
+		if (error)
+			*error = [NSError errorWithDomain:NSStringFromClass(self) code:-2 userInfo:@{NSLocalizedDescriptionKey: @"Object can't be bencoded"}];
+	}
+	return result;
+}
+
++ (NSRange)rangeOfValueForKey:(NSString *)key inData:(NSData *)data {
+	NSData * keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+	TRBBencodeScanner scanner = {[data bytes], [data bytes], (const uint8_t *)[data bytes] + [data length]};
+	if (scanner.p >= scanner.end || *scanner.p != 'd')
+		return NSMakeRange(NSNotFound, 0);
+	scanner.p++;
+	while (scanner.p < scanner.end && *scanner.p != 'e') {
+		const uint8_t * bytes = NULL;
+		NSUInteger length = 0;
+		if (!TRBBencodeScanString(&scanner, &bytes, &length))
+			break;
+		const uint8_t * value = scanner.p;
+		if (!TRBBencodeSkipValue(&scanner))
+			break;
+		if (length == [keyData length] && !memcmp(bytes, [keyData bytes], length))
+			return NSMakeRange((NSUInteger)(value - scanner.start), (NSUInteger)(scanner.p - value));
+	}
+	return NSMakeRange(NSNotFound, 0);
+}
+
+@end
@@ -27,6 +27,7 @@
 
 - (void)storeData:(NSData *)data withDomain:(NSString *)domain andPath:(NSString *)path;
 - (void)lookupDataWithDomain:(NSString *)domain path:(NSString *)path andHandler:(void(^)(NSData * data, NSError * error))handler;
+- (void)removeDataWithDomain:(NSString *)domain path:(NSString *)path;
 - (void)clearCache;
 
 @end
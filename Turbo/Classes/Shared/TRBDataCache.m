@@ -62,14 +62,15 @@
 	NSRange range = [filePath rangeOfString:@"/" options:NSBackwardsSearch];
 	if (range.location != NSNotFound)
 		dir = [filePath substringToIndex:range.location];
-	BOOL isDir = NO;
-	if (![[NSFileManager defaultManager] fileExistsAtPath:dir isDirectory:&isDir] || !isDir) {
-		[[NSFileManager defaultManager] createDirectoryAtPath:dir
-								  withIntermediateDirectories:YES
-												   attributes:@{NSFilePosixPermissions: @0777}
-														error:NULL];
-	}
+	// Created on the queue so that it is ordered after any pending removal.
 	dispatch_async(_queue, ^{
+		BOOL isDir = NO;
+		if (![[NSFileManager defaultManager] fileExistsAtPath:dir isDirectory:&isDir] || !isDir) {
+			[[NSFileManager defaultManager] createDirectoryAtPath:dir
+									  withIntermediateDirectories:YES
+													   attributes:@{NSFilePosixPermissions: @0777}
+															error:NULL];
+		}
 		[data writeToFile:filePath atomically:YES];
 	});
 }
@@ -97,6 +98,13 @@
 	}
 }
 
+- (void)removeDataWithDomain:(NSString *)domain path:(NSString *)path {
+	NSString * filePath = [[_cacheDirectory stringByAppendingPathComponent:domain] stringByAppendingPathComponent:path];
+	dispatch_async(_queue, ^{
+		[[NSFileManager defaultManager] removeItemAtPath:filePath error:NULL];
+	});
+}
+
 - (void)clearCache {
 	BOOL isDir = NO;
 	if ([[NSFileManager defaultManager] fileExistsAtPath:_cacheDirectory isDirectory:&isDir] && isDir) {
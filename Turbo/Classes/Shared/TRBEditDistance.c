@@ -0,0 +1,171 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "TRBEditDistance.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TRB_MYERS_WORD_BITS 64
+#define TRB_PEQ_TABLE_SIZE 256
+#define TRB_STACK_ROW_LENGTH 512
+
+// Bit-parallel Myers (1999), the pattern must fit in a machine word.
+static size_t TRBMyersDistance(const uint16_t * pattern, size_t m, const uint16_t * text, size_t n, size_t maxDistance) {
+	// Only the entries that will be read are cleared, which is cheaper than the whole table for short words.
+	uint64_t peq[TRB_PEQ_TABLE_SIZE];
+	for (size_t j = 0; j < n; j++) {
+		if (text[j] < TRB_PEQ_TABLE_SIZE)
+			peq[text[j]] = 0;
+	}
+	for (size_t i = 0; i < m; i++) {
+		if (pattern[i] < TRB_PEQ_TABLE_SIZE)
+			peq[pattern[i]] |= (uint64_t)1 << i;
+	}
+	const uint64_t last = (uint64_t)1 << (m - 1);
+	uint64_t pv = m == TRB_MYERS_WORD_BITS ? ~(uint64_t)0 : (((uint64_t)1 << m) - 1);
+	uint64_t mv = 0;
+	size_t score = m;
+	for (size_t j = 0; j < n; j++) {
+		uint16_t c = text[j];
+		uint64_t eq = 0;
+		if (c < TRB_PEQ_TABLE_SIZE)
+			eq = peq[c];
+		else {
+			for (size_t i = 0; i < m; i++)
+				eq |= (uint64_t)(pattern[i] == c) << i;
+		}
+		uint64_t xv = eq | mv;
+		uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+		uint64_t ph = mv | ~(xh | pv);
+		uint64_t mh = pv & xh;
+		if (ph & last)
+			score++;
+		else if (mh & last)
+			score--;
+		// Each remaining text character can lower the score by at most one.
+		if (score > maxDistance && score - maxDistance > n - j - 1)
+			return maxDistance + 1;
+		ph = (ph << 1) | 1;
+		mh <<= 1;
+		pv = mh | ~(xv | ph);
+		mv = ph & xv;
+	}
+	return score;
+}
+
+static size_t * TRBScratchRows(TRBEditDistanceScratch * scratch, size_t length) {
+	if (length > scratch->capacity) {
+		size_t * rows = realloc(scratch->rows, length * sizeof(size_t));
+		if (!rows)
+			return NULL;
+		scratch->rows = rows;
+		scratch->capacity = length;
+	}
+	return scratch->rows;
+}
+
+static size_t TRBTwoRowDistance(const uint16_t * a, size_t n, const uint16_t * b, size_t m, size_t maxDistance, TRBEditDistanceScratch * scratch) {
+	size_t stackRows[2 * TRB_STACK_ROW_LENGTH];
+	size_t * rows = stackRows;
+	if (m + 1 > TRB_STACK_ROW_LENGTH) {
+		if (m > SIZE_MAX / (2 * sizeof(size_t)) - 1)
+			return SIZE_MAX;
+		rows = scratch ? TRBScratchRows(scratch, 2 * (m + 1)) : malloc(2 * (m + 1) * sizeof(size_t));
+		if (!rows)
+			return SIZE_MAX;
+	}
+	size_t * previous = rows;
+	size_t * current = rows + m + 1;
+	for (size_t j = 0; j <= m; j++)
+		previous[j] = j;
+	size_t result = 0;
+	for (size_t i = 1; i <= n; i++) {
+		current[0] = i;
+		size_t rowMinimum = i;
+		uint16_t c = a[i - 1];
+		for (size_t j = 1; j <= m; j++) {
+			size_t substitution = previous[j - 1] + (c != b[j - 1]);
+			size_t deletion = previous[j] + 1;
+			size_t insertion = current[j - 1] + 1;
+			size_t value = substitution < deletion ? substitution : deletion;
+			value = value < insertion ? value : insertion;
+			current[j] = value;
+			if (value < rowMinimum)
+				rowMinimum = value;
+		}
+		if (rowMinimum > maxDistance) {
+			result = maxDistance + 1;
+			break;
+		}
+		size_t * swap = previous;
+		previous = current;
+		current = swap;
+	}
+	if (!result)
+		result = previous[m] > maxDistance ? maxDistance + 1 : previous[m];
+	if (rows != stackRows && !scratch)
+		free(rows);
+	return result;
+}
+
+void TRBEditDistanceScratchInit(TRBEditDistanceScratch * scratch) {
+	scratch->rows = NULL;
+	scratch->capacity = 0;
+}
+
+void TRBEditDistanceScratchDestroy(TRBEditDistanceScratch * scratch) {
+	free(scratch->rows);
+	TRBEditDistanceScratchInit(scratch);
+}
+
+size_t TRBEditDistance(const uint16_t * a, size_t n, const uint16_t * b, size_t m, size_t maxDistance, TRBEditDistanceScratch * scratch) {
+	// The shorter string is the pattern.
+	if (n < m) {
+		const uint16_t * swap = a;
+		a = b;
+		b = swap;
+		size_t length = n;
+		n = m;
+		m = length;
+	}
+	if (n - m > maxDistance)
+		return maxDistance + 1;
+	if (!m)
+		return n;
+	while (m && a[0] == b[0]) {
+		a++;
+		b++;
+		n--;
+		m--;
+	}
+	while (m && a[n - 1] == b[m - 1]) {
+		n--;
+		m--;
+	}
+	if (!m)
+		return n;
+	if (m <= TRB_MYERS_WORD_BITS)
+		return TRBMyersDistance(b, m, a, n, maxDistance);
+	return TRBTwoRowDistance(a, n, b, m, maxDistance, scratch);
+}
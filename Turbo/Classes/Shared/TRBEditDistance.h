@@ -0,0 +1,46 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef TRB_EDIT_DISTANCE_H
+#define TRB_EDIT_DISTANCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Rows for patterns too long for the stack, kept across calls and only ever grown.
+typedef struct {
+	size_t * rows;
+	size_t capacity;
+} TRBEditDistanceScratch;
+
+void TRBEditDistanceScratchInit(TRBEditDistanceScratch * scratch);
+void TRBEditDistanceScratchDestroy(TRBEditDistanceScratch * scratch);
+
+// Levenshtein distance between two UTF-16 buffers. Returns maxDistance + 1 as soon as the
+// distance is known to be larger than maxDistance, pass SIZE_MAX - 1 for an unbounded result.
+// Long patterns use scratch, or memory of their own when it is NULL, and SIZE_MAX is
+// returned when it can't be allocated.
+size_t TRBEditDistance(const uint16_t * a, size_t n, const uint16_t * b, size_t m, size_t maxDistance, TRBEditDistanceScratch * scratch);
+
+#endif
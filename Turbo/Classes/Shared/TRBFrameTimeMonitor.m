@@ -0,0 +1,116 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "TRBFrameTimeMonitor.h"
+
+static CFTimeInterval const TRBTargetFrameDuration = 1.0 / 60.0;
+
+@implementation TRBFrameTimeMonitor {
+	NSString * _name;
+	CADisplayLink * _displayLink;
+	CFTimeInterval _lastTimestamp;
+	CFTimeInterval _lastReport;
+	NSUInteger _frameCount;
+	NSUInteger _slowFrameCount;
+	CFTimeInterval _worstFrame;
+	CFTimeInterval _totalFrameTime;
+	NSUInteger _updateCount;
+	CFTimeInterval _worstUpdate;
+	CFTimeInterval _totalUpdateTime;
+}
+
+- (instancetype)initWithName:(NSString *)name {
+	self = [super init];
+	if (self) {
+		_name = [name copy];
+		_reportInterval = 5.0;
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[_displayLink invalidate];
+}
+
+#pragma mark - Public Methods
+
+- (void)start {
+	if (!_displayLink) {
+		_displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayLinkFired:)];
+		[_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+		[self resetCounters];
+		_lastTimestamp = 0.0;
+		_lastReport = CACurrentMediaTime();
+	}
+}
+
+- (void)stop {
+	[_displayLink invalidate];
+	_displayLink = nil;
+}
+
+- (void)recordUpdateDuration:(CFTimeInterval)duration {
+	_updateCount++;
+	_totalUpdateTime += duration;
+	_worstUpdate = MAX(_worstUpdate, duration);
+}
+
+#pragma mark - Private Methods
+
+- (void)displayLinkFired:(CADisplayLink *)displayLink {
+	CFTimeInterval timestamp = displayLink.timestamp;
+	if (_lastTimestamp > 0.0) {
+		CFTimeInterval frame = timestamp - _lastTimestamp;
+		_frameCount++;
+		_totalFrameTime += frame;
+		_worstFrame = MAX(_worstFrame, frame);
+		if (frame > TRBTargetFrameDuration * 1.5)
+			_slowFrameCount++;
+	}
+	_lastTimestamp = timestamp;
+	if (timestamp - _lastReport >= _reportInterval) {
+		LogI(@"%@ frames: %lu slow: %lu avg: %.2fms worst: %.2fms | updates: %lu avg: %.2fms worst: %.2fms",
+			 _name,
+			 (unsigned long)_frameCount,
+			 (unsigned long)_slowFrameCount,
+			 _frameCount ? (_totalFrameTime / _frameCount) * 1000.0 : 0.0,
+			 _worstFrame * 1000.0,
+			 (unsigned long)_updateCount,
+			 _updateCount ? (_totalUpdateTime / _updateCount) * 1000.0 : 0.0,
+			 _worstUpdate * 1000.0);
+		[self resetCounters];
+		_lastReport = timestamp;
+	}
+}
+
+- (void)resetCounters {
+	_frameCount = 0;
+	_slowFrameCount = 0;
+	_worstFrame = 0.0;
+	_totalFrameTime = 0.0;
+	_updateCount = 0;
+	_worstUpdate = 0.0;
+	_totalUpdateTime = 0.0;
+}
+
+@end
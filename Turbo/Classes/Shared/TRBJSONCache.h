@@ -0,0 +1,38 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+// Persistent JSON response cache, entries expire after a per entry max age.
+@interface TRBJSONCache : NSObject
+
++ (instancetype)cacheWithName:(NSString *)name;
++ (void)clearAllCaches;
+// Cache-Control max-age when present, 0 for no-store and no-cache, defaultMaxAge otherwise.
++ (NSTimeInterval)maxAgeForResponse:(NSURLResponse *)response defaultMaxAge:(NSTimeInterval)defaultMaxAge;
++ (NSString *)keyForRequest:(NSURLRequest *)request parameters:(NSDictionary *)parameters ignoring:(NSArray *)ignoredParameters;
+
+- (id)JSONForKey:(NSString *)key expired:(BOOL *)expired;
+- (void)storeJSON:(id)json forKey:(NSString *)key maxAge:(NSTimeInterval)maxAge;
+- (void)clearCache;
+
+@end
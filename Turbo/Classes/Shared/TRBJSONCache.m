@@ -0,0 +1,167 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBJSONCache.h"
+#import <CommonCrypto/CommonDigest.h>
+
+static NSString * const TRBJSONCacheExpiresKey = @"expires";
+static NSString * const TRBJSONCacheDataKey = @"data";
+
+static NSMutableDictionary * TRBJSONCaches = nil;
+
+@implementation TRBJSONCache {
+	dispatch_queue_t _queue;
+	NSString * _cacheDirectory;
+	NSCache * _memoryCache;
+}
+
++ (instancetype)cacheWithName:(NSString *)name {
+	TRBJSONCache * result = nil;
+	@synchronized(self) {
+		if (!TRBJSONCaches)
+			TRBJSONCaches = [NSMutableDictionary dictionary];
+		result = TRBJSONCaches[name];
+		if (!result) {
+			result = [[self alloc] initWithName:name];
+			TRBJSONCaches[name] = result;
+		}
+	}
+	return result;
+}
+
++ (void)clearAllCaches {
+	NSDictionary * caches = nil;
+	@synchronized(self) {
+		caches = [TRBJSONCaches copy];
+	}
+	[[caches allValues] makeObjectsPerformSelector:@selector(clearCache)];
+	// Caches not used during this launch only exist on disk, live ones clear their own directory on their queue.
+	dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+		NSFileManager * fileManager = [NSFileManager defaultManager];
+		NSString * rootDirectory = [self rootDirectory];
+		for (NSString * name in [fileManager contentsOfDirectoryAtPath:rootDirectory error:NULL]) {
+			if (!caches[name])
+				[fileManager removeItemAtPath:[rootDirectory stringByAppendingPathComponent:name] error:NULL];
+		}
+	});
+}
+
++ (NSString *)rootDirectory {
+	return [TRBLibraryDir() stringByAppendingPathComponent:@"Caches/TRBJSONCache"];
+}
+
++ (NSTimeInterval)maxAgeForResponse:(NSURLResponse *)response defaultMaxAge:(NSTimeInterval)defaultMaxAge {
+	NSTimeInterval result = defaultMaxAge;
+	if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+		NSString * cacheControl = [((NSHTTPURLResponse *)response).allHeaderFields[@"Cache-Control"] lowercaseString];
+		for (NSString * directive in [cacheControl componentsSeparatedByString:@","]) {
+			NSString * trimmed = [directive stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+			if ([trimmed isEqualToString:@"no-store"] || [trimmed isEqualToString:@"no-cache"]) {
+				result = 0.0;
+				break;
+			} else if ([trimmed hasPrefix:@"max-age="])
+				result = [[trimmed substringFromIndex:8] doubleValue];
+		}
+	}
+	return result;
+}
+
++ (NSString *)keyForRequest:(NSURLRequest *)request parameters:(NSDictionary *)parameters ignoring:(NSArray *)ignoredParameters {
+	NSMutableString * result = [NSMutableString stringWithString:[request.URL absoluteString]];
+	NSArray * keys = [[parameters allKeys] sortedArrayUsingSelector:@selector(compare:)];
+	for (NSString * key in keys) {
+		if (![ignoredParameters containsObject:key])
+			[result appendFormat:@"&%@=%@", key, parameters[key]];
+	}
+	return result;
+}
+
+- (instancetype)initWithName:(NSString *)name {
+	self = [super init];
+	if (self) {
+		_queue = dispatch_queue_create("com.caffeineapps.TRBJSONCacheQueue", DISPATCH_QUEUE_SERIAL);
+		_memoryCache = [NSCache new];
+		_memoryCache.countLimit = 100;
+		_cacheDirectory = [[[self class] rootDirectory] stringByAppendingPathComponent:name];
+		[[NSFileManager defaultManager] createDirectoryAtPath:_cacheDirectory
+								  withIntermediateDirectories:YES
+												   attributes:nil
+														error:NULL];
+	}
+	return self;
+}
+
+#pragma mark - Public Methods
+
+- (id)JSONForKey:(NSString *)key expired:(BOOL *)expired {
+	NSDictionary * entry = [_memoryCache objectForKey:key];
+	if (!entry) {
+		NSData * data = [NSData dataWithContentsOfFile:[self pathForKey:key]];
+		entry = data ? [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:NULL] : nil;
+		if (![entry isKindOfClass:[NSDictionary class]])
+			entry = nil;
+		if (entry)
+			[_memoryCache setObject:entry forKey:key];
+	}
+	if (expired)
+		*expired = [entry[TRBJSONCacheExpiresKey] doubleValue] < [NSDate timeIntervalSinceReferenceDate];
+	return entry[TRBJSONCacheDataKey];
+}
+
+- (void)storeJSON:(id)json forKey:(NSString *)key maxAge:(NSTimeInterval)maxAge {
+	if (!json || maxAge <= 0.0)
+		return;
+	NSDictionary * entry = @{TRBJSONCacheExpiresKey: @([NSDate timeIntervalSinceReferenceDate] + maxAge), TRBJSONCacheDataKey: json};
+	[_memoryCache setObject:entry forKey:key];
+	NSString * path = [self pathForKey:key];
+	dispatch_async(_queue, ^{
+		NSData * data = [NSJSONSerialization dataWithJSONObject:entry options:kNilOptions error:NULL];
+		[data writeToFile:path atomically:YES];
+	});
+}
+
+- (void)clearCache {
+	[_memoryCache removeAllObjects];
+	dispatch_async(_queue, ^{
+		[[NSFileManager defaultManager] removeItemAtPath:_cacheDirectory error:NULL];
+		[[NSFileManager defaultManager] createDirectoryAtPath:_cacheDirectory
+								  withIntermediateDirectories:YES
+												   attributes:nil
+														error:NULL];
+	});
+}
+
+#pragma mark - Private Methods
+
+- (NSString *)pathForKey:(NSString *)key {
+	const char * string = [key UTF8String];
+	unsigned char digest[CC_MD5_DIGEST_LENGTH];
+	CC_MD5(string, (CC_LONG)strlen(string), digest);
+	NSMutableString * fileName = [NSMutableString stringWithCapacity:CC_MD5_DIGEST_LENGTH * 2];
+	for (int i = 0; i < CC_MD5_DIGEST_LENGTH; i++)
+		[fileName appendFormat:@"%02x", digest[i]];
+	return [_cacheDirectory stringByAppendingPathComponent:fileName];
+}
+
+@end
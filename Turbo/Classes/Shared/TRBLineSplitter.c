@@ -0,0 +1,126 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "TRBLineSplitter.h"
+#include <stdlib.h>
+#include <string.h>
+
+// head and tail only ever grow, masking them with capacity - 1 gives the position
+// in the buffer and tail - head the number of bytes buffered.
+
+bool TRBLineSplitterInit(TRBLineSplitter * splitter, size_t capacity) {
+	size_t size = 16;
+	while (size < capacity)
+		size <<= 1;
+	memset(splitter, 0, sizeof(TRBLineSplitter));
+	splitter->bytes = malloc(size);
+	splitter->capacity = splitter->bytes ? size : 0;
+	return splitter->bytes != NULL;
+}
+
+void TRBLineSplitterDestroy(TRBLineSplitter * splitter) {
+	free(splitter->bytes);
+	memset(splitter, 0, sizeof(TRBLineSplitter));
+}
+
+void TRBLineSplitterReset(TRBLineSplitter * splitter) {
+	splitter->head = 0;
+	splitter->tail = 0;
+	splitter->scanned = 0;
+	splitter->discarding = false;
+}
+
+uint8_t * TRBLineSplitterWritableBytes(TRBLineSplitter * splitter, size_t * length) {
+	size_t mask = splitter->capacity - 1;
+	size_t position = splitter->tail & mask;
+	size_t free = splitter->capacity - (splitter->tail - splitter->head);
+	size_t contiguous = splitter->capacity - position;
+	*length = free < contiguous ? free : contiguous;
+	return splitter->bytes + position;
+}
+
+void TRBLineSplitterDidWrite(TRBLineSplitter * splitter, size_t length) {
+	splitter->tail += length;
+}
+
+size_t TRBLineSplitterAppend(TRBLineSplitter * splitter, const uint8_t * bytes, size_t length) {
+	size_t written = 0;
+	while (written < length) {
+		size_t available = 0;
+		uint8_t * destination = TRBLineSplitterWritableBytes(splitter, &available);
+		if (!available)
+			break;
+		size_t count = length - written < available ? length - written : available;
+		memcpy(destination, bytes + written, count);
+		TRBLineSplitterDidWrite(splitter, count);
+		written += count;
+	}
+	return written;
+}
+
+static void TRBLineSplitterCopy(const TRBLineSplitter * splitter, size_t from, size_t length, uint8_t * line) {
+	size_t mask = splitter->capacity - 1;
+	size_t position = from & mask;
+	size_t first = splitter->capacity - position;
+	if (first > length)
+		first = length;
+	memcpy(line, splitter->bytes + position, first);
+	memcpy(line + first, splitter->bytes, length - first);
+}
+
+bool TRBLineSplitterNextLine(TRBLineSplitter * splitter, uint8_t * line, size_t * length) {
+	size_t mask = splitter->capacity - 1;
+	while (true) {
+		size_t end = splitter->head + splitter->scanned;
+		while (end < splitter->tail) {
+			uint8_t c = splitter->bytes[end & mask];
+			if (c == '\r' || c == '\n')
+				break;
+			end++;
+		}
+		if (end == splitter->tail) {
+			splitter->scanned = end - splitter->head;
+			if (splitter->scanned == splitter->capacity) {
+				// Full without a delimiter, the line can never fit.
+				splitter->head = splitter->tail;
+				splitter->scanned = 0;
+				splitter->discarding = true;
+			}
+			return false;
+		}
+		size_t start = splitter->head;
+		size_t count = end - start;
+		splitter->head = end + 1;
+		splitter->scanned = 0;
+		if (splitter->discarding) {
+			splitter->discarding = false;
+			continue;
+		}
+		if (!count)
+			continue;
+		TRBLineSplitterCopy(splitter, start, count, line);
+		*length = count;
+		return true;
+	}
+}
@@ -0,0 +1,58 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef TRB_LINE_SPLITTER_H
+#define TRB_LINE_SPLITTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Splits a byte stream into lines ended by CR, LF or CRLF, however the bytes are
+// split across reads. Bytes go straight into a ring buffer and empty lines are
+// skipped. A line that doesn't fit the buffer is dropped up to its delimiter.
+typedef struct {
+	uint8_t * bytes;
+	size_t capacity;
+	size_t head;
+	size_t tail;
+	size_t scanned;
+	bool discarding;
+} TRBLineSplitter;
+
+// Capacity is rounded up to a power of two.
+bool TRBLineSplitterInit(TRBLineSplitter * splitter, size_t capacity);
+void TRBLineSplitterDestroy(TRBLineSplitter * splitter);
+void TRBLineSplitterReset(TRBLineSplitter * splitter);
+
+// The contiguous free space to read into, the length is 0 when the buffer is full.
+uint8_t * TRBLineSplitterWritableBytes(TRBLineSplitter * splitter, size_t * length);
+void TRBLineSplitterDidWrite(TRBLineSplitter * splitter, size_t length);
+size_t TRBLineSplitterAppend(TRBLineSplitter * splitter, const uint8_t * bytes, size_t length);
+
+// Copies the next complete line without its delimiter into line, which must hold
+// the splitter capacity. Returns false when no complete line is buffered.
+bool TRBLineSplitterNextLine(TRBLineSplitter * splitter, uint8_t * line, size_t * length);
+
+#endif
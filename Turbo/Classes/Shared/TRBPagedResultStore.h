@@ -0,0 +1,54 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+typedef NS_ENUM(NSUInteger, TRBPageState) {
+	TRBPageStateLoading = 0,
+	TRBPageStateComplete,
+	TRBPageStateFailed,
+};
+
+// Pages of results kept in one contiguous array, pages may be of any size and
+// the page being loaded can be updated in place while its results stream in.
+@interface TRBPagedResultStore : NSObject
+
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) NSUInteger pageCount;
+@property (nonatomic, readonly, getter = isLoading) BOOL loading;
+@property (nonatomic, readonly) BOOL hasMorePages;
+// How close to the end a displayed row must be to load the next page.
+@property (nonatomic, assign) NSUInteger loadAheadCount;
+// Items with a key already present on an earlier page are dropped.
+@property (nonatomic, copy) NSString *(^keyForItem)(id item);
+
+- (id)objectAtIndex:(NSUInteger)index;
+- (id)objectAtIndexedSubscript:(NSUInteger)index;
+- (TRBPageState)stateOfPage:(NSUInteger)page;
+// Returns the page to load next, NSNotFound when loading or when there is nothing left.
+- (NSUInteger)pageToLoadForDisplayedIndex:(NSUInteger)index;
+- (NSUInteger)beginNextPage;
+- (void)setItems:(NSArray *)items forPage:(NSUInteger)page finished:(BOOL)finished;
+- (void)failPage:(NSUInteger)page;
+- (void)removeAllItems;
+
+@end
@@ -0,0 +1,144 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBPagedResultStore.h"
+
+#define DEFAULT_LOAD_AHEAD_COUNT 30
+
+@implementation TRBPagedResultStore {
+	NSMutableArray * _items;
+	NSMutableArray * _pageCounts;
+	NSMutableArray * _pageStates;
+	NSMutableSet * _keys;
+}
+
+- (instancetype)init {
+	self = [super init];
+	if (self) {
+		_items = [NSMutableArray new];
+		_pageCounts = [NSMutableArray new];
+		_pageStates = [NSMutableArray new];
+		_keys = [NSMutableSet new];
+		_loadAheadCount = DEFAULT_LOAD_AHEAD_COUNT;
+		_hasMorePages = YES;
+	}
+	return self;
+}
+
+#pragma mark - Dynamic Properties
+
+- (NSUInteger)count {
+	return [_items count];
+}
+
+- (NSUInteger)pageCount {
+	return [_pageStates count];
+}
+
+- (BOOL)isLoading {
+	return [_pageStates count] && [[_pageStates lastObject] unsignedIntegerValue] == TRBPageStateLoading;
+}
+
+#pragma mark - Public Methods
+
+- (id)objectAtIndex:(NSUInteger)index {
+	return index < [_items count] ? _items[index] : nil;
+}
+
+- (id)objectAtIndexedSubscript:(NSUInteger)index {
+	return [self objectAtIndex:index];
+}
+
+- (TRBPageState)stateOfPage:(NSUInteger)page {
+	return page < [_pageStates count] ? [_pageStates[page] unsignedIntegerValue] : TRBPageStateLoading;
+}
+
+- (NSUInteger)pageToLoadForDisplayedIndex:(NSUInteger)index {
+	NSUInteger result = NSNotFound;
+	BOOL failed = [_pageStates count] && [[_pageStates lastObject] unsignedIntegerValue] == TRBPageStateFailed;
+	if (!self.isLoading && !failed && _hasMorePages && index + _loadAheadCount >= [_items count])
+		result = [_pageStates count];
+	return result;
+}
+
+- (NSUInteger)beginNextPage {
+	NSUInteger result = [_pageStates count];
+	// A failed page is retried in place.
+	if (result && [[_pageStates lastObject] unsignedIntegerValue] == TRBPageStateFailed)
+		result--;
+	else {
+		[_pageStates addObject:@(TRBPageStateLoading)];
+		[_pageCounts addObject:@0];
+	}
+	_pageStates[result] = @(TRBPageStateLoading);
+	return result;
+}
+
+- (void)setItems:(NSArray *)items forPage:(NSUInteger)page finished:(BOOL)finished {
+	// Only the last page can still be loading, everything before it is settled.
+	if (page + 1 != [_pageStates count])
+		return;
+	// An empty page ends the results, one made only of duplicates does not.
+	BOOL empty = [items count] == 0;
+	if (_keyForItem) {
+		items = [items filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(id item, NSDictionary *bindings) {
+			NSString * key = _keyForItem(item);
+			return !key || ![_keys containsObject:key];
+		}]];
+	}
+	NSUInteger previousCount = [_pageCounts[page] unsignedIntegerValue];
+	NSRange range = NSMakeRange([_items count] - previousCount, previousCount);
+	[_items replaceObjectsInRange:range withObjectsFromArray:items];
+	_pageCounts[page] = @([items count]);
+	if (finished) {
+		_pageStates[page] = @(TRBPageStateComplete);
+		_hasMorePages = !empty;
+		if (_keyForItem) {
+			for (id item in items) {
+				NSString * key = _keyForItem(item);
+				if (key)
+					[_keys addObject:key];
+			}
+		}
+	}
+}
+
+- (void)failPage:(NSUInteger)page {
+	if (page + 1 == [_pageStates count]) {
+		NSUInteger previousCount = [_pageCounts[page] unsignedIntegerValue];
+		[_items removeObjectsInRange:NSMakeRange([_items count] - previousCount, previousCount)];
+		_pageCounts[page] = @0;
+		_pageStates[page] = @(TRBPageStateFailed);
+	}
+}
+
+- (void)removeAllItems {
+	[_items removeAllObjects];
+	[_pageCounts removeAllObjects];
+	[_pageStates removeAllObjects];
+	[_keys removeAllObjects];
+	_hasMorePages = YES;
+}
+
+@end
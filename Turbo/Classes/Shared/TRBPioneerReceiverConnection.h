@@ -0,0 +1,69 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+typedef NS_ENUM(NSUInteger, TRBPRResponseKind) {
+	TRBPRResponseKindNone = 0,		/* The command isn't answered */
+	TRBPRResponseKindPower,			/* PWR0 on, PWR1 standby */
+	TRBPRResponseKindInputSource,	/* FNxx */
+	TRBPRResponseKindError,			/* E04 unknown command, E06 bad parameter */
+	TRBPRResponseKindBusy,			/* B00 */
+	TRBPRResponseKindUnknown
+};
+
+typedef NS_ENUM(NSInteger, TRBPRErrorCode) {
+	TRBPRErrorCodeRejected = 1,
+	TRBPRErrorCodeBusy,
+	TRBPRErrorCodeTimedOut,
+	TRBPRErrorCodeNotConnected,
+	TRBPRErrorCodeConnectionLost,
+};
+
+// The CR/LF framed TCP protocol of Pioneer receivers. Streams, framing and the
+// command queue live on a private queue, handlers and completions are called on
+// the main queue. Up to pipelineDepth commands are written ahead of their answers,
+// each answer completes the oldest command waiting for that kind of response.
+// Commands sent with TRBPRResponseKindNone complete once a later answer or a
+// short window shows they weren't rejected, an error reply fails the oldest
+// command still waiting, whichever kind it is.
+@interface TRBPioneerReceiverConnection : NSObject
+
+@property (nonatomic, readonly) NSString * address;
+@property (nonatomic, readonly) UInt32 port;
+@property (nonatomic, assign) NSUInteger pipelineDepth;
+@property (nonatomic, copy) void(^openHandler)(void);
+// Every line received, answers included.
+@property (nonatomic, copy) void(^lineHandler)(NSString * line, TRBPRResponseKind kind);
+// Only called when the receiver closes the connection or it fails.
+@property (nonatomic, copy) void(^closeHandler)(NSError * error);
+
++ (TRBPRResponseKind)responseKindForLine:(NSString *)line;
+
+- (instancetype)initWithAddress:(NSString *)address port:(UInt32)port;
+
+- (void)open;
+// Must be called to release the connection, pending commands fail with TRBPRErrorCodeNotConnected.
+- (void)close;
+- (void)sendCommand:(NSString *)command response:(TRBPRResponseKind)response timeout:(NSTimeInterval)timeout completion:(void(^)(NSString * response, NSError * error))completion;
+
+@end
@@ -0,0 +1,372 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBPioneerReceiverConnection.h"
+#import "TRBLineSplitter.h"
+
+#define TRBPRMaxLineLength 512
+// How long a command without an answer can still be blamed for an error reply.
+#define TRBPRUnansweredCommandWindow 1.0
+
+static void TRBPRReadStreamCallback(CFReadStreamRef stream, CFStreamEventType type, void * info);
+static void TRBPRWriteStreamCallback(CFWriteStreamRef stream, CFStreamEventType type, void * info);
+
+@interface TRBPRCommand : NSObject
+@property (nonatomic, strong) NSData * data;
+@property (nonatomic, assign) TRBPRResponseKind response;
+@property (nonatomic, assign) NSTimeInterval timeout;
+@property (nonatomic, assign) CFAbsoluteTime deadline;
+@property (nonatomic, copy) void(^completion)(NSString * response, NSError * error);
+@end
+
+@implementation TRBPRCommand
+@end
+
+@implementation TRBPioneerReceiverConnection {
+	dispatch_queue_t _queue;
+	dispatch_source_t _timer;
+	CFReadStreamRef _readStream;
+	CFWriteStreamRef _writeStream;
+	TRBLineSplitter _splitter;
+	uint8_t _line[TRBPRMaxLineLength];
+	NSMutableData * _outgoing;
+	NSMutableArray * _queued;
+	NSMutableArray * _inFlight;
+	BOOL _open;
+}
+
++ (TRBPRResponseKind)responseKindForLine:(NSString *)line {
+	static const struct {
+		__unsafe_unretained NSString * prefix;
+		TRBPRResponseKind kind;
+	} responses[] = {
+		{@"PWR", TRBPRResponseKindPower},
+		{@"FN", TRBPRResponseKindInputSource},
+		{@"E0", TRBPRResponseKindError},
+		{@"B00", TRBPRResponseKindBusy},
+	};
+	for (size_t i = 0; i < sizeof(responses) / sizeof(responses[0]); i++) {
+		if ([line hasPrefix:responses[i].prefix])
+			return responses[i].kind;
+	}
+	return TRBPRResponseKindUnknown;
+}
+
+- (instancetype)initWithAddress:(NSString *)address port:(UInt32)port {
+	self = [super init];
+	if (self) {
+		_address = [address copy];
+		_port = port;
+		_pipelineDepth = 4;
+		_queue = dispatch_queue_create("com.caffeineapps.TRBPioneerReceiverQueue", DISPATCH_QUEUE_SERIAL);
+		_outgoing = [NSMutableData new];
+		_queued = [NSMutableArray new];
+		_inFlight = [NSMutableArray new];
+		TRBLineSplitterInit(&_splitter, TRBPRMaxLineLength);
+		_timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+		typeof(self) __weak selfWeak = self;
+		dispatch_source_set_event_handler(_timer, ^{
+			[selfWeak expireCommands];
+		});
+		dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+		dispatch_resume(_timer);
+	}
+	return self;
+}
+
+- (void)dealloc {
+	dispatch_source_cancel(_timer);
+	TRBLineSplitterDestroy(&_splitter);
+}
+
+#pragma mark - Public Methods
+
+- (void)open {
+	dispatch_async(_queue, ^{
+		[self closeWithError:nil notify:NO];
+		CFStreamCreatePairWithSocketToHost(kCFAllocatorDefault, (__bridge CFStringRef)_address, _port, &_readStream, &_writeStream);
+		if (!_readStream || !_writeStream) {
+			[self closeWithError:[self errorWithCode:TRBPRErrorCodeNotConnected description:@"Can't connect to the receiver"] notify:YES];
+			return;
+		}
+		// The streams keep the connection alive until close.
+		CFStreamClientContext context = {0, (__bridge void *)self, CFRetain, CFRelease, NULL};
+		CFOptionFlags events = kCFStreamEventErrorOccurred | kCFStreamEventEndEncountered;
+		CFReadStreamSetClient(_readStream, events | kCFStreamEventHasBytesAvailable, TRBPRReadStreamCallback, &context);
+		CFWriteStreamSetClient(_writeStream, events | kCFStreamEventOpenCompleted | kCFStreamEventCanAcceptBytes, TRBPRWriteStreamCallback, &context);
+		CFReadStreamSetDispatchQueue(_readStream, _queue);
+		CFWriteStreamSetDispatchQueue(_writeStream, _queue);
+		CFReadStreamOpen(_readStream);
+		CFWriteStreamOpen(_writeStream);
+	});
+}
+
+- (void)close {
+	dispatch_async(_queue, ^{
+		[self closeWithError:nil notify:NO];
+	});
+}
+
+- (void)sendCommand:(NSString *)command response:(TRBPRResponseKind)response timeout:(NSTimeInterval)timeout completion:(void(^)(NSString * response, NSError * error))completion {
+	TRBPRCommand * pending = [TRBPRCommand new];
+	NSMutableData * data = [[command dataUsingEncoding:NSASCIIStringEncoding allowLossyConversion:YES] mutableCopy];
+	[data appendBytes:"\r\n" length:2];
+	pending.data = data;
+	pending.response = response;
+	pending.timeout = timeout;
+	pending.completion = completion;
+	dispatch_async(_queue, ^{
+		if (!_readStream) {
+			[self completeCommands:@[pending] line:nil kind:TRBPRResponseKindNone error:[self errorWithCode:TRBPRErrorCodeNotConnected description:@"Not connected"]];
+			return;
+		}
+		[_queued addObject:pending];
+		[self sendQueuedCommands];
+	});
+}
+
+#pragma mark - Private Methods
+
+- (void)handleEvent:(CFStreamEventType)type {
+	switch (type) {
+		case kCFStreamEventOpenCompleted:
+			LogV(@"Stream opened");
+			_open = YES;
+			dispatch_async(dispatch_get_main_queue(), ^{
+				if (_openHandler)
+					_openHandler();
+			});
+			[self sendQueuedCommands];
+			break;
+		case kCFStreamEventHasBytesAvailable:
+			[self readAvailableBytes];
+			break;
+		case kCFStreamEventCanAcceptBytes:
+			[self flush];
+			break;
+		case kCFStreamEventErrorOccurred: {
+			CFErrorRef error = _readStream ? CFReadStreamCopyError(_readStream) : NULL;
+			LogE(@"Stream error occurred");
+			[self closeWithError:(error ? CFBridgingRelease(error) : [self errorWithCode:TRBPRErrorCodeConnectionLost description:@"Connection lost"]) notify:YES];
+			break;
+		} case kCFStreamEventEndEncountered:
+			LogV(@"Stream end encountered");
+			[self closeWithError:[self errorWithCode:TRBPRErrorCodeConnectionLost description:@"Connection closed by the receiver"] notify:YES];
+			break;
+		default:
+			break;
+	}
+}
+
+- (void)readAvailableBytes {
+	while (_readStream && CFReadStreamHasBytesAvailable(_readStream)) {
+		size_t length = 0;
+		uint8_t * bytes = TRBLineSplitterWritableBytes(&_splitter, &length);
+		if (!length) {
+			[self processLines];
+			bytes = TRBLineSplitterWritableBytes(&_splitter, &length);
+		}
+		CFIndex count = CFReadStreamRead(_readStream, bytes, (CFIndex)length);
+		if (count <= 0)
+			break;
+		TRBLineSplitterDidWrite(&_splitter, (size_t)count);
+		[self processLines];
+	}
+}
+
+- (void)processLines {
+	size_t length = 0;
+	while (TRBLineSplitterNextLine(&_splitter, _line, &length)) {
+		NSString * line = [[NSString alloc] initWithBytes:_line length:length encoding:NSASCIIStringEncoding];
+		if (line)
+			[self handleLine:line];
+	}
+}
+
+- (void)handleLine:(NSString *)line {
+	TRBPRResponseKind kind = [[self class] responseKindForLine:line];
+	TRBPRCommand * command = nil;
+	NSError * error = nil;
+	NSArray * settled = nil;
+	if (kind == TRBPRResponseKindError || kind == TRBPRResponseKindBusy) {
+		// Answers come in order, so the error belongs to the oldest command still
+		// waiting, which can be one that is otherwise never answered.
+		command = [_inFlight firstObject];
+		if (kind == TRBPRResponseKindError)
+			error = [self errorWithCode:TRBPRErrorCodeRejected description:[NSString stringWithFormat:@"Command rejected (%@)", line]];
+		else
+			error = [self errorWithCode:TRBPRErrorCodeBusy description:@"Receiver busy"];
+	} else {
+		NSUInteger index = [_inFlight indexOfObjectPassingTest:^BOOL(TRBPRCommand * candidate, NSUInteger idx, BOOL * stop) {
+			return candidate.response == kind;
+		}];
+		if (index != NSNotFound) {
+			command = _inFlight[index];
+			// Unanswered commands written before it didn't fail, or their error would
+			// have come first.
+			settled = [self unansweredCommandsInRange:NSMakeRange(0, index)];
+			[_inFlight removeObjectsInArray:settled];
+		}
+	}
+	if (command)
+		[_inFlight removeObjectIdenticalTo:command];
+	if ([settled count])
+		[self completeCommands:settled line:nil kind:TRBPRResponseKindNone error:nil];
+	[self completeCommands:(command ? @[command] : @[]) line:line kind:kind error:error];
+	[self rearmTimer];
+	[self sendQueuedCommands];
+}
+
+// Delivers the line before the completions so state derived from it is up to date.
+- (void)completeCommands:(NSArray *)commands line:(NSString *)line kind:(TRBPRResponseKind)kind error:(NSError *)error {
+	dispatch_async(dispatch_get_main_queue(), ^{
+		if (line && _lineHandler)
+			_lineHandler(line, kind);
+		for (TRBPRCommand * command in commands) {
+			if (command.completion)
+				command.completion(error ? nil : line, error);
+		}
+	});
+}
+
+- (NSArray *)unansweredCommandsInRange:(NSRange)range {
+	NSIndexSet * indexes = [_inFlight indexesOfObjectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:range] options:0 passingTest:^BOOL(TRBPRCommand * command, NSUInteger idx, BOOL * stop) {
+		return command.response == TRBPRResponseKindNone;
+	}];
+	return [_inFlight objectsAtIndexes:indexes];
+}
+
+- (void)sendQueuedCommands {
+	if (!_open)
+		return;
+	CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+	// Unanswered commands don't hold a pipeline slot, they only wait in _inFlight
+	// for an error reply.
+	NSUInteger answered = [_inFlight count] - [[self unansweredCommandsInRange:NSMakeRange(0, [_inFlight count])] count];
+	while ([_queued count] && answered < MAX(_pipelineDepth, (NSUInteger)1)) {
+		TRBPRCommand * command = _queued[0];
+		[_queued removeObjectAtIndex:0];
+		[_outgoing appendData:command.data];
+		if (command.response == TRBPRResponseKindNone) {
+			command.deadline = now + MAX(command.timeout, TRBPRUnansweredCommandWindow);
+		} else {
+			command.deadline = now + command.timeout;
+			answered++;
+		}
+		[_inFlight addObject:command];
+	}
+	[self flush];
+	[self rearmTimer];
+}
+
+// Partial writes keep the rest for the next kCFStreamEventCanAcceptBytes.
+- (void)flush {
+	while ([_outgoing length] && _writeStream && CFWriteStreamCanAcceptBytes(_writeStream)) {
+		CFIndex written = CFWriteStreamWrite(_writeStream, [_outgoing bytes], (CFIndex)[_outgoing length]);
+		if (written <= 0)
+			break;
+		[_outgoing replaceBytesInRange:NSMakeRange(0, (NSUInteger)written) withBytes:NULL length:0];
+	}
+}
+
+- (void)rearmTimer {
+	CFAbsoluteTime deadline = 0.0;
+	for (TRBPRCommand * command in _inFlight) {
+		if (deadline == 0.0 || command.deadline < deadline)
+			deadline = command.deadline;
+	}
+	if (deadline == 0.0) {
+		dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+	} else {
+		double delay = MAX(deadline - CFAbsoluteTimeGetCurrent(), 0.0);
+		dispatch_source_set_timer(_timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), DISPATCH_TIME_FOREVER, 10 * NSEC_PER_MSEC);
+	}
+}
+
+- (void)expireCommands {
+	CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+	NSMutableArray * expired = [NSMutableArray new];
+	NSMutableArray * accepted = [NSMutableArray new];
+	for (TRBPRCommand * command in _inFlight) {
+		if (command.deadline <= now)
+			[(command.response == TRBPRResponseKindNone ? accepted : expired) addObject:command];
+	}
+	if ([accepted count]) {
+		[_inFlight removeObjectsInArray:accepted];
+		[self completeCommands:accepted line:nil kind:TRBPRResponseKindNone error:nil];
+	}
+	if ([expired count]) {
+		[_inFlight removeObjectsInArray:expired];
+		[self completeCommands:expired line:nil kind:TRBPRResponseKindNone error:[self errorWithCode:TRBPRErrorCodeTimedOut description:@"The receiver didn't answer"]];
+	}
+	[self rearmTimer];
+	[self sendQueuedCommands];
+}
+
+// Also notifies when the streams were never created, so a failed open is reported.
+- (void)closeWithError:(NSError *)error notify:(BOOL)notify {
+	if (_readStream) {
+		CFReadStreamSetClient(_readStream, kCFStreamEventNone, NULL, NULL);
+		CFReadStreamSetDispatchQueue(_readStream, NULL);
+		CFReadStreamClose(_readStream);
+		CFRelease(_readStream);
+		_readStream = NULL;
+	}
+	if (_writeStream) {
+		CFWriteStreamSetClient(_writeStream, kCFStreamEventNone, NULL, NULL);
+		CFWriteStreamSetDispatchQueue(_writeStream, NULL);
+		CFWriteStreamClose(_writeStream);
+		CFRelease(_writeStream);
+		_writeStream = NULL;
+	}
+	_open = NO;
+	TRBLineSplitterReset(&_splitter);
+	[_outgoing setLength:0];
+	NSArray * pending = [_inFlight arrayByAddingObjectsFromArray:_queued];
+	[_inFlight removeAllObjects];
+	[_queued removeAllObjects];
+	[self rearmTimer];
+	if ([pending count])
+		[self completeCommands:pending line:nil kind:TRBPRResponseKindNone error:(error ?: [self errorWithCode:TRBPRErrorCodeNotConnected description:@"Disconnected"])];
+	if (notify) {
+		dispatch_async(dispatch_get_main_queue(), ^{
+			if (_closeHandler)
+				_closeHandler(error);
+		});
+	}
+}
+
+- (NSError *)errorWithCode:(TRBPRErrorCode)code description:(NSString *)description {
+	return [NSError errorWithDomain:NSStringFromClass([self class]) code:code userInfo:@{NSLocalizedDescriptionKey: description}];
+}
+
+@end
+
+static void TRBPRReadStreamCallback(CFReadStreamRef stream, CFStreamEventType type, void * info) {
+	[(__bridge TRBPioneerReceiverConnection *)info handleEvent:type];
+}
+
+static void TRBPRWriteStreamCallback(CFWriteStreamRef stream, CFStreamEventType type, void * info) {
+	[(__bridge TRBPioneerReceiverConnection *)info handleEvent:type];
+}
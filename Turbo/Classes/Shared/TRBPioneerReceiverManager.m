@@ -22,57 +22,67 @@
  */
 
 #import "TRBPioneerReceiverManager.h"
-
-static NSString * const InputSources[TRBPRInputSourceUnknown] = {
-	@"04",
-	@"25",
-	@"06",
-	@"15",
-	@"10",
-	@"14",
-	@"19",
-	@"20",
-	@"21",
-	@"22",
-	@"23",
-	@"26",
-	@"17",
-	@"18",
-	@"01",
-	@"03",
-	@"02",
-	@"00",
-	@"12",
-	@"33",
-	@"27",
-	@"31",
+#import "TRBPioneerReceiverConnection.h"
+
+static const uint8_t TRBPRInputSourceCodes[TRBPRInputSourceUnknown] = {
+	[TRBPRInputSourceDVD] = 4,
+	[TRBPRInputSourceBD] = 25,
+	[TRBPRInputSourceTVSAT] = 6,
+	[TRBPRInputSourceDVRBDR] = 15,
+	[TRBPRInputSourceVideo1] = 10,
+	[TRBPRInputSourceVideo2] = 14,
+	[TRBPRInputSourceHDMI1] = 19,
+	[TRBPRInputSourceHDMI2] = 20,
+	[TRBPRInputSourceHDMI3] = 21,
+	[TRBPRInputSourceHDMI4] = 22,
+	[TRBPRInputSourceHDMI5] = 23,
+	[TRBPRInputSourceHomeMedia] = 26,
+	[TRBPRInputSourceUSBiPod] = 17,
+	[TRBPRInputSourceXMRadio] = 18,
+	[TRBPRInputSourceCD] = 1,
+	[TRBPRInputSourceCDRTape] = 3,
+	[TRBPRInputSourceTuner] = 2,
+	[TRBPRInputSourcePhono] = 0,
+	[TRBPRInputSourceMultiChIn] = 12,
+	[TRBPRInputSourceAdapterPort] = 33,
+	[TRBPRInputSourceSirius] = 27,
+	[TRBPRInputSourceHDMICyclic] = 31,
 };
 
-static NSString * const PowerSymbol = @"PWR";
-static NSString * const InputSourceSymbol = @"FN";
+typedef NS_ENUM(NSUInteger, TRBPRCommandType) {
+	TRBPRCommandPowerOn = 0,
+	TRBPRCommandPowerOff,
+	TRBPRCommandQueryPower,
+	TRBPRCommandQueryInputSource,
+	TRBPRCommandSelectInputSource,
 
-@interface TRBPioneerReceiverManager ()<NSStreamDelegate>
+	TRBPRCommandCount
+};
 
-@end
+static const struct {
+	const char * format;
+	TRBPRResponseKind response;
+	NSTimeInterval timeout;
+} TRBPRCommands[TRBPRCommandCount] = {
+	// Powering on answers once the receiver is out of standby.
+	[TRBPRCommandPowerOn] = {"PO", TRBPRResponseKindPower, 10.0},
+	[TRBPRCommandPowerOff] = {"PF", TRBPRResponseKindPower, 5.0},
+	[TRBPRCommandQueryPower] = {"?P", TRBPRResponseKindPower, 3.0},
+	[TRBPRCommandQueryInputSource] = {"?F", TRBPRResponseKindInputSource, 3.0},
+	[TRBPRCommandSelectInputSource] = {"%02uFN", TRBPRResponseKindInputSource, 3.0},
+};
 
-@implementation TRBPioneerReceiverManager {
-	NSInputStream * _inputStream;
-	NSOutputStream * _outputStream;
+static TRBPRInputSource TRBPRInputSourceForCode(NSInteger code) {
+	for (TRBPRInputSource input = 0; input < TRBPRInputSourceUnknown; input++) {
+		if (TRBPRInputSourceCodes[input] == code)
+			return input;
+	}
+	return TRBPRInputSourceUnknown;
+}
 
-	NSMutableArray * _pending;
-	void(^_onOpen)(void);
+@implementation TRBPioneerReceiverManager {
+	TRBPioneerReceiverConnection * _connection;
 	void(^_inputHandler)(NSString * response);
-	void(^_onPowerOn)(void);
-	void(^_onPowerOff)(void);
-	void(^_onInputSourceChanged)(void);
-
-	TRBPRInputSource _expectedInputSource;
-
-	BOOL _sending;
-
-	NSData * _endCommand;
-	NSDictionary * _powerStateMapping;
-	NSDictionary * _inputSourceMapping;
 }
 
 + (instancetype)sharedInstance {
@@ -87,35 +97,8 @@ static NSString * const InputSourceSymbol = @"FN";
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _pending = [NSMutableArray new];
-		_endCommand = [NSData dataWithBytes:"\r\n" length:2];
 		_powerState = TRBPRPowerStateUnknown;
 		_inputSource = TRBPRInputSourceUnknown;
-		_expectedInputSource = TRBPRInputSourceUnknown;
-		_powerStateMapping = @{@"PWR0": @(TRBPRPowerStateOn),
-							   @"PWR1": @(TRBPRPowerStateOff)};
-		_inputSourceMapping = @{InputSources[TRBPRInputSourceDVD]: @(TRBPRInputSourceDVD),
-								InputSources[TRBPRInputSourceBD]: @(TRBPRInputSourceBD),
-								InputSources[TRBPRInputSourceTVSAT]: @(TRBPRInputSourceTVSAT),
-								InputSources[TRBPRInputSourceDVRBDR]: @(TRBPRInputSourceDVRBDR),
-								InputSources[TRBPRInputSourceVideo1]: @(TRBPRInputSourceVideo1),
-								InputSources[TRBPRInputSourceVideo2]: @(TRBPRInputSourceVideo2),
-								InputSources[TRBPRInputSourceHDMI1]: @(TRBPRInputSourceHDMI1),
-								InputSources[TRBPRInputSourceHDMI2]: @(TRBPRInputSourceHDMI2),
-								InputSources[TRBPRInputSourceHDMI3]: @(TRBPRInputSourceHDMI3),
-								InputSources[TRBPRInputSourceHDMI4]: @(TRBPRInputSourceHDMI4),
-								InputSources[TRBPRInputSourceHDMI5]: @(TRBPRInputSourceHDMI5),
-								InputSources[TRBPRInputSourceHomeMedia]: @(TRBPRInputSourceHomeMedia),
-								InputSources[TRBPRInputSourceUSBiPod]: @(TRBPRInputSourceUSBiPod),
-								InputSources[TRBPRInputSourceXMRadio]: @(TRBPRInputSourceXMRadio),
-								InputSources[TRBPRInputSourceCD]: @(TRBPRInputSourceCD),
-								InputSources[TRBPRInputSourceCDRTape]: @(TRBPRInputSourceCDRTape),
-								InputSources[TRBPRInputSourceTuner]: @(TRBPRInputSourceTuner),
-								InputSources[TRBPRInputSourcePhono]: @(TRBPRInputSourcePhono),
-								InputSources[TRBPRInputSourceMultiChIn]: @(TRBPRInputSourceMultiChIn),
-								InputSources[TRBPRInputSourceAdapterPort]: @(TRBPRInputSourceAdapterPort),
-								InputSources[TRBPRInputSourceSirius]: @(TRBPRInputSourceSirius),
-								InputSources[TRBPRInputSourceHDMICyclic]: @(TRBPRInputSourceHDMICyclic)};
     }
     return self;
 }
@@ -123,200 +106,108 @@ static NSString * const InputSourceSymbol = @"FN";
 #pragma mark - Public Methods
 
 - (void)connectToAddress:(NSString *)address port:(UInt32)port inputHandler:(void(^)(NSString *))inputHandler onOpen:(void(^)(void))onOpen {
-	if (_inputStream || _outputStream)
+	if (_connection)
 		[self disconnect];
-	_onOpen = [onOpen copy];
 	_inputHandler = [inputHandler copy];
-	CFReadStreamRef readStream;
-	CFWriteStreamRef writeStream;
-	CFStreamCreatePairWithSocketToHost(NULL, (__bridge CFStringRef)address, port, &readStream, &writeStream);
-	_inputStream = (NSInputStream *)CFBridgingRelease(readStream);
-	_outputStream = (NSOutputStream *)CFBridgingRelease(writeStream);
-	_inputStream.delegate = self;
-	_outputStream.delegate = self;
-	[_inputStream scheduleInRunLoop:[NSRunLoop currentRunLoop] forMode:NSDefaultRunLoopMode];
-	[_outputStream scheduleInRunLoop:[NSRunLoop currentRunLoop] forMode:NSDefaultRunLoopMode];
-	[_inputStream open];
-	[_outputStream open];
+	TRBPioneerReceiverConnection * connection = [[TRBPioneerReceiverConnection alloc] initWithAddress:address port:port];
+	typeof(self) __weak selfWeak = self;
+	typeof(connection) __weak connectionWeak = connection;
+	connection.lineHandler = ^(NSString * line, TRBPRResponseKind kind) {
+		[selfWeak processLine:line kind:kind];
+	};
+	connection.closeHandler = ^(NSError * error) {
+		LogE(@"Receiver connection closed: %@", error);
+		typeof(self) __strong selfStrong = selfWeak;
+		if (selfStrong && selfStrong->_connection == connectionWeak)
+			[selfStrong disconnect];
+	};
+	connection.openHandler = ^{
+		typeof(self) __strong selfStrong = selfWeak;
+		if (!selfStrong || selfStrong->_connection != connectionWeak)
+			return;
+		selfStrong->_isConnected = YES;
+		[selfStrong sendCommand:TRBPRCommandQueryPower code:0 completion:^(NSString * response, NSError * error) {
+			typeof(self) __strong selfStrong = selfWeak;
+			if (!selfStrong || selfStrong->_connection != connectionWeak)
+				return;
+			[selfStrong sendCommand:TRBPRCommandQueryInputSource code:0 completion:nil];
+			if (onOpen)
+				onOpen();
+		}];
+	};
+	_connection = connection;
+	[_connection open];
 }
 
 - (void)disconnect {
-	if (_inputStream && _outputStream) {
-		_sending = NO;
+	if (_connection) {
+		[_connection close];
+		_connection = nil;
 		_isConnected = NO;
-		[_inputStream close];
-		[_inputStream removeFromRunLoop:[NSRunLoop currentRunLoop] forMode:NSDefaultRunLoopMode];
-		_inputStream = nil;
-		[_outputStream close];
-		[_outputStream removeFromRunLoop:[NSRunLoop currentRunLoop] forMode:NSDefaultRunLoopMode];
-		_outputStream = nil;
-		_onOpen = nil;
-		_onPowerOff = nil;
-		_onPowerOn = nil;
-		_onInputSourceChanged = nil;
 		_powerState = TRBPRPowerStateUnknown;
 		_inputSource = TRBPRInputSourceUnknown;
-		_expectedInputSource = TRBPRInputSourceUnknown;
 	}
 }
 
 - (void)powerOn:(void(^)(void))completion {
 	if (_powerState != TRBPRPowerStateOn) {
-		_onPowerOn = [completion copy];
-		[self sendCommand:@"PO"];
+		[self sendCommand:TRBPRCommandPowerOn code:0 completion:^(NSString * response, NSError * error) {
+			if (completion && _powerState == TRBPRPowerStateOn)
+				completion();
+		}];
 	} else if (completion)
 		completion();
 }
 
 - (void)powerOff:(void(^)(void))completion {
 	if (_powerState != TRBPRPowerStateOff) {
-		_onPowerOff = [completion copy];
-		[self sendCommand:@"PF"];
+		[self sendCommand:TRBPRCommandPowerOff code:0 completion:^(NSString * response, NSError * error) {
+			if (completion && _powerState == TRBPRPowerStateOff)
+				completion();
+		}];
 	} else if (completion)
 		completion();
 }
 
 - (void)changeToInput:(TRBPRInputSource)input completion:(void(^)(void))completion {
 	if (input != _inputSource && input < TRBPRInputSourceUnknown) {
-		_expectedInputSource = input;
-		_onInputSourceChanged = [completion copy];
-		NSString * inputSource = InputSources[input];
-		NSString * command = [inputSource stringByAppendingString:InputSourceSymbol];
-		[self sendCommand:command];
+		[self sendCommand:TRBPRCommandSelectInputSource code:TRBPRInputSourceCodes[input] completion:^(NSString * response, NSError * error) {
+			if (completion && _inputSource == input)
+				completion();
+		}];
 	} else if (completion && input == _inputSource)
 		completion();
 }
 
 - (void)sendCommand:(NSString *)command {
-	NSMutableData * data = [NSMutableData new];
-	[data appendData:[command dataUsingEncoding:NSUTF8StringEncoding]];
-	[data appendData:_endCommand];
 	LogW(@"Sending Command: %@", command);
-	[self sendData:data];
-}
-
-#pragma mark - NSStreamDelegate
-
-- (void)stream:(NSStream *)stream handleEvent:(NSStreamEvent)streamEvent {
-	switch (streamEvent) {
-		case NSStreamEventOpenCompleted: {
-			LogV(@"Stream opened");
-			if (stream == _outputStream) {
-				_isConnected = YES;
-				if (_powerState == TRBPRPowerStateUnknown)
-					[self sendCommand:@"?P"];
-			}
-			break;
-		} case NSStreamEventHasBytesAvailable: {
-			LogV(@"Stream has bytes available");
-			[self processHasBytesAvailable];
-			break;
-		} case NSStreamEventHasSpaceAvailable: {
-			LogV(@"Stream has space available");
-			[self processHasSpaceAvailable];
-			break;
-		} case NSStreamEventErrorOccurred: {
-			LogV(@"Stream error occurred");
-			[self disconnect];
-			break;
-		} case NSStreamEventEndEncountered: {
-			LogV(@"Stream end encountered");
-			[self disconnect];
-			break;
-		} default: {
-			LogV(@"Unknown event");
-			break;
-		}
-	}
+	[_connection sendCommand:command response:TRBPRResponseKindNone timeout:0.0 completion:nil];
 }
 
 #pragma mark - Private Methods
 
-- (void)processHasBytesAvailable {
-	static uint8_t buffer[1024];
-	NSInteger i = [_inputStream read:buffer maxLength:1024];
-	NSString * response = nil;
-	if (i > 0)
-		response = [[NSString alloc] initWithBytes:buffer length:i encoding:NSUTF8StringEncoding];
-	response = [response stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-	LogW(@"Read: %@", response);
-	if ([response length]) {
-		dispatch_async(dispatch_get_main_queue(), ^{
-			if ([response hasPrefix:PowerSymbol])
-				[self processPowerResponse:response];
-			else if ([response hasPrefix:InputSourceSymbol])
-				[self processInputSourceResponse:response];
-			if (_onOpen && _powerState != TRBPRPowerStateUnknown/* && _inputSource != TRBPRInputSourceUnknown*/) {
-				[self sendCommand:@"?F"];
-				_onOpen();
-				_onOpen = nil;
-			}
-			if (_inputHandler)
-				_inputHandler(response);
-			[self sendNext];
-		});
-	}
-}
-
-- (void)processPowerResponse:(NSString *)response {
-	TRBPRPowerState oldState = _powerState;
-	_powerState = [_powerStateMapping[response] unsignedIntegerValue];
-	if (_onPowerOn && oldState != TRBPRPowerStateOn && _powerState == TRBPRPowerStateOn) {
-		_onPowerOn();
-		_onPowerOn = nil;
-	} else if (oldState != TRBPRPowerStateOff && _powerState == TRBPRPowerStateOff) {
-		[_pending removeAllObjects];
-		_onInputSourceChanged = nil;
-		_onPowerOn = nil;
-		_inputSource = TRBPRInputSourceUnknown;
-		_expectedInputSource = TRBPRInputSourceUnknown;
-		if (_onPowerOff) {
-			_onPowerOff();
-			_onPowerOff = nil;
-		}
-	}
-}
-
-- (void)processInputSourceResponse:(NSString *)response {
-	NSString * inputSource = [response stringByReplacingCharactersInRange:NSMakeRange(0, [InputSourceSymbol length]) withString:@""];
-	_inputSource = [_inputSourceMapping[inputSource] unsignedIntegerValue];
-	if (_onInputSourceChanged && _expectedInputSource == _inputSource) {
-		_onInputSourceChanged();
-		_onInputSourceChanged = nil;
+- (void)sendCommand:(TRBPRCommandType)type code:(unsigned)code completion:(void(^)(NSString * response, NSError * error))completion {
+	NSString * format = @(TRBPRCommands[type].format);
+	NSString * command = [NSString stringWithFormat:format, code];
+	LogW(@"Sending Command: %@", command);
+	[_connection sendCommand:command response:TRBPRCommands[type].response timeout:TRBPRCommands[type].timeout completion:^(NSString * response, NSError * error) {
+		LogCV(error != nil, @"Command %@ failed: %@", command, error);
+		if (completion)
+			completion(response, error);
+	}];
+}
+
+- (void)processLine:(NSString *)line kind:(TRBPRResponseKind)kind {
+	LogW(@"Read: %@", line);
+	if (kind == TRBPRResponseKindPower && [line length] > 3) {
+		_powerState = [line characterAtIndex:3] == '0' ? TRBPRPowerStateOn : TRBPRPowerStateOff;
+		if (_powerState == TRBPRPowerStateOff)
+			_inputSource = TRBPRInputSourceUnknown;
+	} else if (kind == TRBPRResponseKindInputSource) {
+		_inputSource = TRBPRInputSourceForCode([[line substringFromIndex:2] integerValue]);
 	}
-}
-
-- (void)processHasSpaceAvailable {
-	dispatch_async(dispatch_get_main_queue(), ^{
-		if ([_pending count] && !_sending) {
-			void(^pending)(void) = (void(^)(void))_pending[0];
-			pending();
-			[_pending removeObjectAtIndex:0];
-		}
-	});
-}
-
-- (void)sendData:(NSData *)data {
-	dispatch_async(dispatch_get_main_queue(), ^{
-		void(^pending)(void) = ^{
-			_sending = YES;
-			NSInteger bytesWritten = [_outputStream write:[data bytes] maxLength:[data length]];
-			LogCV(bytesWritten != [data length], @"%i / %i bytes written", bytesWritten, [data length]);
-		};
-		if ([_outputStream hasSpaceAvailable] && !_sending) {
-			pending();
-		} else
-			[_pending addObject:[pending copy]];
-	});
-}
-
-- (void)sendNext {
-    _sending = [_pending count] > 0 && [_outputStream hasSpaceAvailable];
-    if (_sending) {
-        void(^pending)(void) = (void(^)(void))_pending[0];
-        pending();
-        [_pending removeObjectAtIndex:0];
-    }
+	if (_inputHandler)
+		_inputHandler(line);
 }
 
 @end
@@ -0,0 +1,210 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBSearchIndex.h"
+
+static NSCharacterSet * TRBTokenSeparators = nil;
+
+@implementation TRBSearchIndex {
+	dispatch_queue_t _queue;
+	NSMutableArray * _documents;
+	NSMutableDictionary * _ordinals;
+	NSMutableDictionary * _documentTokens;
+	NSMutableDictionary * _documentTexts;
+	NSMutableDictionary * _postings;
+	NSMutableArray * _sortedTokens;
+	NSMutableIndexSet * _freeOrdinals;
+}
+
++ (void)initialize {
+	TRBTokenSeparators = [[NSCharacterSet alphanumericCharacterSet] invertedSet];
+}
+
++ (NSArray *)tokensForString:(NSString *)string {
+	NSString * folded = [string stringByFoldingWithOptions:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch | NSWidthInsensitiveSearch
+													locale:nil];
+	NSMutableOrderedSet * tokens = [NSMutableOrderedSet orderedSet];
+	for (NSString * token in [folded componentsSeparatedByCharactersInSet:TRBTokenSeparators]) {
+		if ([token length])
+			[tokens addObject:token];
+	}
+	return [tokens array];
+}
+
+- (instancetype)init {
+	self = [super init];
+	if (self) {
+		_queue = dispatch_queue_create("com.caffeineapps.TRBSearchIndexQueue", DISPATCH_QUEUE_SERIAL);
+		_documents = [NSMutableArray array];
+		_ordinals = [NSMutableDictionary dictionary];
+		_documentTokens = [NSMutableDictionary dictionary];
+		_documentTexts = [NSMutableDictionary dictionary];
+		_postings = [NSMutableDictionary dictionary];
+		_sortedTokens = [NSMutableArray array];
+		_freeOrdinals = [NSMutableIndexSet indexSet];
+	}
+	return self;
+}
+
+#pragma mark - Public Methods
+
+- (NSUInteger)documentCount {
+	__block NSUInteger result = 0;
+	dispatch_sync(_queue, ^{
+		result = [_ordinals count];
+	});
+	return result;
+}
+
+- (void)setText:(NSString *)text forDocument:(id<NSCopying>)document {
+	text = text ?: @"";
+	dispatch_sync(_queue, ^{
+		NSNumber * ordinal = _ordinals[document];
+		// Saves touching only unrelated attributes come back with the same text, skip tokenizing it.
+		if (ordinal && [_documentTexts[ordinal] isEqualToString:text])
+			return;
+		NSArray * tokens = [[self class] tokensForString:text];
+		NSArray * oldTokens = ordinal ? _documentTokens[ordinal] : nil;
+		if ([oldTokens isEqualToArray:tokens]) {
+			_documentTexts[ordinal] = [text copy];
+			return;
+		}
+		if (ordinal)
+			[self unindexOrdinal:ordinal];
+		else {
+			NSUInteger index = [_freeOrdinals firstIndex];
+			if (index != NSNotFound) {
+				[_freeOrdinals removeIndex:index];
+				_documents[index] = document;
+			} else {
+				index = [_documents count];
+				[_documents addObject:document];
+			}
+			ordinal = @(index);
+			_ordinals[document] = ordinal;
+		}
+		_documentTokens[ordinal] = tokens;
+		_documentTexts[ordinal] = [text copy];
+		NSUInteger index = [ordinal unsignedIntegerValue];
+		for (NSString * token in tokens) {
+			NSMutableIndexSet * posting = _postings[token];
+			if (!posting) {
+				posting = [NSMutableIndexSet indexSet];
+				_postings[token] = posting;
+				NSUInteger position = [self positionOfToken:token];
+				[_sortedTokens insertObject:token atIndex:position];
+			}
+			[posting addIndex:index];
+		}
+	});
+}
+
+- (void)removeDocument:(id<NSCopying>)document {
+	dispatch_sync(_queue, ^{
+		NSNumber * ordinal = _ordinals[document];
+		if (ordinal) {
+			[self unindexOrdinal:ordinal];
+			[_ordinals removeObjectForKey:document];
+			_documents[[ordinal unsignedIntegerValue]] = [NSNull null];
+			[_freeOrdinals addIndex:[ordinal unsignedIntegerValue]];
+		}
+	});
+}
+
+- (void)removeAllDocuments {
+	dispatch_sync(_queue, ^{
+		[_documents removeAllObjects];
+		[_ordinals removeAllObjects];
+		[_documentTokens removeAllObjects];
+		[_documentTexts removeAllObjects];
+		[_postings removeAllObjects];
+		[_sortedTokens removeAllObjects];
+		[_freeOrdinals removeAllIndexes];
+	});
+}
+
+- (NSSet *)documentsMatchingQuery:(NSString *)query {
+	NSArray * tokens = [[self class] tokensForString:query];
+	if (![tokens count])
+		return nil;
+	NSMutableSet * result = [NSMutableSet set];
+	dispatch_sync(_queue, ^{
+		NSMutableIndexSet * matches = nil;
+		for (NSString * token in tokens) {
+			NSMutableIndexSet * tokenMatches = [NSMutableIndexSet indexSet];
+			NSUInteger count = [_sortedTokens count];
+			for (NSUInteger i = [self positionOfToken:token]; i < count; i++) {
+				NSString * candidate = _sortedTokens[i];
+				if (![candidate hasPrefix:token])
+					break;
+				[tokenMatches addIndexes:_postings[candidate]];
+			}
+			if (!matches)
+				matches = tokenMatches;
+			else {
+				NSIndexSet * previous = [matches copy];
+				[matches removeAllIndexes];
+				[tokenMatches enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+					if ([previous containsIndex:idx])
+						[matches addIndex:idx];
+				}];
+			}
+			if (![matches count])
+				break;
+		}
+		[matches enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+			[result addObject:_documents[idx]];
+		}];
+	});
+	return result;
+}
+
+#pragma mark - Private Methods
+
+- (NSUInteger)positionOfToken:(NSString *)token {
+	return [_sortedTokens indexOfObject:token
+						  inSortedRange:NSMakeRange(0, [_sortedTokens count])
+								options:NSBinarySearchingFirstEqual | NSBinarySearchingInsertionIndex
+						usingComparator:^NSComparisonResult(NSString * a, NSString * b) {
+							return [a compare:b options:NSLiteralSearch];
+						}];
+}
+
+- (void)unindexOrdinal:(NSNumber *)ordinal {
+	NSUInteger index = [ordinal unsignedIntegerValue];
+	for (NSString * token in _documentTokens[ordinal]) {
+		NSMutableIndexSet * posting = _postings[token];
+		[posting removeIndex:index];
+		if (![posting count]) {
+			[_postings removeObjectForKey:token];
+			NSUInteger position = [self positionOfToken:token];
+			if (position < [_sortedTokens count] && [_sortedTokens[position] isEqualToString:token])
+				[_sortedTokens removeObjectAtIndex:position];
+		}
+	}
+	[_documentTokens removeObjectForKey:ordinal];
+	[_documentTexts removeObjectForKey:ordinal];
+}
+
+@end
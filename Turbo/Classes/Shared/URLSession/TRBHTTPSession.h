@@ -52,17 +52,17 @@ typedef void(^TRBHTTPSessionTaskAuthenticationChallengeBlock)(NSURLSessionTask *
 - (void)onSessionAuthenticationChallenge:(TRBHTTPSessionAuthenticationChallengeBlock)sessionAuthenticationChallengeBlock;
 - (void)onSessionTaskAuthenticationChallenge:(TRBHTTPSessionTaskAuthenticationChallengeBlock)sessionTaskAuthenticationChallengeBlock;
 
-- (void)startRequest:(NSURLRequest *)request parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
+- (NSURLSessionDataTask *)startRequest:(NSURLRequest *)request parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
 
-- (void)startRequest:(NSURLRequest *)request parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
+- (NSURLSessionDataTask *)startRequest:(NSURLRequest *)request parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
 
-- (void)GET:(NSString *)URL parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
+- (NSURLSessionDataTask *)GET:(NSString *)URL parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
 
-- (void)GETJSON:(NSString *)URL parameters:(NSDictionary *)parameters completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
+- (NSURLSessionDataTask *)GETJSON:(NSString *)URL parameters:(NSDictionary *)parameters completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
 
-- (void)GETXML:(NSString *)URL parameters:(NSDictionary *)parameters completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
+- (NSURLSessionDataTask *)GETXML:(NSString *)URL parameters:(NSDictionary *)parameters completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
 
-- (void)POST:(NSString *)URL parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
+- (NSURLSessionDataTask *)POST:(NSString *)URL parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id data, NSURLResponse * response, NSError * error))completion;
 
 - (void)downloadRequest:(NSURLRequest *)request progress:(void (^)(uint64_t bytesWritten, uint64_t totalBytesWritten, uint64_t totalBytesExpectedToWrite))progress completion:(void(^)(NSURL * location, NSURLResponse * response, NSError * error))completion;
 
@@ -23,6 +23,7 @@
 
 #import "TRBHTTPSession.h"
 #import "TRBXMLElement.h"
+#import "TRBJSONBodyStream.h"
 #import "NSString+TRBAdditions.h"
 #import "NSDictionary+TRBAdditions.h"
 
@@ -65,7 +66,7 @@
 	_sessionTaskAuthenticationChallengeBlock = [sessionTaskAuthenticationChallengeBlock copy];
 }
 
-- (void)startRequest:(NSURLRequest *)request parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id, NSURLResponse *, NSError *))completion {
+- (NSURLSessionDataTask *)startRequest:(NSURLRequest *)request parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id, NSURLResponse *, NSError *))completion {
 	NSParameterAssert(completion);
 	NSParameterAssert(request);
 	__weak TRBHTTPSession * selfWeak = self;
@@ -74,43 +75,43 @@
 		[selfWeak processResponse:response data:data error:error parser:parser completion:completion];
 	}];
 	[task resume];
+	return task;
 }
 
-- (void)startRequest:(NSURLRequest *)request parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id, NSURLResponse *, NSError *))completion {
+- (NSURLSessionDataTask *)startRequest:(NSURLRequest *)request parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id, NSURLResponse *, NSError *))completion {
 	NSParameterAssert([parameters count] == 0 || builder != nil);
 	NSError * buildError = nil;
 	NSURLRequest * builtRequest = builder ? [builder buildRequest:request parameters:parameters error:&buildError] : request;
 	if (builtRequest && !buildError)
-		[self startRequest:builtRequest parser:parser completion:completion];
-	else {
-		dispatch_async(dispatch_get_main_queue(), ^{
-			completion(nil, nil, buildError);
-		});
-	}
+		return [self startRequest:builtRequest parser:parser completion:completion];
+	dispatch_async(dispatch_get_main_queue(), ^{
+		completion(nil, nil, buildError);
+	});
+	return nil;
 }
 
-- (void)GET:(NSString *)URL parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id, NSURLResponse *, NSError *))completion {
+- (NSURLSessionDataTask *)GET:(NSString *)URL parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id, NSURLResponse *, NSError *))completion {
 	NSMutableURLRequest * request = [[NSMutableURLRequest alloc] initWithURL:[NSURL URLWithString:URL]];
 	[request setHTTPMethod:@"GET"];
-	[self startRequest:request parameters:parameters builder:builder parser:parser completion:completion];
+	return [self startRequest:request parameters:parameters builder:builder parser:parser completion:completion];
 }
 
-- (void)GETJSON:(NSString *)URL parameters:(NSDictionary *)parameters completion:(void(^)(id, NSURLResponse *, NSError *))completion {
+- (NSURLSessionDataTask *)GETJSON:(NSString *)URL parameters:(NSDictionary *)parameters completion:(void(^)(id, NSURLResponse *, NSError *))completion {
 	NSMutableURLRequest * request = [[NSMutableURLRequest alloc] initWithURL:[NSURL URLWithString:URL]];
 	[request setHTTPMethod:@"GET"];
-	[self startRequest:request parameters:parameters builder:[TRBHTTPRequestBuilder new] parser:[TRBHTTPJSONResponseParser new] completion:completion];
+	return [self startRequest:request parameters:parameters builder:[TRBHTTPRequestBuilder new] parser:[TRBHTTPJSONResponseParser new] completion:completion];
 }
 
-- (void)GETXML:(NSString *)URL parameters:(NSDictionary *)parameters completion:(void(^)(id, NSURLResponse *, NSError *))completion {
+- (NSURLSessionDataTask *)GETXML:(NSString *)URL parameters:(NSDictionary *)parameters completion:(void(^)(id, NSURLResponse *, NSError *))completion {
 	NSMutableURLRequest * request = [[NSMutableURLRequest alloc] initWithURL:[NSURL URLWithString:URL]];
 	[request setHTTPMethod:@"GET"];
-	[self startRequest:request parameters:parameters builder:[TRBHTTPRequestBuilder new] parser:[TRBHTTPXMLResponseParser new] completion:completion];
+	return [self startRequest:request parameters:parameters builder:[TRBHTTPRequestBuilder new] parser:[TRBHTTPXMLResponseParser new] completion:completion];
 }
 
-- (void)POST:(NSString *)URL parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id, NSURLResponse *, NSError *))completion {
+- (NSURLSessionDataTask *)POST:(NSString *)URL parameters:(NSDictionary *)parameters builder:(TRBHTTPRequestBuilder *)builder parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id, NSURLResponse *, NSError *))completion {
 	NSMutableURLRequest * request = [[NSMutableURLRequest alloc] initWithURL:[NSURL URLWithString:URL]];
 	[request setHTTPMethod:@"POST"];
-	[self startRequest:request parameters:parameters builder:builder parser:parser completion:completion];
+	return [self startRequest:request parameters:parameters builder:builder parser:parser completion:completion];
 }
 
 - (void)downloadRequest:(NSURLRequest *)request progress:(void (^)(uint64_t bytesRead, uint64_t totalBytesRead, uint64_t totalBytesExpectedToRead))progress completion:(void(^)(NSURL * location, NSURLResponse * response, NSError * error))completion {
@@ -202,10 +203,8 @@
 }
 
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task needNewBodyStream:(void (^)(NSInputStream *bodyStream))completionHandler {
-	if (task.originalRequest.HTTPBodyStream && [task.originalRequest.HTTPBodyStream conformsToProtocol:@protocol(NSCopying)])
-		completionHandler([task.originalRequest.HTTPBodyStream copy]);
-	else
-		completionHandler(nil);
+	TRBJSONBodyStream * body = [TRBJSONBodyStream bodyStreamForInputStream:task.originalRequest.HTTPBodyStream];
+	completionHandler(body ? [[body copy] inputStream] : nil);
 }
 
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didSendBodyData:(int64_t)bytesSent totalBytesSent:(int64_t)totalBytesSent totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend {
@@ -378,10 +377,22 @@ NSString * TRBFormURLEncodedParameters(NSDictionary * parameters, BOOL encode);
 - (NSURLRequest *)buildRequest:(NSURLRequest *)request parameters:(NSDictionary *)parameters error:(NSError **)error {
 	if ([parameters count]) {
 		if (![self.methodsWithParameterizedURL containsObject:[[request HTTPMethod] uppercaseString]]) {
-			NSData * jsonData = [NSJSONSerialization dataWithJSONObject:parameters options:kNilOptions error:error];
-			if ([jsonData length]) {
+			// Bodies carrying large strings are written while they're sent, so the
+			// serialized copy never has to exist next to the strings.
+			TRBJSONBodyStream * jsonStream = nil;
+			NSData * jsonData = nil;
+			if ([TRBJSONBodyStream shouldStreamJSONObject:parameters])
+				jsonStream = [[TRBJSONBodyStream alloc] initWithJSONObject:parameters error:error];
+			else
+				jsonData = [NSJSONSerialization dataWithJSONObject:parameters options:kNilOptions error:error];
+			NSInputStream * bodyStream = [jsonStream inputStream];
+			if ([jsonData length] || bodyStream) {
 				NSMutableURLRequest * mRequest = [request mutableCopy];
-				[mRequest setHTTPBody:jsonData];
+				if (bodyStream) {
+					[mRequest setHTTPBodyStream:bodyStream];
+					[mRequest setValue:[NSString stringWithFormat:@"%llu", jsonStream.contentLength] forHTTPHeaderField:@"Content-Length"];
+				} else
+					[mRequest setHTTPBody:jsonData];
 				NSString * charset = (__bridge NSString *)CFStringConvertEncodingToIANACharSetName(CFStringConvertNSStringEncodingToEncoding(NSUTF8StringEncoding));
 				NSString * contentType = [NSString stringWithFormat:@"application/json; charset=%@", charset];
 				[mRequest setValue:contentType forHTTPHeaderField:@"Content-Type"];
@@ -0,0 +1,56 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+// Strings at least this long are escaped while the body is read instead of up front.
+extern NSUInteger const TRBJSONStreamingThreshold;
+
+// A JSON string value holding the base64 encoding of data. The text is produced
+// as the body is sent and never exists as a whole.
+@interface TRBJSONBase64String : NSObject
+
+@property (nonatomic, strong, readonly) NSData * data;
+
++ (instancetype)stringWithData:(NSData *)data;
+
+@end
+
+// Writes a JSON object out as it's read rather than serializing it up front. The
+// body is produced on a private queue into the write end of a bound stream pair,
+// inputStream is the read end. A body is read once, copies start over from the
+// beginning, which is what NSURLSession asks for when it has to send a body again.
+@interface TRBJSONBodyStream : NSObject<NSCopying>
+
+@property (nonatomic, readonly) unsigned long long contentLength;
+
+// Whether object holds anything that would be worth streaming.
++ (BOOL)shouldStreamJSONObject:(id)object;
+// The body feeding an input stream returned by inputStream, nil for any other stream.
++ (instancetype)bodyStreamForInputStream:(NSInputStream *)inputStream;
+
+// Returns nil if object contains something JSON can't represent.
+- (instancetype)initWithJSONObject:(id)object error:(NSError **)error;
+// nil once the body has been handed out.
+- (NSInputStream *)inputStream;
+
+@end
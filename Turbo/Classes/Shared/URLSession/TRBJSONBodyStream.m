@@ -0,0 +1,483 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBJSONBodyStream.h"
+#import "TRBBase64.h"
+#import <objc/runtime.h>
+
+NSUInteger const TRBJSONStreamingThreshold = 64 * 1024;
+
+#define TRBJSONPieceLength (32 * 1024)
+#define TRBJSONMaxDepth 64
+
+static char TRBJSONBodyStreamKey;
+
+static void TRBJSONBodyStreamCallback(CFWriteStreamRef stream, CFStreamEventType type, void * info);
+
+static dispatch_queue_t TRBJSONBodyStreamQueue(void) {
+	static dispatch_queue_t queue = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		queue = dispatch_queue_create("com.caffeineapps.TRBJSONBodyStreamQueue", DISPATCH_QUEUE_SERIAL);
+	});
+	return queue;
+}
+
+// Bytes a UTF-16 unit takes once escaped and converted to UTF-8. Surrogate pairs
+// count 2 per unit, lone surrogates are written as \u escapes.
+static NSUInteger TRBJSONEscapedLength(const unichar * characters, NSUInteger count) {
+	NSUInteger result = 0;
+	for (NSUInteger i = 0; i < count; i++) {
+		unichar c = characters[i];
+		if (c == '"' || c == '\\' || c == '\n' || c == '\r' || c == '\t')
+			result += 2;
+		else if (c < 0x20)
+			result += 6;
+		else if (c < 0x80)
+			result += 1;
+		else if (c < 0x800)
+			result += 2;
+		else if (CFStringIsSurrogateHighCharacter(c) && i + 1 < count && CFStringIsSurrogateLowCharacter(characters[i + 1])) {
+			result += 4;
+			i++;
+		} else if (CFStringIsSurrogateHighCharacter(c) || CFStringIsSurrogateLowCharacter(c))
+			result += 6;
+		else
+			result += 3;
+	}
+	return result;
+}
+
+static uint8_t * TRBJSONWriteUnicodeEscape(uint8_t * p, unichar c) {
+	static const char hex[] = "0123456789abcdef";
+	*p++ = '\\';
+	*p++ = 'u';
+	*p++ = hex[(c >> 12) & 0xF];
+	*p++ = hex[(c >> 8) & 0xF];
+	*p++ = hex[(c >> 4) & 0xF];
+	*p++ = hex[c & 0xF];
+	return p;
+}
+
+static void TRBJSONAppendEscaped(NSMutableData * output, const unichar * characters, NSUInteger count) {
+	NSUInteger start = [output length];
+	[output increaseLengthBy:TRBJSONEscapedLength(characters, count)];
+	uint8_t * p = (uint8_t *)[output mutableBytes] + start;
+	for (NSUInteger i = 0; i < count; i++) {
+		unichar c = characters[i];
+		if (c == '"' || c == '\\') {
+			*p++ = '\\';
+			*p++ = (uint8_t)c;
+		} else if (c == '\n' || c == '\r' || c == '\t') {
+			*p++ = '\\';
+			*p++ = c == '\n' ? 'n' : (c == '\r' ? 'r' : 't');
+		} else if (c < 0x20) {
+			p = TRBJSONWriteUnicodeEscape(p, c);
+		} else if (c < 0x80) {
+			*p++ = (uint8_t)c;
+		} else if (c < 0x800) {
+			*p++ = (uint8_t)(0xC0 | (c >> 6));
+			*p++ = (uint8_t)(0x80 | (c & 0x3F));
+		} else if (CFStringIsSurrogateHighCharacter(c) && i + 1 < count && CFStringIsSurrogateLowCharacter(characters[i + 1])) {
+			UTF32Char scalar = CFStringGetLongCharacterForSurrogatePair(c, characters[++i]);
+			*p++ = (uint8_t)(0xF0 | (scalar >> 18));
+			*p++ = (uint8_t)(0x80 | ((scalar >> 12) & 0x3F));
+			*p++ = (uint8_t)(0x80 | ((scalar >> 6) & 0x3F));
+			*p++ = (uint8_t)(0x80 | (scalar & 0x3F));
+		} else if (CFStringIsSurrogateHighCharacter(c) || CFStringIsSurrogateLowCharacter(c)) {
+			p = TRBJSONWriteUnicodeEscape(p, c);
+		} else {
+			*p++ = (uint8_t)(0xE0 | (c >> 12));
+			*p++ = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+			*p++ = (uint8_t)(0x80 | (c & 0x3F));
+		}
+	}
+}
+
+// One stretch of the body. Chunks hold their read position, so every stream
+// builds its own.
+@protocol TRBJSONBodyChunk <NSObject>
+- (unsigned long long)length;
+// Appends up to about maxLength bytes, returns NO once there was nothing left.
+- (BOOL)appendNextPieceToData:(NSMutableData *)data maxLength:(NSUInteger)maxLength;
+@end
+
+@interface TRBJSONLiteralChunk : NSObject<TRBJSONBodyChunk>
+- (instancetype)initWithData:(NSData *)data;
+@end
+
+@interface TRBJSONStringChunk : NSObject<TRBJSONBodyChunk>
+- (instancetype)initWithString:(NSString *)string;
+@end
+
+@interface TRBJSONBase64Chunk : NSObject<TRBJSONBodyChunk>
+- (instancetype)initWithData:(NSData *)data;
+@end
+
+@implementation TRBJSONLiteralChunk {
+	NSData * _data;
+	NSUInteger _offset;
+}
+
+- (instancetype)initWithData:(NSData *)data {
+	self = [super init];
+	if (self)
+		_data = data;
+	return self;
+}
+
+- (unsigned long long)length {
+	return [_data length];
+}
+
+- (BOOL)appendNextPieceToData:(NSMutableData *)data maxLength:(NSUInteger)maxLength {
+	NSUInteger count = MIN(maxLength, [_data length] - _offset);
+	[data appendBytes:(const uint8_t *)[_data bytes] + _offset length:count];
+	_offset += count;
+	return count > 0;
+}
+
+@end
+
+@implementation TRBJSONStringChunk {
+	NSString * _string;
+	NSUInteger _index;
+	unsigned long long _length;
+}
+
+- (instancetype)initWithString:(NSString *)string {
+	self = [super init];
+	if (self) {
+		_string = [string copy];
+		unichar characters[1024];
+		NSUInteger count = [_string length];
+		for (NSUInteger i = 0; i < count; ) {
+			NSRange range = NSMakeRange(i, MIN((NSUInteger)1024, count - i));
+			[_string getCharacters:characters range:range];
+			if (NSMaxRange(range) < count && CFStringIsSurrogateHighCharacter(characters[range.length - 1]))
+				range.length--;
+			_length += TRBJSONEscapedLength(characters, range.length);
+			i = NSMaxRange(range);
+		}
+	}
+	return self;
+}
+
+- (unsigned long long)length {
+	return _length;
+}
+
+- (BOOL)appendNextPieceToData:(NSMutableData *)data maxLength:(NSUInteger)maxLength {
+	NSUInteger count = [_string length];
+	if (_index >= count)
+		return NO;
+	// Escaping can grow a unit to 6 bytes, the slice is sized for the worst case.
+	unichar characters[TRBJSONPieceLength / 6];
+	NSRange range = NSMakeRange(_index, MIN(MAX(maxLength / 6, (NSUInteger)2), MIN(count - _index, sizeof(characters) / sizeof(unichar))));
+	[_string getCharacters:characters range:range];
+	if (NSMaxRange(range) < count && range.length > 1 && CFStringIsSurrogateHighCharacter(characters[range.length - 1]))
+		range.length--;
+	TRBJSONAppendEscaped(data, characters, range.length);
+	_index = NSMaxRange(range);
+	return YES;
+}
+
+@end
+
+@implementation TRBJSONBase64Chunk {
+	NSData * _data;
+	NSUInteger _offset;
+	TRBBase64Encoder _encoder;
+	BOOL _finished;
+}
+
+- (instancetype)initWithData:(NSData *)data {
+	self = [super init];
+	if (self) {
+		_data = data;
+		TRBBase64EncoderInit(&_encoder);
+	}
+	return self;
+}
+
+- (unsigned long long)length {
+	return TRBBase64EncodedLength([_data length]);
+}
+
+- (BOOL)appendNextPieceToData:(NSMutableData *)data maxLength:(NSUInteger)maxLength {
+	if (_finished)
+		return NO;
+	NSUInteger start = [data length];
+	NSUInteger count = MIN(MAX(maxLength / 4 * 3, (NSUInteger)3), [_data length] - _offset);
+	[data increaseLengthBy:TRBBase64EncodedLength(count + 2)];
+	char * output = (char *)[data mutableBytes] + start;
+	size_t written = TRBBase64EncoderUpdate(&_encoder, (const uint8_t *)[_data bytes] + _offset, count, output);
+	_offset += count;
+	if (_offset == [_data length]) {
+		written += TRBBase64EncoderFinish(&_encoder, output + written);
+		_finished = YES;
+	}
+	[data setLength:start + written];
+	return YES;
+}
+
+@end
+
+@implementation TRBJSONBase64String
+
++ (instancetype)stringWithData:(NSData *)data {
+	TRBJSONBase64String * result = [self new];
+	result->_data = [data copy];
+	return result;
+}
+
+@end
+
+@implementation TRBJSONBodyStream {
+	id _object;
+	NSMutableArray * _chunks;
+	NSMutableData * _literal;
+	NSUInteger _chunkIndex;
+	NSMutableData * _buffer;
+	NSUInteger _bufferOffset;
+	CFWriteStreamRef _writeStream;
+	BOOL _started;
+}
+
+- (instancetype)initWithJSONObject:(id)object error:(NSError **)error {
+	self = [super init];
+	if (self) {
+		_object = object;
+		_chunks = [NSMutableArray new];
+		_literal = [NSMutableData new];
+		_buffer = [[NSMutableData alloc] initWithCapacity:TRBJSONPieceLength];
+		if (![self appendObject:object depth:0]) {
+			if (error)
+				*error = [NSError errorWithDomain:NSStringFromClass([self class]) code:-1 userInfo:@{NSLocalizedDescriptionKey: @"Invalid object for JSON body"}];
+			return nil;
+		}
+		[self flushLiteral];
+		_literal = nil;
+		for (id<TRBJSONBodyChunk> chunk in _chunks)
+			_contentLength += [chunk length];
+	}
+	return self;
+}
+
+#pragma mark - Public Methods
+
++ (BOOL)shouldStreamJSONObject:(id)object {
+	BOOL result = NO;
+	if ([object isKindOfClass:[TRBJSONBase64String class]])
+		result = YES;
+	else if ([object isKindOfClass:[NSString class]])
+		result = [object length] >= TRBJSONStreamingThreshold;
+	else if ([object isKindOfClass:[NSDictionary class]] || [object isKindOfClass:[NSArray class]]) {
+		for (id value in ([object isKindOfClass:[NSDictionary class]] ? [object allValues] : object)) {
+			if ((result = [self shouldStreamJSONObject:value]))
+				break;
+		}
+	}
+	return result;
+}
+
++ (instancetype)bodyStreamForInputStream:(NSInputStream *)inputStream {
+	return inputStream ? objc_getAssociatedObject(inputStream, &TRBJSONBodyStreamKey) : nil;
+}
+
+- (NSInputStream *)inputStream {
+	if (_started)
+		return nil;
+	CFReadStreamRef readStream = NULL;
+	CFWriteStreamRef writeStream = NULL;
+	CFStreamCreateBoundPair(kCFAllocatorDefault, &readStream, &writeStream, TRBJSONPieceLength);
+	if (!readStream || !writeStream) {
+		if (readStream)
+			CFRelease(readStream);
+		if (writeStream)
+			CFRelease(writeStream);
+		return nil;
+	}
+	_started = YES;
+	_writeStream = writeStream;
+	// The write end keeps the producer alive until the whole body went through.
+	CFStreamClientContext context = {0, (__bridge void *)self, CFRetain, CFRelease, NULL};
+	CFWriteStreamSetClient(_writeStream, kCFStreamEventCanAcceptBytes | kCFStreamEventErrorOccurred | kCFStreamEventEndEncountered, TRBJSONBodyStreamCallback, &context);
+	CFWriteStreamSetDispatchQueue(_writeStream, TRBJSONBodyStreamQueue());
+	CFWriteStreamOpen(_writeStream);
+	NSInputStream * result = CFBridgingRelease(readStream);
+	objc_setAssociatedObject(result, &TRBJSONBodyStreamKey, self, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+	return result;
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone {
+	return [[[self class] allocWithZone:zone] initWithJSONObject:_object error:NULL];
+}
+
+#pragma mark - Private Methods
+
+- (void)handleEvent:(CFStreamEventType)type {
+	// Closing the write end drops the client's reference, which may be the last one.
+	TRBJSONBodyStream * __attribute__((objc_precise_lifetime)) retainedSelf = self;
+	if (type == kCFStreamEventCanAcceptBytes)
+		[self writeAvailableBytes];
+	else
+		[retainedSelf finishWriting];
+}
+
+- (void)writeAvailableBytes {
+	while (_writeStream && CFWriteStreamCanAcceptBytes(_writeStream)) {
+		if (_bufferOffset == [_buffer length] && ![self fillBuffer]) {
+			// Closing the write end is what the reader sees as the end of the body.
+			[self finishWriting];
+			return;
+		}
+		CFIndex written = CFWriteStreamWrite(_writeStream, (const uint8_t *)[_buffer bytes] + _bufferOffset, (CFIndex)([_buffer length] - _bufferOffset));
+		if (written <= 0) {
+			[self finishWriting];
+			return;
+		}
+		_bufferOffset += (NSUInteger)written;
+	}
+}
+
+- (void)finishWriting {
+	if (!_writeStream)
+		return;
+	CFWriteStreamSetClient(_writeStream, kCFStreamEventNone, NULL, NULL);
+	CFWriteStreamSetDispatchQueue(_writeStream, NULL);
+	CFWriteStreamClose(_writeStream);
+	CFRelease(_writeStream);
+	_writeStream = NULL;
+}
+
+- (BOOL)fillBuffer {
+	[_buffer setLength:0];
+	_bufferOffset = 0;
+	while (_chunkIndex < [_chunks count]) {
+		if ([_chunks[_chunkIndex] appendNextPieceToData:_buffer maxLength:TRBJSONPieceLength] && [_buffer length])
+			return YES;
+		_chunkIndex++;
+	}
+	return NO;
+}
+
+- (void)flushLiteral {
+	if ([_literal length]) {
+		[_chunks addObject:[[TRBJSONLiteralChunk alloc] initWithData:[_literal copy]]];
+		[_literal setLength:0];
+	}
+}
+
+- (void)appendLiteral:(const char *)literal {
+	[_literal appendBytes:literal length:strlen(literal)];
+}
+
+- (void)appendString:(NSString *)string {
+	[self appendLiteral:"\""];
+	NSUInteger count = [string length];
+	if (count >= TRBJSONStreamingThreshold) {
+		[self flushLiteral];
+		[_chunks addObject:[[TRBJSONStringChunk alloc] initWithString:string]];
+	} else if (count) {
+		unichar stackCharacters[256];
+		unichar * characters = count <= 256 ? stackCharacters : malloc(count * sizeof(unichar));
+		[string getCharacters:characters range:NSMakeRange(0, count)];
+		TRBJSONAppendEscaped(_literal, characters, count);
+		if (characters != stackCharacters)
+			free(characters);
+	}
+	[self appendLiteral:"\""];
+}
+
+- (BOOL)appendNumber:(NSNumber *)number {
+	if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+		[self appendLiteral:[number boolValue] ? "true" : "false"];
+	} else if (CFNumberIsFloatType((__bridge CFNumberRef)number)) {
+		double value = [number doubleValue];
+		if (isnan(value) || isinf(value))
+			return NO;
+		char text[32];
+		snprintf(text, sizeof(text), "%.17g", value);
+		[self appendLiteral:text];
+	} else {
+		[self appendLiteral:[[number stringValue] UTF8String]];
+	}
+	return YES;
+}
+
+- (BOOL)appendObject:(id)object depth:(NSUInteger)depth {
+	if (depth > TRBJSONMaxDepth)
+		return NO;
+	BOOL result = YES;
+	if ([object isKindOfClass:[NSDictionary class]]) {
+		__block BOOL first = YES;
+		__block BOOL valid = YES;
+		[self appendLiteral:"{"];
+		[object enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL * stop) {
+			if (!first)
+				[self appendLiteral:","];
+			first = NO;
+			valid = [key isKindOfClass:[NSString class]];
+			if (valid) {
+				[self appendString:key];
+				[self appendLiteral:":"];
+				valid = [self appendObject:value depth:depth + 1];
+			}
+			*stop = !valid;
+		}];
+		[self appendLiteral:"}"];
+		result = valid;
+	} else if ([object isKindOfClass:[NSArray class]]) {
+		[self appendLiteral:"["];
+		for (NSUInteger i = 0; i < [object count] && result; i++) {
+			if (i)
+				[self appendLiteral:","];
+			result = [self appendObject:object[i] depth:depth + 1];
+		}
+		[self appendLiteral:"]"];
+	} else if ([object isKindOfClass:[NSString class]]) {
+		[self appendString:object];
+	} else if ([object isKindOfClass:[TRBJSONBase64String class]]) {
+		[self appendLiteral:"\""];
+		[self flushLiteral];
+		[_chunks addObject:[[TRBJSONBase64Chunk alloc] initWithData:[object data]]];
+		[self appendLiteral:"\""];
+	} else if ([object isKindOfClass:[NSNumber class]]) {
+		result = [self appendNumber:object];
+	} else if ([object isKindOfClass:[NSNull class]]) {
+		[self appendLiteral:"null"];
+	} else {
+		result = NO;
+	}
+	return result;
+}
+
+@end
+
+static void TRBJSONBodyStreamCallback(CFWriteStreamRef stream, CFStreamEventType type, void * info) {
+	[(__bridge TRBJSONBodyStream *)info handleEvent:type];
+}
@@ -56,5 +56,11 @@
 
 - (id)initWithXMLElement:(TRBXMLElement *)element;
 - (NSDictionary *)infoFromDescription;
+// Lowercase hex info hash, from the description or the magnet URI.
+- (NSString *)infoHash;
+- (NSUInteger)seedCount;
+- (NSUInteger)leechCount;
+// Magnet URI when the hash is known, the torrent file otherwise.
+- (NSString *)torrentURL;
 
 @end
@@ -54,6 +54,47 @@
 
 @end
 
+// Counts are formatted with grouping separators by some feeds.
+static NSUInteger TRBCountFromString(NSString * string) {
+	NSUInteger result = 0;
+	NSUInteger length = [string length];
+	for (NSUInteger i = 0; i < length; i++) {
+		unichar c = [string characterAtIndex:i];
+		if (c >= '0' && c <= '9')
+			result = result * 10 + (c - '0');
+	}
+	return result;
+}
+
+static NSString * TRBHexStringFromBase32(NSString * base32) {
+	uint8_t bytes[20] = {0};
+	NSUInteger bits = 0;
+	NSUInteger buffer = 0;
+	NSUInteger count = 0;
+	for (NSUInteger i = 0; i < [base32 length] && count < sizeof(bytes); i++) {
+		unichar c = [base32 characterAtIndex:i];
+		NSUInteger value;
+		if (c >= 'A' && c <= 'Z')
+			value = c - 'A';
+		else if (c >= 'a' && c <= 'z')
+			value = c - 'a';
+		else if (c >= '2' && c <= '7')
+			value = c - '2' + 26;
+		else
+			return nil;
+		buffer = (buffer << 5) | value;
+		bits += 5;
+		if (bits >= 8) {
+			bits -= 8;
+			bytes[count++] = (buffer >> bits) & 0xFF;
+		}
+	}
+	NSMutableString * result = [NSMutableString stringWithCapacity:sizeof(bytes) * 2];
+	for (NSUInteger i = 0; i < sizeof(bytes); i++)
+		[result appendFormat:@"%02x", bytes[i]];
+	return result;
+}
+
 @interface TRBRSSItem ()
 @property (nonatomic, strong) NSDictionary * info;
 @end
@@ -88,7 +129,7 @@
 
 // Size: 422 MB Seeds: 28 Peers: 1 Hash: be23e5537c07d0e82c454f3501e7b7a34179a313
 - (NSDictionary *)infoFromDescription {
-	if (!self.info) {
+	if (!self.info && _desc) {
 		NSError * error = nil;
 		NSRegularExpression * regex = [NSRegularExpression regularExpressionWithPattern:@"(\\w+):"
 																				options:0
@@ -120,4 +161,42 @@
 	return self.info;
 }
 
+- (NSString *)infoHash {
+	NSString * result = [self infoFromDescription][@"Hash"];
+	if (![result length] && [_magnetURI length]) {
+		NSRange range = [_magnetURI rangeOfString:@"urn:btih:" options:NSCaseInsensitiveSearch];
+		if (range.location != NSNotFound) {
+			result = [_magnetURI substringFromIndex:NSMaxRange(range)];
+			NSRange end = [result rangeOfString:@"&"];
+			if (end.location != NSNotFound)
+				result = [result substringToIndex:end.location];
+			if ([result length] == 32)
+				result = TRBHexStringFromBase32(result);
+		}
+	}
+	return [result length] == 40 ? [result lowercaseString] : nil;
+}
+
+- (NSUInteger)seedCount {
+	NSString * seeds = [_seeders length] ? _seeders : [self infoFromDescription][@"Seeds"];
+	return TRBCountFromString(seeds);
+}
+
+- (NSUInteger)leechCount {
+	NSString * leechers = [_leechers length] ? _leechers : [self infoFromDescription][@"Peers"];
+	return TRBCountFromString(leechers);
+}
+
+- (NSString *)torrentURL {
+	NSString * result = _magnetURI;
+	if (![result length]) {
+		NSString * infoHash = [self infoHash];
+		if (infoHash)
+			result = [NSString stringWithFormat:@"magnet:?xt=urn:btih:%@", infoHash];
+		else
+			result = [_enclosureURL length] ? _enclosureURL : _link;
+	}
+	return result;
+}
+
 @end
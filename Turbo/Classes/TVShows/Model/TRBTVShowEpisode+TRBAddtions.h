@@ -30,6 +30,6 @@
 - (NSString *)niceTitle;
 - (NSString *)niceSearchString;
 - (NSDate *)localizedAirDate;
-- (void)scheduleLocalNotification;
+- (UILocalNotification *)localNotificationWithFireDate:(NSDate *)fireDate;
 
 @end
@@ -40,26 +40,6 @@ static NSNumberFormatter * TRBTVShowNumberFormatter;
 	self.episodeID = xml.episodeID;
 	self.episodeTitle = xml.episodeTitle;
 	self.episodeNumber = xml.episodeNumber;
-	if (self.notificationScheduled && ![self.airDate isEqualToDate:xml.airDate]) {
-		UILocalNotification * toCancel = nil;
-		for (UILocalNotification * note in [UIApplication sharedApplication].scheduledLocalNotifications) {
-			NSNumber * episodeID = note.userInfo[@"episodeID"];
-			NSNumber * seriesID = note.userInfo[@"seriesID"];
-			NSNumber * episodeNumber = note.userInfo[@"episodeNumber"];
-			NSNumber * seasonNumber = note.userInfo[@"seasonNumber"];
-			NSString * seriesTitle = note.userInfo[@"seriesTitle"];
-			if (([episodeID isEqualToNumber:self.episodeID] && [seriesID isEqualToNumber:self.seriesID]) ||
-				([episodeNumber isEqualToNumber:self.episodeNumber] && [seasonNumber isEqualToNumber:self.seasonNumber] && [seriesTitle isEqualToString:self.season.series.title])) {
-				toCancel = note;
-				break;
-			}
-		}
-		if (toCancel)
-			[[UIApplication sharedApplication] cancelLocalNotification:toCancel];
-		BOOL notificationsDisabled = [[NSUserDefaults standardUserDefaults] boolForKey:TRBTVShowNotificationsKey];
-		if (!notificationsDisabled)
-			[self scheduleLocalNotification];
-	}
 	self.airDate = xml.airDate;
 	self.language = xml.language;
 	self.overview = xml.overview;
@@ -105,12 +85,11 @@ static NSNumberFormatter * TRBTVShowNumberFormatter;
 	return result;
 }
 
-- (void)scheduleLocalNotification {
-	NSDate * airDate = [self localizedAirDate];
-	NSDate * now = [NSDate date];
-	if ([now timeIntervalSinceReferenceDate] < [airDate timeIntervalSinceReferenceDate]) {
-		UILocalNotification * notification = [UILocalNotification new];
-		notification.fireDate = airDate;
+- (UILocalNotification *)localNotificationWithFireDate:(NSDate *)fireDate {
+	UILocalNotification * notification = nil;
+	if (fireDate) {
+		notification = [UILocalNotification new];
+		notification.fireDate = fireDate;
 		notification.timeZone = [NSTimeZone localTimeZone];
 		notification.alertBody = [NSString stringWithFormat:@"%@ - %@", self.season.series.title, [self niceTitle]];
 		notification.userInfo = @{@"episodeID": self.episodeID,
@@ -118,9 +97,8 @@ static NSNumberFormatter * TRBTVShowNumberFormatter;
 								  @"episodeNumber": self.episodeNumber,
 								  @"seasonNumber": self.seasonNumber,
 								  @"seriesTitle": self.season.series.title};
-		self.notificationScheduled = @YES;
-		[[UIApplication sharedApplication] scheduleLocalNotification:notification];
 	}
+	return notification;
 }
 
 @end
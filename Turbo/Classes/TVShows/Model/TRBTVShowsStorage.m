@@ -31,6 +31,7 @@
 #import "TRBTVShowSeason.h"
 #import "TRBXMLElement+TRBTVShow.h"
 #import "TRBXMLElement.h"
+#import "TRBTVShowNotificationScheduler.h"
 
 #define FileManager [NSFileManager defaultManager]
 #define kSecondsInDay 86400.0
@@ -323,12 +324,7 @@ static NSString * TRBTVShowBannerTypeStrings[TRBTVShowBannerTypeCount] = {@"post
 }
 
 - (void)removeTVShow:(TRBTVShow *)tvShow {
-	NSArray * notifications = [[UIApplication sharedApplication].scheduledLocalNotifications copy];
-	[notifications enumerateObjectsUsingBlock:^(UILocalNotification * note, NSUInteger idx, BOOL *stop) {
-		NSNumber * seriesID = note.userInfo[@"seriesID"];
-		if ([seriesID isEqualToNumber:tvShow.seriesID])
-			[[UIApplication sharedApplication] cancelLocalNotification:note];
-	}];
+	[[TRBTVShowNotificationScheduler sharedInstance] cancelNotificationsForSeriesID:tvShow.seriesID];
 	[self.managedObjectContextMain deleteObject:tvShow];
 	NSError * error = nil;
 	[self.managedObjectContextMain save:&error];
@@ -495,7 +491,7 @@ static NSString * TRBTVShowBannerTypeStrings[TRBTVShowBannerTypeCount] = {@"post
 	NSCalendar * calendar = [NSCalendar currentCalendar];
 	NSDateComponents * comps = [calendar components:NSYearCalendarUnit|NSMonthCalendarUnit|NSDayCalendarUnit fromDate:[NSDate date]];
 	NSDate * today = [calendar dateFromComponents:comps];
-	NSPredicate * predicate = [NSPredicate predicateWithFormat:@"airDate >= %@ AND notificationScheduled = NO", today];
+	NSPredicate * predicate = [NSPredicate predicateWithFormat:@"airDate >= %@", today];
 	[request setPredicate:predicate];
 	NSSortDescriptor * sortDesc1 = [NSSortDescriptor sortDescriptorWithKey:@"airDate" ascending:YES];
 	[request setSortDescriptors:@[sortDesc1]];
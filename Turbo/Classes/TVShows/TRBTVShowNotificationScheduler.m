@@ -0,0 +1,153 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "TRBTVShowNotificationScheduler.h"
+#import "TRBTVShowEpisode.h"
+#import "TRBTVShowEpisode+TRBAddtions.h"
+
+// iOS keeps at most 64 pending local notifications per app, the soonest ones win.
+static NSUInteger const TRBMaxScheduledNotifications = 64;
+
+@implementation TRBTVShowNotificationScheduler {
+	NSMutableDictionary * _scheduled;
+}
+
++ (instancetype)sharedInstance {
+	static id sharedInstance = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		sharedInstance = [[self alloc] init];
+	});
+	return sharedInstance;
+}
+
+#pragma mark - Public Methods
+
+- (void)scheduleNotificationsForEpisodes:(NSArray *)episodes {
+	NSMutableDictionary * scheduled = [self scheduledNotifications];
+	NSDate * now = [NSDate date];
+
+	NSMutableDictionary * fireDates = [[NSMutableDictionary alloc] initWithCapacity:[episodes count]];
+	NSMutableArray * upcoming = [[NSMutableArray alloc] initWithCapacity:[episodes count]];
+	for (TRBTVShowEpisode * episode in episodes) {
+		NSDate * fireDate = [episode localizedAirDate];
+		if (episode.episodeID && [fireDate compare:now] == NSOrderedDescending) {
+			fireDates[episode.episodeID] = fireDate;
+			[upcoming addObject:episode];
+		}
+	}
+	[upcoming sortUsingComparator:^NSComparisonResult(TRBTVShowEpisode * e1, TRBTVShowEpisode * e2) {
+		return [fireDates[e1.episodeID] compare:fireDates[e2.episodeID]];
+	}];
+	if ([upcoming count] > TRBMaxScheduledNotifications)
+		[upcoming removeObjectsInRange:NSMakeRange(TRBMaxScheduledNotifications, [upcoming count] - TRBMaxScheduledNotifications)];
+
+	NSMutableDictionary * desired = [[NSMutableDictionary alloc] initWithCapacity:[upcoming count]];
+	for (TRBTVShowEpisode * episode in upcoming)
+		desired[episode.episodeID] = episode;
+
+	NSMutableArray * toCancel = [NSMutableArray new];
+	[scheduled enumerateKeysAndObjectsUsingBlock:^(NSNumber * episodeID, UILocalNotification * note, BOOL * stop) {
+		NSDate * fireDate = fireDates[episodeID];
+		if (!desired[episodeID] || ![note.fireDate isEqualToDate:fireDate])
+			[toCancel addObject:episodeID];
+	}];
+
+	NSMutableArray * toSchedule = [NSMutableArray new];
+	[desired enumerateKeysAndObjectsUsingBlock:^(NSNumber * episodeID, TRBTVShowEpisode * episode, BOOL * stop) {
+		if (!scheduled[episodeID] || [toCancel containsObject:episodeID]) {
+			UILocalNotification * note = [episode localNotificationWithFireDate:fireDates[episodeID]];
+			if (note)
+				[toSchedule addObject:note];
+		}
+	}];
+
+	UIApplication * application = [UIApplication sharedApplication];
+	for (NSNumber * episodeID in toCancel) {
+		UILocalNotification * note = scheduled[episodeID];
+		// Notifications that already fired are gone from the system, only the index needs cleaning.
+		if ([note.fireDate compare:now] == NSOrderedDescending)
+			[application cancelLocalNotification:note];
+		[scheduled removeObjectForKey:episodeID];
+	}
+	for (UILocalNotification * note in toSchedule) {
+		[application scheduleLocalNotification:note];
+		scheduled[note.userInfo[@"episodeID"]] = note;
+	}
+	LogV(@"Notifications cancelled: %lu scheduled: %lu pending: %lu", (unsigned long)[toCancel count], (unsigned long)[toSchedule count], (unsigned long)[scheduled count]);
+
+	for (TRBTVShowEpisode * episode in episodes) {
+		BOOL isScheduled = episode.episodeID && scheduled[episode.episodeID] != nil;
+		if ([episode.notificationScheduled boolValue] != isScheduled)
+			episode.notificationScheduled = @(isScheduled);
+	}
+}
+
+- (void)cancelNotificationForEpisodeID:(NSNumber *)episodeID {
+	NSMutableDictionary * scheduled = [self scheduledNotifications];
+	UILocalNotification * note = episodeID ? scheduled[episodeID] : nil;
+	if (note) {
+		[[UIApplication sharedApplication] cancelLocalNotification:note];
+		[scheduled removeObjectForKey:episodeID];
+	}
+}
+
+- (void)cancelNotificationsForSeriesID:(NSNumber *)seriesID {
+	NSMutableDictionary * scheduled = [self scheduledNotifications];
+	NSMutableArray * toCancel = [NSMutableArray new];
+	[scheduled enumerateKeysAndObjectsUsingBlock:^(NSNumber * episodeID, UILocalNotification * note, BOOL * stop) {
+		if ([note.userInfo[@"seriesID"] isEqualToNumber:seriesID])
+			[toCancel addObject:episodeID];
+	}];
+	for (NSNumber * episodeID in toCancel) {
+		[[UIApplication sharedApplication] cancelLocalNotification:scheduled[episodeID]];
+		[scheduled removeObjectForKey:episodeID];
+	}
+}
+
+- (void)cancelAllNotifications {
+	[[UIApplication sharedApplication] cancelAllLocalNotifications];
+	_scheduled = [NSMutableDictionary new];
+}
+
+#pragma mark - Private Methods
+
+- (NSMutableDictionary *)scheduledNotifications {
+	if (!_scheduled) {
+		UIApplication * application = [UIApplication sharedApplication];
+		NSArray * notifications = application.scheduledLocalNotifications;
+		_scheduled = [[NSMutableDictionary alloc] initWithCapacity:[notifications count]];
+		for (UILocalNotification * note in notifications) {
+			NSNumber * episodeID = note.userInfo[@"episodeID"];
+			if (!episodeID)
+				continue;
+			if (_scheduled[episodeID])
+				[application cancelLocalNotification:note];
+			else
+				_scheduled[episodeID] = note;
+		}
+	}
+	return _scheduled;
+}
+
+@end
@@ -28,6 +28,7 @@
 #import "TRBTVShowSeason+TRBAdditions.h"
 #import "TRBTVShowEpisode.h"
 #import "TRBTVShowEpisode+TRBAddtions.h"
+#import "TRBTVShowNotificationScheduler.h"
 #import "TRBXMLElement.h"
 #import "TRBHTTPSession.h"
 #import "TRBDataCache.h"
@@ -226,8 +227,7 @@ static NSString * const TRBLastDBUpdateKey = @"TRBLastDBUpdate";
 	BOOL notificationsDisabled = [[NSUserDefaults standardUserDefaults] boolForKey:TRBTVShowNotificationsKey];
 	if (!notificationsDisabled) {
 		[[TRBTVShowsStorage sharedInstance] fetchAllNextEpisodesWithHandler:^(NSArray *results) {
-			for (TRBTVShowEpisode * episode in results)
-				[episode scheduleLocalNotification];
+			[[TRBTVShowNotificationScheduler sharedInstance] scheduleNotificationsForEpisodes:results];
 			[[TRBTVShowsStorage sharedInstance] save];
 		}];
 	}
@@ -239,7 +239,7 @@ static NSString * const TRBLastDBUpdateKey = @"TRBLastDBUpdate";
 			episode.notificationScheduled = @NO;
 		[[TRBTVShowsStorage sharedInstance] save];
 	}];
-	[[UIApplication sharedApplication] cancelAllLocalNotifications];
+	[[TRBTVShowNotificationScheduler sharedInstance] cancelAllNotifications];
 }
 
 @end
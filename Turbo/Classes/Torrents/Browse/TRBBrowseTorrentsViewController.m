@@ -28,6 +28,7 @@
 #import "TRBHTTPSession.h"
 #import "TRBHost.h"
 #import "TRBTorrentClient.h"
+#import "TRBTorrentSelectionController.h"
 #import "NSString+TRBAdditions.h"
 #import "TKAlertCenter.h"
 
@@ -39,6 +40,7 @@
 	TRBRSSFeed * _rss;
 	UINavigationController * _categoriesNavController;
 	TRBHTTPSession * _session;
+	TRBTorrentSelectionController * _selectionController;
 }
 
 - (id)initWithCoder:(NSCoder *)aDecoder {
@@ -47,6 +49,7 @@
         _categoryTag = 208; // High Res TV-Shows
 		_session = [[TRBHTTPSession alloc] initWithConfiguration:nil];
 		_session.acceptedHTTPStatusCodes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(200, 100)];
+		_selectionController = [[TRBTorrentSelectionController alloc] initWithViewController:self];
     }
     return self;
 }
@@ -61,6 +64,7 @@
     [super viewDidLoad];
 	self.refreshControl = [[UIRefreshControl alloc] init];
 	[self.refreshControl addTarget:self action:@selector(fetchRSSFeed) forControlEvents:UIControlEventValueChanged];
+	[_selectionController installButtons];
 	TRBBrowseCategoriesViewController * controller = nil;
 	if (self.revealingViewController) {
 		controller = [self.storyboard instantiateViewControllerWithIdentifier:@"TRBBrowseCategoryViewController"];
@@ -95,6 +99,11 @@
     [super didReceiveMemoryWarning];
 }
 
+- (void)setEditing:(BOOL)editing animated:(BOOL)animated {
+	[super setEditing:editing animated:animated];
+	[_selectionController setEditing:editing animated:animated];
+}
+
 #pragma mark - Public Methods
 
 - (void)fetchRSSFeed {
@@ -144,7 +153,19 @@
 
 #pragma mark - Table view delegate
 
+- (void)tableView:(UITableView *)tableView willDisplayCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath {
+	// Reloading the feed drops the table's selection, the picked URLs survive it.
+	TRBRSSItem * item = _rss.items[indexPath.row];
+	if (tableView.editing && [_selectionController isURLSelected:item.link])
+		[tableView selectRowAtIndexPath:indexPath animated:NO scrollPosition:UITableViewScrollPositionNone];
+}
+
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath {
+	if (tableView.editing) {
+		TRBRSSItem * item = _rss.items[indexPath.row];
+		[_selectionController selectURL:item.link];
+		return;
+	}
 	UIViewController * destination = [self.tmTabBarController newWebViewController];
 	destination.title = @"Comments";
 	TRBRSSItem * item = _rss.items[indexPath.row];
@@ -155,6 +176,13 @@
 	[self.navigationController pushViewController:destination animated:YES];
 }
 
+- (void)tableView:(UITableView *)tableView didDeselectRowAtIndexPath:(NSIndexPath *)indexPath {
+	if (tableView.editing) {
+		TRBRSSItem * item = _rss.items[indexPath.row];
+		[_selectionController deselectURL:item.link];
+	}
+}
+
 - (void)tableView:(UITableView *)tableView accessoryButtonTappedForRowWithIndexPath:(NSIndexPath *)indexPath {
 	[tableView selectRowAtIndexPath:indexPath animated:YES scrollPosition:UITableViewScrollPositionNone];
 	TRBRSSItem * item = _rss.items[indexPath.row];
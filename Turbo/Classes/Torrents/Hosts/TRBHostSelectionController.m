@@ -47,6 +47,7 @@
 @property (weak, nonatomic) IBOutlet UITextField * portTextField;
 @property (weak, nonatomic) IBOutlet UITextField * pathTextField;
 
+@property (nonatomic, strong) UISegmentedControl * hostType;
 @property (nonatomic, strong) TRBHost * host;
 
 - (IBAction)textChanged:(UITextField *)sender;
@@ -62,6 +63,10 @@
 
 - (void)viewDidLoad {
     [super viewDidLoad];
+	_hostType = [[UISegmentedControl alloc] initWithItems:@[@"Transmission", @"qBittorrent"]];
+	_hostType.selectedSegmentIndex = 0;
+	[_hostType addTarget:self action:@selector(hostTypeChanged:) forControlEvents:UIControlEventValueChanged];
+	self.navigationItem.titleView = _hostType;
 	_host = [[TRBTransmissionHost alloc] init];
 }
 
@@ -80,6 +85,14 @@
 	_saveButton.enabled = [_domainTextField.text length] && [_portTextField.text length] && [_pathTextField.text length];
 }
 
+- (void)hostTypeChanged:(UISegmentedControl *)sender {
+	NSString * previousPath = _host.path;
+	_host = sender.selectedSegmentIndex == 0 ? [[TRBTransmissionHost alloc] init] : [[TRBQBittorrentHost alloc] init];
+	if (![_pathTextField.text length] || [_pathTextField.text isEqualToString:previousPath])
+		_pathTextField.text = _host.path;
+	[self textChanged:_pathTextField];
+}
+
 - (IBAction)saveButtonPressed:(id)sender {
 	_host.protocol = _protocol.selectedSegmentIndex;
 	_host.domain = _domainTextField.text;
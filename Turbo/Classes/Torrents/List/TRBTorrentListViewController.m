@@ -31,22 +31,41 @@
 #import "TKAlertCenter.h"
 #import "Reachability.h"
 #import "NSString+TRBUnits.h"
+#import "TRBArrayDiff.h"
+#import "TRBFrameTimeMonitor.h"
+#import "TRBHostPoller.h"
+#import "TRBTorrentDashboard.h"
+
+static NSArray * TRBIndexPathsInSection(NSIndexSet * indexes, NSInteger section) {
+	NSMutableArray * result = [[NSMutableArray alloc] initWithCapacity:[indexes count]];
+	[indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL * stop) {
+		[result addObject:[NSIndexPath indexPathForRow:idx inSection:section]];
+	}];
+	return result;
+}
 
-@interface TRBTorrentListViewController ()<TRBHostListDelegate>
+@interface TRBTorrentListViewController ()<TRBHostListDelegate, TRBHostPollerDelegate>
 
 @end
 
 @implementation TRBTorrentListViewController {
 	TRBHostList * _hostList;
 	NSMutableArray * _sections;
-	NSTimer * _refreshTimer;
+	NSMutableArray * _pollers;
 	Reachability * _wifiReach;
 	NetworkStatus _netStatus;
 	NSTimeInterval _wifiRefreshRate;
 	NSTimeInterval _cellularRefreshRate;
 	id _observer;
 	UINavigationController * _hostListNavigationController;
-	NSIndexPath * _toDelete;
+	TRBTorrent * _toDelete;
+	TRBHost * _toDeleteHost;
+	TRBFrameTimeMonitor * _frameTimeMonitor;
+	TRBTorrentDashboard * _dashboard;
+	NSArray * _allItems;
+	BOOL _showsAllTorrents;
+	UISegmentedControl * _sortControl;
+	UILabel * _summaryLabel;
 }
 
 - (void)dealloc {
@@ -60,6 +79,10 @@
 	_hostList = [TRBHostList new];
 	_hostList.delegate = self;
 	_sections = [NSMutableArray arrayWithCapacity:[_hostList activeHostCount]];
+	_pollers = [NSMutableArray arrayWithCapacity:[_hostList activeHostCount]];
+	_dashboard = [TRBTorrentDashboard new];
+	_allItems = @[];
+	[self setupDashboardHeader];
 	_wifiReach = [Reachability reachabilityForLocalWiFi];
 	_netStatus = [_wifiReach currentReachabilityStatus];
 	_wifiRefreshRate = (NSTimeInterval)[[NSUserDefaults standardUserDefaults] doubleForKey:TRBWiFiRefreshRateKey];
@@ -78,12 +101,16 @@
 																  NSNumber * cellular = [note userInfo][TRBCellularRefreshRateKey];
 																  if (cellular)
 																	  _cellularRefreshRate = [cellular doubleValue];
+																  [self updateRefreshIntervals];
 															  }];
 	if (self.revealingViewController)
 		_hostListNavigationController = [self.storyboard instantiateViewControllerWithIdentifier:@"TRBHostListNavController"];
 	else if (self.splitViewController)
 		_hostListNavigationController = [self.splitViewController viewControllers][0];
 	((TRBHostListViewController *)[_hostListNavigationController.viewControllers firstObject]).hostList = _hostList;
+#ifdef TRBDebug
+	_frameTimeMonitor = [[TRBFrameTimeMonitor alloc] initWithName:@"Torrent list"];
+#endif
 }
 
 - (void)viewWillAppear:(BOOL)animated {
@@ -115,9 +142,17 @@
 #pragma mark - TRBHostListDelegate Implementation
 
 - (void)hostListDidChangeActiveHosts:(TRBHostList *)hostList {
+	NSArray * activeHosts = [_hostList activeHosts];
+	for (TRBHost * host in [_dashboard hosts]) {
+		if ([activeHosts indexOfObjectIdenticalTo:host] == NSNotFound)
+			[_dashboard removeHost:host];
+	}
+	[self updateSummary];
 	[self updateSections];
-	if ([_hostList activeHostCount] && self.tabBarController.selectedViewController == self.splitViewController)
-		[self fetchTorrentList];
+	if (self.tabBarController.selectedViewController == self.splitViewController)
+		[self startPolling];
+	else
+		[self syncPollers];
 }
 
 #pragma mark - TRBCoverViewControllerDelegate Implementation
@@ -135,22 +170,25 @@
 #pragma mark - UITableViewDelegate & UITableViewDataSource Implementation
 
 - (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView {
-	return [_sections count];
+	return _showsAllTorrents ? 1 : [_sections count];
 }
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
 	NSInteger result = 0;
-	id list = _sections[section];
-	if (list != [NSNull null])
-		result = [((NSArray *)list) count];
+	if (_showsAllTorrents)
+		result = [_allItems count];
+	else {
+		id list = _sections[section];
+		if (list != [NSNull null])
+			result = [((NSArray *)list) count];
+	}
 	return result;
 }
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
 	static NSString * const CellIdentifier = @"TorrentCell";
 	TRBTorrentListCell * cell = [tableView dequeueReusableCellWithIdentifier:CellIdentifier];
-	TRBTorrent * torrent = _sections[indexPath.section][indexPath.row];
-	[cell setupWithTorrent:torrent];
+	[cell setupWithTorrent:[self torrentAtIndexPath:indexPath]];
 	return cell;
 }
 
@@ -164,20 +202,22 @@
 
 - (void)tableView:(UITableView *)tableView commitEditingStyle:(UITableViewCellEditingStyle)editingStyle forRowAtIndexPath:(NSIndexPath *)indexPath {
 	if (editingStyle == UITableViewCellEditingStyleDelete) {
-		TRBTorrent * torrent = _sections[indexPath.section][indexPath.row];
+		TRBTorrent * torrent = [self torrentAtIndexPath:indexPath];
 		NSString * message = [NSString stringWithFormat:@"Delete %@", torrent.name];
 		UIAlertView * alert = [[UIAlertView alloc] initWithTitle:@"Delete"
 														 message:message
 														delegate:self
 											   cancelButtonTitle:@"Cancel"
 											   otherButtonTitles:@"Delete from list", nil];
-		_toDelete = indexPath;
+		// The list reorders while the alert is up, so the row is resolved now.
+		_toDelete = torrent;
+		_toDeleteHost = [self hostAtIndexPath:indexPath];
 		[alert show];
 	}
 }
 
 - (NSString *)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section {
-	return [_hostList activeHostAtIndex:section].domain;
+	return _showsAllTorrents ? @"All torrents" : [_hostList activeHostAtIndex:section].domain;
 }
 
 #pragma mark - IBActions
@@ -204,16 +244,16 @@
 #pragma mark - UIAlertViewDelegate
 
 - (void)alertView:(UIAlertView *)alertView clickedButtonAtIndex:(NSInteger)buttonIndex {
-	if (buttonIndex && _toDelete) {
-		TRBTorrent * torrent = _sections[_toDelete.section][_toDelete.row];
-		[[_hostList activeHostAtIndex:_toDelete.section].client removeTorrent:torrent
-																   completion:^(BOOL success, NSError * error) {
-																	   if (success) {
-																		   [[TKAlertCenter defaultCenter] postAlertWithMessage:@"Torrent removed"];
-																	   }
-																   }];
+	if (buttonIndex && _toDelete && [self isTorrentListed:_toDelete]) {
+		[_toDeleteHost.client removeTorrent:_toDelete
+								 completion:^(BOOL success, NSError * error) {
+									 if (success) {
+										 [[TKAlertCenter defaultCenter] postAlertWithMessage:@"Torrent removed"];
+									 }
+								 }];
 	}
 	_toDelete = nil;
+	_toDeleteHost = nil;
 }
 
 #pragma mark - Private Methods
@@ -224,12 +264,14 @@
 		NSUInteger start = [_sections count];
 		for (NSUInteger i = start; i < count; ++i)
 			[_sections addObject:[NSNull null]];
-		[self.tableView insertSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(start, count - start)] withRowAnimation:UITableViewRowAnimationNone];
+		if (!_showsAllTorrents)
+			[self.tableView insertSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(start, count - start)] withRowAnimation:UITableViewRowAnimationNone];
 	} else if ([_sections count] > count) {
 		NSUInteger end = [_sections count];
 		for (NSUInteger i = count; i < end; ++i)
 			[_sections removeLastObject];
-		[self.tableView deleteSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(count, end - count)] withRowAnimation:UITableViewRowAnimationNone];
+		if (!_showsAllTorrents)
+			[self.tableView deleteSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(count, end - count)] withRowAnimation:UITableViewRowAnimationNone];
 	}
 }
 
@@ -239,65 +281,219 @@
 												 name:kReachabilityChangedNotification
 											   object:_wifiReach];
 	[_wifiReach startNotifier];
-	[self fetchTorrentList];
+	[_frameTimeMonitor start];
+	[self startPolling];
 }
 
 - (void)stop {
-	[_refreshTimer invalidate];
+	[_pollers makeObjectsPerformSelector:@selector(stop)];
+	[_frameTimeMonitor stop];
 	[_wifiReach stopNotifier];
 	[[NSNotificationCenter defaultCenter] removeObserver:self];
 	[[_hostList activeHosts] enumerateObjectsUsingBlock:^(TRBHost * host, NSUInteger idx, BOOL *stop) {
 		host.error = nil;
-		[host.client reset];
+		// Delta sync state stays valid while hidden, keeping it avoids a full snapshot on every return.
+		if (!(host.client.capabilities & TRBTorrentClientCapabilityDeltaSync))
+			[host.client reset];
 	}];
 }
 
-- (void)refreshTimerFired:(NSTimer *)timer {
-	if ((!self.revealingViewController || self.revealingViewController.state == TRBRevealingViewControllerStateConcealed) &&
-		self.tabBarController.selectedViewController == self.parentViewController) {
-		[self fetchTorrentList];
+- (void)syncPollers {
+	NSArray * hosts = [_hostList activeHosts];
+	NSMutableArray * pollers = [[NSMutableArray alloc] initWithCapacity:[hosts count]];
+	for (TRBHost * host in hosts) {
+		TRBHostPoller * poller = nil;
+		for (TRBHostPoller * candidate in _pollers) {
+			if (candidate.host == host) {
+				poller = candidate;
+				break;
+			}
+		}
+		if (!poller) {
+			poller = [[TRBHostPoller alloc] initWithHost:host];
+			poller.delegate = self;
+		}
+		[pollers addObject:poller];
+	}
+	for (TRBHostPoller * poller in _pollers) {
+		if (![pollers containsObject:poller])
+			[poller stop];
 	}
+	_pollers = pollers;
+	[self updateRefreshIntervals];
 }
 
-- (void)fetchTorrentList {
-	[_refreshTimer invalidate];
-	NSArray * hosts = [_hostList activeHosts];
-	NSMutableSet * remaining = [NSMutableSet setWithArray:hosts];
-	BOOL __block rescheduleTimer = NO;
-	[hosts enumerateObjectsUsingBlock:^(TRBHost * host, NSUInteger idx, BOOL * stop) {
-		if (!host.error) {
-			[host.client fetchTorrentsWithCompletion:^(NSArray * torrents, NSError * error) {
-				[remaining removeObject:host];
-				host.error = error;
-				if (!error) {
-					[_sections replaceObjectAtIndex:idx withObject:torrents];
-					if (!rescheduleTimer)
-						rescheduleTimer = YES;
-				} else
-					[_sections replaceObjectAtIndex:idx withObject:[NSNull null]];
-				if (!self.tableView.editing)
-					[self.tableView reloadSections:[NSIndexSet indexSetWithIndex:idx] withRowAnimation:UITableViewRowAnimationNone];
-				if ([remaining count] == 0 && rescheduleTimer) {
-					NSTimeInterval delay = [self isUsingWiFi] ? _wifiRefreshRate : _cellularRefreshRate;
-					_refreshTimer = [NSTimer scheduledTimerWithTimeInterval:delay
-																	 target:self
-																   selector:@selector(refreshTimerFired:)
-																   userInfo:nil
-																	repeats:NO];
-				}
+- (void)startPolling {
+	[self syncPollers];
+	[_pollers makeObjectsPerformSelector:@selector(start)];
+}
+
+- (void)updateRefreshIntervals {
+	NSTimeInterval interval = [self isUsingWiFi] ? _wifiRefreshRate : _cellularRefreshRate;
+	for (TRBHostPoller * poller in _pollers)
+		poller.refreshInterval = interval;
+}
+
+#pragma mark - TRBHostPollerDelegate Implementation
+
+- (void)hostPoller:(TRBHostPoller *)poller didFetchTorrents:(NSArray *)torrents error:(NSError *)error {
+	NSUInteger section = [[_hostList activeHosts] indexOfObjectIdenticalTo:poller.host];
+	if (section == NSNotFound)
+		return;
+	if (torrents)
+		[_dashboard updateHost:poller.host withTorrents:torrents];
+	else
+		[_dashboard removeHost:poller.host];
+	[self updateSummary];
+	if (_showsAllTorrents) {
+		if (section < [_sections count])
+			[_sections replaceObjectAtIndex:section withObject:torrents ? torrents : [NSNull null]];
+		[self updateAllTorrents];
+	} else
+		[self updateSection:section withTorrents:torrents];
+}
+
+- (BOOL)hostPollerShouldPoll:(TRBHostPoller *)poller {
+	return (!self.revealingViewController || self.revealingViewController.state == TRBRevealingViewControllerStateConcealed) &&
+		self.tabBarController.selectedViewController == self.parentViewController;
+}
+
+- (void)updateSection:(NSUInteger)section withTorrents:(NSArray *)torrents {
+	if (section >= [_sections count] || self.tableView.editing)
+		return;
+	CFTimeInterval start = CACurrentMediaTime();
+	id list = _sections[section];
+	id newList = torrents ? torrents : [NSNull null];
+	if (list == [NSNull null] || newList == [NSNull null]) {
+		[_sections replaceObjectAtIndex:section withObject:newList];
+		if (list != newList)
+			[self.tableView reloadSections:[NSIndexSet indexSetWithIndex:section] withRowAnimation:UITableViewRowAnimationNone];
+	} else {
+		// Clients update torrents in place and hand back the same array until one is added or removed.
+		TRBArrayDiff * diff = list != torrents ? [TRBArrayDiff diffFromArray:list toArray:torrents contentEqual:nil] : nil;
+		[_sections replaceObjectAtIndex:section withObject:torrents];
+		UITableView * tableView = self.tableView;
+		if ([diff hasStructuralChanges]) {
+			[tableView beginUpdates];
+			[tableView deleteRowsAtIndexPaths:TRBIndexPathsInSection(diff.deletedIndexes, section) withRowAnimation:UITableViewRowAnimationNone];
+			[tableView insertRowsAtIndexPaths:TRBIndexPathsInSection(diff.insertedIndexes, section) withRowAnimation:UITableViewRowAnimationNone];
+			[diff enumerateMovesUsingBlock:^(NSUInteger fromIndex, NSUInteger toIndex) {
+				[tableView moveRowAtIndexPath:[NSIndexPath indexPathForRow:fromIndex inSection:section]
+								  toIndexPath:[NSIndexPath indexPathForRow:toIndex inSection:section]];
 			}];
-		} else {
-			[remaining removeObject:host];
-			if ([remaining count] == 0) {
-				NSTimeInterval delay = [self isUsingWiFi] ? _wifiRefreshRate : _cellularRefreshRate;
-				_refreshTimer = [NSTimer scheduledTimerWithTimeInterval:delay
-																 target:self
-															   selector:@selector(refreshTimerFired:)
-															   userInfo:nil
-																repeats:NO];
-			}
+			[tableView endUpdates];
 		}
-	}];
+		[self refreshVisibleCellsInSection:section];
+	}
+	[_frameTimeMonitor recordUpdateDuration:(CACurrentMediaTime() - start)];
+}
+
+- (void)updateAllTorrents {
+	if (self.tableView.editing)
+		return;
+	CFTimeInterval start = CACurrentMediaTime();
+	NSArray * items = [_dashboard allItems];
+	TRBArrayDiff * diff = _allItems != items ? [TRBArrayDiff diffFromArray:_allItems toArray:items contentEqual:nil] : nil;
+	_allItems = items;
+	UITableView * tableView = self.tableView;
+	if ([diff hasStructuralChanges]) {
+		[tableView beginUpdates];
+		[tableView deleteRowsAtIndexPaths:TRBIndexPathsInSection(diff.deletedIndexes, 0) withRowAnimation:UITableViewRowAnimationNone];
+		[tableView insertRowsAtIndexPaths:TRBIndexPathsInSection(diff.insertedIndexes, 0) withRowAnimation:UITableViewRowAnimationNone];
+		[diff enumerateMovesUsingBlock:^(NSUInteger fromIndex, NSUInteger toIndex) {
+			[tableView moveRowAtIndexPath:[NSIndexPath indexPathForRow:fromIndex inSection:0]
+							  toIndexPath:[NSIndexPath indexPathForRow:toIndex inSection:0]];
+		}];
+		[tableView endUpdates];
+	}
+	[self refreshVisibleCellsInSection:0];
+	[_frameTimeMonitor recordUpdateDuration:(CACurrentMediaTime() - start)];
+}
+
+// Cells skip the torrents whose revision they already show, so only changed rows do any work.
+- (void)refreshVisibleCellsInSection:(NSUInteger)section {
+	UITableView * tableView = self.tableView;
+	for (NSIndexPath * indexPath in [tableView indexPathsForVisibleRows]) {
+		if (indexPath.section == section)
+			[(TRBTorrentListCell *)[tableView cellForRowAtIndexPath:indexPath] setupWithTorrent:[self torrentAtIndexPath:indexPath]];
+	}
+}
+
+- (TRBTorrent *)torrentAtIndexPath:(NSIndexPath *)indexPath {
+	return _showsAllTorrents ? ((TRBDashboardItem *)_allItems[indexPath.row]).torrent : _sections[indexPath.section][indexPath.row];
+}
+
+- (TRBHost *)hostAtIndexPath:(NSIndexPath *)indexPath {
+	return _showsAllTorrents ? ((TRBDashboardItem *)_allItems[indexPath.row]).host : [_hostList activeHostAtIndex:indexPath.section];
+}
+
+- (BOOL)isTorrentListed:(TRBTorrent *)torrent {
+	if (_showsAllTorrents) {
+		for (TRBDashboardItem * item in _allItems) {
+			if (item.torrent == torrent)
+				return YES;
+		}
+	} else {
+		for (id list in _sections) {
+			if (list != [NSNull null] && [list indexOfObjectIdenticalTo:torrent] != NSNotFound)
+				return YES;
+		}
+	}
+	return NO;
+}
+
+- (void)setupDashboardHeader {
+	CGFloat width = CGRectGetWidth(self.tableView.bounds);
+	UIView * header = [[UIView alloc] initWithFrame:CGRectMake(0.0, 0.0, width, 126.0)];
+	header.autoresizingMask = UIViewAutoresizingFlexibleWidth;
+	UISegmentedControl * modeControl = [[UISegmentedControl alloc] initWithItems:@[@"By host", @"All torrents"]];
+	modeControl.frame = CGRectMake(10.0, 8.0, width - 20.0, 29.0);
+	modeControl.autoresizingMask = UIViewAutoresizingFlexibleWidth;
+	modeControl.selectedSegmentIndex = 0;
+	[modeControl addTarget:self action:@selector(modeChanged:) forControlEvents:UIControlEventValueChanged];
+	[header addSubview:modeControl];
+	_sortControl = [[UISegmentedControl alloc] initWithItems:@[@"Name", @"Done", @"Down", @"Up", @"ETA"]];
+	_sortControl.frame = CGRectMake(10.0, 45.0, width - 20.0, 29.0);
+	_sortControl.autoresizingMask = UIViewAutoresizingFlexibleWidth;
+	_sortControl.selectedSegmentIndex = _dashboard.sortKey;
+	_sortControl.enabled = NO;
+	[_sortControl addTarget:self action:@selector(sortKeyChanged:) forControlEvents:UIControlEventValueChanged];
+	[header addSubview:_sortControl];
+	_summaryLabel = [[UILabel alloc] initWithFrame:CGRectMake(10.0, 80.0, width - 20.0, 42.0)];
+	_summaryLabel.autoresizingMask = UIViewAutoresizingFlexibleWidth;
+	_summaryLabel.font = [UIFont preferredFontForTextStyle:UIFontTextStyleCaption1];
+	_summaryLabel.numberOfLines = 2;
+	[header addSubview:_summaryLabel];
+	self.tableView.tableHeaderView = header;
+	[self updateSummary];
+}
+
+- (void)modeChanged:(UISegmentedControl *)sender {
+	_showsAllTorrents = sender.selectedSegmentIndex == 1;
+	_sortControl.enabled = _showsAllTorrents;
+	_allItems = _showsAllTorrents ? [_dashboard allItems] : @[];
+	[self.tableView reloadData];
+}
+
+- (void)sortKeyChanged:(UISegmentedControl *)sender {
+	_dashboard.sortKey = sender.selectedSegmentIndex;
+	if (_showsAllTorrents)
+		[self updateAllTorrents];
+}
+
+- (void)updateSummary {
+	_summaryLabel.text = [NSString stringWithFormat:@"Down: %@ Up: %@, %lu torrents: %lu downloading, %lu seeding, %lu stopped\nETA: %lu within 1h, %lu within 1d, %lu within 1w, %lu later, %lu unknown",
+						  [NSString stringWithTransferRate:_dashboard.rateDownload],
+						  [NSString stringWithTransferRate:_dashboard.rateUpload],
+						  (unsigned long)_dashboard.torrentCount,
+						  (unsigned long)([_dashboard countForStatus:TRBTorrentStatusDownload] + [_dashboard countForStatus:TRBTorrentStatusDownloadWait]),
+						  (unsigned long)([_dashboard countForStatus:TRBTorrentStatusSeed] + [_dashboard countForStatus:TRBTorrentStatusSeedWait]),
+						  (unsigned long)[_dashboard countForStatus:TRBTorrentStatusStopped],
+						  (unsigned long)[_dashboard countForETABucket:TRBTorrentETABucketHour],
+						  (unsigned long)[_dashboard countForETABucket:TRBTorrentETABucketDay],
+						  (unsigned long)[_dashboard countForETABucket:TRBTorrentETABucketWeek],
+						  (unsigned long)[_dashboard countForETABucket:TRBTorrentETABucketLonger],
+						  (unsigned long)[_dashboard countForETABucket:TRBTorrentETABucketUnknown]];
 }
 
 - (BOOL)isUsingWiFi {
@@ -306,6 +502,7 @@
 
 - (void)reachabilityChanged:(NSNotification *)notification {
 	_netStatus = [_wifiReach currentReachabilityStatus];
+	[self updateRefreshIntervals];
 }
 
 @end
@@ -327,7 +524,14 @@ static NSString * const StatusStrings[TRBTorrentStatusCount] = {
 #define SanitizeStatus(status) (((status) >= 0 && (status) < TRBTorrentStatusCount) ? (status) : 0)
 #define StatusString(status) StatusStrings[SanitizeStatus(status)]
 
-@implementation TRBTorrentListCell
+static TRBTorrentField const TRBTorrentListCellPeersFields = TRBTorrentFieldStatus | TRBTorrentFieldPeersSendingToUs | TRBTorrentFieldPeersConnected;
+static TRBTorrentField const TRBTorrentListCellRatesFields = TRBTorrentFieldErrorString | TRBTorrentFieldRateDownload | TRBTorrentFieldRateUpload;
+static TRBTorrentField const TRBTorrentListCellProgressFields = TRBTorrentFieldHaveValid | TRBTorrentFieldSizeWhenDone | TRBTorrentFieldPercentDone;
+
+@implementation TRBTorrentListCell {
+	TRBTorrent * _torrent;
+	NSUInteger _revision;
+}
 
 - (id)initWithCoder:(NSCoder *)aDecoder {
     self = [super initWithCoder:aDecoder];
@@ -338,6 +542,7 @@ static NSString * const StatusStrings[TRBTorrentStatusCount] = {
 
 - (void)prepareForReuse {
 	[super prepareForReuse];
+	_torrent = nil;
 	_nameLabel.text = nil;
 	_peersLabel.text = nil;
 	_ratesLabel.text = nil;
@@ -348,23 +553,36 @@ static NSString * const StatusStrings[TRBTorrentStatusCount] = {
 #pragma mark - Public Methods
 
 - (void)setupWithTorrent:(TRBTorrent *)torrent {
-	_nameLabel.text = torrent.name;
-	NSString * peersLabelText = @"";
-	TRBTorrentStatus status = torrent.status;
-	if (status != TRBTorrentStatusDownload && status != TRBTorrentStatusSeed)
-		peersLabelText = StatusString(status);
-	else
-		peersLabelText = [NSString stringWithFormat:PeersLabelFmt, (long)[torrent.peersSendingToUs integerValue], (long)[torrent.peersConnected integerValue]];
-	_peersLabel.text = peersLabelText;
-	NSString * error = torrent.errorString;
-	if ([error length])
-		_ratesLabel.text = error;
-	else
-		_ratesLabel.text = [self rateStringWithDown:[torrent.rateDownload longLongValue] andUp:[torrent.rateUpload longLongValue]];
-	_downloadedLabel.text = [self donwloadedStringWithCurrentSize:[torrent.haveValid longLongValue]
-														totalSize:[torrent.sizeWhenDone longLongValue]
-													   andPercent:[torrent.percentDone floatValue]];
-	[_progressView setProgress:[torrent.percentDone floatValue] animated:NO];
+	TRBTorrentField changed = TRBTorrentFieldAll;
+	// changedFields only covers the latest revision, a cell that missed one redraws everything.
+	if (torrent == _torrent)
+		changed = torrent.revision == _revision ? 0 : (torrent.revision == _revision + 1 ? torrent.changedFields : TRBTorrentFieldAll);
+	_torrent = torrent;
+	_revision = torrent.revision;
+	if (changed & TRBTorrentFieldName)
+		_nameLabel.text = torrent.name;
+	if (changed & TRBTorrentListCellPeersFields) {
+		NSString * peersLabelText = @"";
+		TRBTorrentStatus status = torrent.status;
+		if (status != TRBTorrentStatusDownload && status != TRBTorrentStatusSeed)
+			peersLabelText = StatusString(status);
+		else
+			peersLabelText = [NSString stringWithFormat:PeersLabelFmt, (long)[torrent.peersSendingToUs integerValue], (long)[torrent.peersConnected integerValue]];
+		_peersLabel.text = peersLabelText;
+	}
+	if (changed & TRBTorrentListCellRatesFields) {
+		NSString * error = torrent.errorString;
+		if ([error length])
+			_ratesLabel.text = error;
+		else
+			_ratesLabel.text = [self rateStringWithDown:[torrent.rateDownload longLongValue] andUp:[torrent.rateUpload longLongValue]];
+	}
+	if (changed & TRBTorrentListCellProgressFields) {
+		_downloadedLabel.text = [self donwloadedStringWithCurrentSize:[torrent.haveValid longLongValue]
+															totalSize:[torrent.sizeWhenDone longLongValue]
+														   andPercent:[torrent.percentDone floatValue]];
+		[_progressView setProgress:[torrent.percentDone floatValue] animated:NO];
+	}
 }
 
 #pragma mark - Private Methods
@@ -24,37 +24,33 @@
 #import "TRBSearchViewController.h"
 #import "TRBRSSFeed.h"
 #import "NSString+TRBAdditions.h"
+#import "NSString+TRBUnits.h"
 #import "TRBSearchOptionsViewController.h"
 #import "TRBTabBarController.h"
 #import "TRBNavigationController.h"
-#import "TRBHTTPSession.h"
+#import "TRBTorrentSearchEngine.h"
+#import "TRBPagedResultStore.h"
 #import "TRBHost.h"
 #import "TRBTorrentClient.h"
+#import "TRBTorrentSelectionController.h"
 #import "TKAlertCenter.h"
 
-#define kMaxResultsPerSearch 100
-
-__attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIndexPath * indexPath) {
-	NSInteger row = indexPath.row;
-	NSInteger index1 = row / kMaxResultsPerSearch;
-	NSInteger index2 = row - (index1 * kMaxResultsPerSearch);
-	return [NSIndexPath indexPathForRow:index2 inSection:index1];
-}
+#define kMinIncrementalQueryLength 3
 
 @interface TRBSearchViewController ()
 @property (nonatomic, weak, readonly) TRBSearchOptionsViewController * searchOptionsViewController;
 @end
 
 @implementation TRBSearchViewController {
-	NSMutableArray * _searchResults;
+	TRBPagedResultStore * _searchResults;
 	NSString * _currentQuery;
-	NSNumber * _page;
-	BOOL _isSearching;
+	BOOL _typing;
+	BOOL _scrollToTop;
 	UISearchBar * _searchBar;
-	NSInteger _currentCount;
 	id _observer;
 	UINavigationController * _searchOptionsNavController;
-	TRBHTTPSession * _session;
+	TRBTorrentSearchEngine * _searchEngine;
+	TRBTorrentSelectionController * _selectionController;
 }
 
 @dynamic searchOptionsViewController;
@@ -62,7 +58,11 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 - (id)initWithCoder:(NSCoder *)aDecoder {
     self = [super initWithCoder:aDecoder];
     if (self) {
-        _searchResults = [NSMutableArray new];
+        _searchResults = [TRBPagedResultStore new];
+		// Sites list the same torrent on different pages.
+		_searchResults.keyForItem = ^NSString *(TRBRSSItem * item) {
+			return [item infoHash];
+		};
 		_searchBar = [[UISearchBar alloc] init];
 		_searchBar.barStyle = UIBarStyleDefault;
 		_searchBar.delegate = self;
@@ -82,15 +82,15 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 																		  [self restartSearch];
 																	  }
 																  }];
-		_session = [[TRBHTTPSession alloc] initWithConfiguration:nil];
-		_session.acceptedHTTPStatusCodes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(200, 100)];
+		_searchEngine = [TRBTorrentSearchEngine new];
+		_selectionController = [[TRBTorrentSelectionController alloc] initWithViewController:self];
     }
     return self;
 }
 
 - (void)dealloc {
     [[NSNotificationCenter defaultCenter] removeObserver:_observer];
-	[_session invalidateAndCancel];
+	[_searchEngine cancel];
 }
 
 #pragma mark - View Lifecycle
@@ -109,6 +109,7 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 	[controller setOptionsUpadated:^(NSDictionary * options) {
 		[selfWeak restartSearch];
 	}];
+	[_selectionController installButtons];
 }
 
 - (void)viewWillAppear:(BOOL)animated {
@@ -116,6 +117,11 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 	self.revealingViewController.rightViewController = _searchOptionsNavController;
 }
 
+- (void)setEditing:(BOOL)editing animated:(BOOL)animated {
+	[super setEditing:editing animated:animated];
+	[_selectionController setEditing:editing animated:animated];
+}
+
 #pragma mark - Dynamic Properties
 
 - (TRBSearchOptionsViewController *)searchOptionsViewController {
@@ -133,45 +139,47 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 
 - (void)searchBarSearchButtonClicked:(UISearchBar *)searchBar {
 	_currentQuery = searchBar.text;
+	[searchBar resignFirstResponder];
 	[self restartSearch];
 }
 
+- (void)searchBar:(UISearchBar *)searchBar textDidChange:(NSString *)searchText {
+	_currentQuery = searchText;
+	if ([[searchText stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] length] >= kMinIncrementalQueryLength) {
+		[self resetResults];
+		_typing = YES;
+		NSUInteger page = [_searchResults beginNextPage];
+		[_searchEngine searchQueryDebounced:_currentQuery options:self.searchOptionsViewController.options page:page completion:^(TRBRSSFeed * feed, BOOL finished, NSError * error) {
+			[self handleSearchResult:feed page:page finished:finished error:error];
+		}];
+	} else if (![searchText length]) {
+		[_searchEngine cancel];
+		[self resetResults];
+	}
+}
+
 - (void)searchBarCancelButtonClicked:(UISearchBar *)searchBar {
 	[searchBar resignFirstResponder];
 }
 
 #pragma mark - UIScrollViewDelegate
 
-
-
 - (void)scrollViewWillBeginDragging:(UIScrollView *)scrollView {
 	[_searchBar resignFirstResponder];
 }
 
-- (void)scrollViewDidScroll:(UIScrollView *)scrollView {
-	if (!_isSearching && _currentCount && ((_currentCount % kMaxResultsPerSearch) == 0)) {
-		CGFloat actualPosition = scrollView.contentOffset.y;
-		CGFloat contentHeight = scrollView.contentSize.height - (self.tableView.rowHeight * 6.0);
-		if (actualPosition >= contentHeight) {
-			_page = @([_page unsignedIntegerValue] + 1);
-			[self startSearch];
-		}
-	}
-}
-
 #pragma mark - Table view data source
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
-	return _currentCount;
+	return _searchResults.count;
 }
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
     static NSString * CellResultIdentifier = @"SearchResult";
 	UITableViewCell * cell = nil;
-	if (indexPath.row < _currentCount) {
+	if (indexPath.row < _searchResults.count) {
 		TRBSearchCell * resultCell = [tableView dequeueReusableCellWithIdentifier:CellResultIdentifier forIndexPath:indexPath];
-		NSIndexPath * convertedIndexPath = TRBRealIndexPath(indexPath);
-		TRBRSSItem * item = ((TRBRSSFeed *)_searchResults[convertedIndexPath.section]).items[convertedIndexPath.row];
+		TRBRSSItem * item = _searchResults[indexPath.row];
 		[resultCell setupWithRSSItem:item];
 		cell = resultCell;
 	}
@@ -180,11 +188,23 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 
 #pragma mark - Table view delegate
 
+- (void)tableView:(UITableView *)tableView willDisplayCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath {
+	// Loads the next page while there are still rows left to scroll through.
+	if ([_searchResults pageToLoadForDisplayedIndex:indexPath.row] != NSNotFound)
+		[self startSearch];
+	// New pages reload the table, which drops its selection.
+	if (tableView.editing && indexPath.row < _searchResults.count && [_selectionController isURLSelected:[_searchResults[indexPath.row] torrentURL]])
+		[tableView selectRowAtIndexPath:indexPath animated:NO scrollPosition:UITableViewScrollPositionNone];
+}
+
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath {
-	if (indexPath.row < _currentCount) {
+	if (tableView.editing) {
+		if (indexPath.row < _searchResults.count)
+			[_selectionController selectURL:[_searchResults[indexPath.row] torrentURL]];
+	} else if (indexPath.row < _searchResults.count) {
 		UIViewController * destination = [self.tmTabBarController newWebViewController];
 		destination.title = @"Torrent Page";
-		TRBRSSItem * item = ((TRBRSSFeed *)_searchResults[indexPath.section]).items[indexPath.row];
+		TRBRSSItem * item = _searchResults[indexPath.row];
 		UIWebView * webView = (UIWebView *)destination.view;
 		NSURL * url = [NSURL URLWithString:item.link];
 		NSURLRequest * request = [NSURLRequest requestWithURL:url];
@@ -193,11 +213,15 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 	}
 }
 
+- (void)tableView:(UITableView *)tableView didDeselectRowAtIndexPath:(NSIndexPath *)indexPath {
+	if (tableView.editing && indexPath.row < _searchResults.count)
+		[_selectionController deselectURL:[_searchResults[indexPath.row] torrentURL]];
+}
+
 - (void)tableView:(UITableView *)tableView accessoryButtonTappedForRowWithIndexPath:(NSIndexPath *)indexPath {
-	if (indexPath.row < _currentCount) {
+	if (indexPath.row < _searchResults.count) {
 		[tableView selectRowAtIndexPath:indexPath animated:YES scrollPosition:UITableViewScrollPositionNone];
-		indexPath = TRBRealIndexPath(indexPath);
-		TRBRSSItem * item = ((TRBRSSFeed *)_searchResults[indexPath.section]).items[indexPath.row];
+		TRBRSSItem * item = _searchResults[indexPath.row];
 		UIActionSheet * actionSheet = [[UIActionSheet alloc] initWithTitle:item.title
 																  delegate:self
 														 cancelButtonTitle:(isIdiomPhone ? @"Cancel": nil)
@@ -215,8 +239,7 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 - (void)actionSheet:(UIActionSheet *)actionSheet clickedButtonAtIndex:(NSInteger)buttonIndex {
 	NSIndexPath * indexPath = [self.tableView indexPathForSelectedRow];
 	[self.tableView deselectRowAtIndexPath:indexPath animated:YES];
-	indexPath = TRBRealIndexPath(indexPath);
-	TRBRSSItem * item = ((TRBRSSFeed *)_searchResults[indexPath.section]).items[indexPath.row];
+	TRBRSSItem * item = _searchResults[indexPath.row];
 	switch (buttonIndex) {
 		case 0:
 			[self addTorrent:item];
@@ -252,51 +275,50 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 
 - (void)restartSearch {
 	if ([_currentQuery length]) {
-		[_searchResults removeAllObjects];
-		_page = @0;
-		_currentCount = 0;
+		[self resetResults];
+		_typing = NO;
 		[self startSearch];
 	}
 }
 
 #pragma mark - Private Methods
 
+- (void)resetResults {
+	[_searchResults removeAllItems];
+	_scrollToTop = YES;
+	// The table must not keep rows the store no longer has until the next page comes in.
+	[self.tableView reloadData];
+}
+
 - (void)startSearch {
-	if (!_isSearching) {
-		_isSearching = YES;
-		NSDictionary * parameters = @{@"q": [self searchQuery], @"p": [_page description]};
-		[_session GETXML:@"http://torrentz.eu/feed" parameters:parameters completion:^(id data, NSURLResponse * response, NSError * error) {
-			_isSearching = NO;
-			NSString * message = nil;
-			if (!error) {
-				TRBXMLElement * rss = data;
-				TRBRSSFeed * result = [[TRBRSSFeed alloc] initWithXMLElement:rss];
-				if ([result.items count]) {
-					[_searchResults addObject:result];
-					_currentCount += [result.items count];
-				} else
-					message = @"No results";
-				[_searchBar resignFirstResponder];
-			} else {
-				[_searchResults removeAllObjects];
-				message = [error localizedDescription];
-				if (![message length])
-					message = @"Unsupported status code";
-			}
-			if (message)
-				[[TKAlertCenter defaultCenter] postAlertWithMessage:message];
-			[self.tableView reloadData];
-			if (_currentCount && _currentCount <= kMaxResultsPerSearch) {
-				[self.tableView scrollToRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]
-									  atScrollPosition:UITableViewScrollPositionTop animated:YES];
-			}
-		}];
+	NSUInteger page = [_searchResults beginNextPage];
+	[_searchEngine searchQuery:_currentQuery options:self.searchOptionsViewController.options page:page completion:^(TRBRSSFeed * feed, BOOL finished, NSError * error) {
+		[self handleSearchResult:feed page:page finished:finished error:error];
+	}];
+}
+
+- (void)handleSearchResult:(TRBRSSFeed *)result page:(NSUInteger)page finished:(BOOL)finished error:(NSError *)error {
+	NSString * message = nil;
+	if (!error) {
+		[_searchResults setItems:result.items forPage:page finished:finished];
+		if (finished && !_searchResults.count && !_typing)
+			message = @"No results";
+	} else {
+		[_searchResults failPage:page];
+		message = [error localizedDescription];
+	}
+	if (message)
+		[[TKAlertCenter defaultCenter] postAlertWithMessage:message];
+	[self.tableView reloadData];
+	if (_scrollToTop && _searchResults.count) {
+		_scrollToTop = NO;
+		[self.tableView scrollToRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]
+							  atScrollPosition:UITableViewScrollPositionTop animated:YES];
 	}
 }
 
 - (void)addTorrent:(TRBRSSItem *)item {
-	NSDictionary * info = [item infoFromDescription];
-	NSString * url = [NSString stringWithFormat:@"magnet:?xt=urn:btih:%@", [info valueForKey:@"Hash"]];
+	NSString * url = [item torrentURL];
 	[TRBGetAppDelegate() pickHostWithCompletion:^(TRBHost * host) {
 		[host.client addTorrentAtURL:url completion:^(BOOL success, NSError * error) {
 			if (success)
@@ -307,20 +329,6 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 	}];
 }
 
-- (NSString *)searchQuery {
-	NSString * result = _currentQuery;
-	if ([self.searchOptionsViewController.options count]) {
-		NSDictionary * options = self.searchOptionsViewController.options;
-		NSMutableString * query = [NSMutableString stringWithFormat:@"%@ ", result];
-		[options enumerateKeysAndObjectsUsingBlock:^(NSString * key, NSString * option, BOOL *stop) {
-			[query appendString:option];
-			[query appendString:@" "];
-		}];
-		result = query;
-	}
-	return result;
-}
-
 - (void)searchOnIMDb:(NSString *)query {
 	BOOL webOnly = [[NSUserDefaults standardUserDefaults] boolForKey:TRBIMDbSearchWebOnlyKey];
 	if ([[UIApplication sharedApplication] canOpenURL:[NSURL URLWithString:@"imdb:///"]] && !webOnly) {
@@ -349,9 +357,12 @@ __attribute__((always_inline)) static inline NSIndexPath * TRBRealIndexPath(NSIn
 - (void)setupWithRSSItem:(TRBRSSItem *)item {
 	NSDictionary * info = [item infoFromDescription];
 	self.title.text = item.title;
-	self.seeds.text = info[@"Seeds"];
-	self.leechers.text = info[@"Peers"];
-	self.size.text = info[@"Size"];
+	self.seeds.text = [@([item seedCount]) description];
+	self.leechers.text = [@([item leechCount]) description];
+	NSString * size = info[@"Size"];
+	if (!size && item.enclosureLength)
+		size = [NSString stringWithByteCount:item.enclosureLength];
+	self.size.text = size;
 	self.date.text = item.pubDate;
 }
 
@@ -0,0 +1,48 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+@class TRBRSSFeed;
+
+// Called each time a provider answers with the merged page so far, deduplicated by info hash
+// and ranked by seeders. error is only set once finished and every provider failed.
+typedef void(^TRBTorrentSearchResultBlock)(TRBRSSFeed * feed, BOOL finished, NSError * error);
+
+// Runs torrent searches one at a time across the search providers, a new search cancels
+// the one in flight and its completion is never called again.
+// Pages are cached per query, options and page.
+@interface TRBTorrentSearchEngine : NSObject
+
+// The enabled providers when nil.
+@property (nonatomic, copy) NSArray * providers;
+@property (nonatomic, assign) NSTimeInterval debounceInterval;
+@property (nonatomic, assign) NSTimeInterval resultsMaxAge;
+@property (nonatomic, assign, readonly, getter = isSearching) BOOL searching;
+
+- (void)searchQuery:(NSString *)query options:(NSDictionary *)options page:(NSUInteger)page completion:(TRBTorrentSearchResultBlock)completion;
+// Waits for debounceInterval without a newer search before starting, for search as you type.
+- (void)searchQueryDebounced:(NSString *)query options:(NSDictionary *)options page:(NSUInteger)page completion:(TRBTorrentSearchResultBlock)completion;
+- (void)cancel;
+- (void)clearCache;
+
+@end
@@ -0,0 +1,230 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrentSearchEngine.h"
+#import "TRBHTTPSession.h"
+#import "TRBRSSFeed.h"
+#import "TRBTorrentSearchProvider.h"
+
+#define DEFAULT_DEBOUNCE_INTERVAL 0.35
+#define DEFAULT_RESULTS_MAX_AGE (10.0 * 60.0)
+
+static NSString * const TRBTorrentSearchFeedKey = @"feed";
+static NSString * const TRBTorrentSearchDateKey = @"date";
+
+@implementation TRBTorrentSearchEngine {
+	TRBHTTPSession * _session;
+	NSMutableArray * _tasks;
+	NSCache * _results;
+	NSUInteger _generation;
+}
+
+- (instancetype)init {
+	self = [super init];
+	if (self) {
+		_session = [[TRBHTTPSession alloc] initWithConfiguration:nil];
+		_session.acceptedHTTPStatusCodes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(200, 100)];
+		_tasks = [NSMutableArray new];
+		_results = [NSCache new];
+		_results.countLimit = 200;
+		_debounceInterval = DEFAULT_DEBOUNCE_INTERVAL;
+		_resultsMaxAge = DEFAULT_RESULTS_MAX_AGE;
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[_session invalidateAndCancel];
+}
+
+#pragma mark - Public Methods
+
+- (void)searchQuery:(NSString *)query options:(NSDictionary *)options page:(NSUInteger)page completion:(TRBTorrentSearchResultBlock)completion {
+	[self cancel];
+	[self startSearchForQuery:query options:options page:page generation:_generation completion:completion];
+}
+
+- (void)searchQueryDebounced:(NSString *)query options:(NSDictionary *)options page:(NSUInteger)page completion:(TRBTorrentSearchResultBlock)completion {
+	[self cancel];
+	options = [options copy];
+	NSUInteger generation = _generation;
+	// Cached pages do not need to wait.
+	if ([self cachedFeedForKey:[self keyForQuery:query options:options page:page providers:[self activeProviders]]]) {
+		[self startSearchForQuery:query options:options page:page generation:generation completion:completion];
+	} else {
+		_searching = YES;
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_debounceInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+			[self startSearchForQuery:query options:options page:page generation:generation completion:completion];
+		});
+	}
+}
+
+- (void)cancel {
+	_generation++;
+	[_tasks makeObjectsPerformSelector:@selector(cancel)];
+	[_tasks removeAllObjects];
+	_searching = NO;
+}
+
+- (void)clearCache {
+	[_results removeAllObjects];
+}
+
+#pragma mark - Private Methods
+
+- (NSArray *)activeProviders {
+	return _providers ? _providers : [TRBTorrentSearchProvider enabledProviders];
+}
+
+- (NSString *)keyForQuery:(NSString *)query options:(NSDictionary *)options page:(NSUInteger)page providers:(NSArray *)providers {
+	NSMutableString * result = [NSMutableString stringWithFormat:@"%lu|%@", (unsigned long)page, [query lowercaseString]];
+	for (NSString * key in [[options allKeys] sortedArrayUsingSelector:@selector(compare:)])
+		[result appendFormat:@"|%@=%@", key, options[key]];
+	for (TRBTorrentSearchProvider * provider in providers)
+		[result appendFormat:@"|%@", provider.identifier];
+	return result;
+}
+
+- (TRBRSSFeed *)cachedFeedForKey:(NSString *)key {
+	NSDictionary * entry = [_results objectForKey:key];
+	TRBRSSFeed * result = nil;
+	if (entry && -[entry[TRBTorrentSearchDateKey] timeIntervalSinceNow] < _resultsMaxAge)
+		result = entry[TRBTorrentSearchFeedKey];
+	else if (entry)
+		[_results removeObjectForKey:key];
+	return result;
+}
+
+- (NSString *)searchStringForQuery:(NSString *)query options:(NSDictionary *)options {
+	NSMutableString * result = [NSMutableString stringWithString:query];
+	for (NSString * key in [[options allKeys] sortedArrayUsingSelector:@selector(compare:)])
+		[result appendFormat:@" %@", options[key]];
+	return result;
+}
+
+- (void)startSearchForQuery:(NSString *)query options:(NSDictionary *)options page:(NSUInteger)page generation:(NSUInteger)generation completion:(TRBTorrentSearchResultBlock)completion {
+	if (generation != _generation)
+		return;
+	NSArray * providers = [self activeProviders];
+	NSString * key = [self keyForQuery:query options:options page:page providers:providers];
+	TRBRSSFeed * cached = [self cachedFeedForKey:key];
+	_searching = YES;
+	if (cached || ![providers count]) {
+		NSError * error = nil;
+		if (!cached) {
+			error = [NSError errorWithDomain:NSStringFromClass([self class])
+										code:-1
+									userInfo:@{NSLocalizedDescriptionKey: @"No search providers enabled"}];
+		}
+		dispatch_async(dispatch_get_main_queue(), ^{
+			if (generation == _generation) {
+				_searching = NO;
+				if (completion)
+					completion(cached, YES, error);
+			}
+		});
+		return;
+	}
+	NSString * searchString = [self searchStringForQuery:query options:options];
+	NSMutableDictionary * hashedItems = [NSMutableDictionary new];
+	NSMutableArray * otherItems = [NSMutableArray new];
+	__block NSUInteger pending = [providers count];
+	__block BOOL succeeded = NO;
+	__block BOOL failed = NO;
+	__block NSError * lastError = nil;
+	for (TRBTorrentSearchProvider * provider in providers) {
+		__block BOOL done = NO;
+		void (^handler)(NSArray *, NSError *) = ^(NSArray * items, NSError * error) {
+			if (generation != _generation || done)
+				return;
+			done = YES;
+			pending--;
+			LogCE(error != nil, [NSString stringWithFormat:@"%@: %@", provider.name, [error localizedDescription]]);
+			if (items) {
+				succeeded = YES;
+				[self mergeItems:items intoHashedItems:hashedItems otherItems:otherItems];
+			} else {
+				failed = YES;
+				lastError = error;
+			}
+			BOOL finished = pending == 0;
+			TRBRSSFeed * feed = [self feedWithHashedItems:hashedItems otherItems:otherItems];
+			if (finished) {
+				_searching = NO;
+				[_tasks removeAllObjects];
+				// A page missing a provider's results would hide them until it expires.
+				if (!failed)
+					[_results setObject:@{TRBTorrentSearchFeedKey: feed, TRBTorrentSearchDateKey: [NSDate date]} forKey:key];
+			}
+			if (completion)
+				completion(feed, finished, finished && !succeeded ? lastError : nil);
+		};
+		NSURLSessionDataTask * task = [provider searchQuery:searchString page:page session:_session completion:handler];
+		if (task)
+			[_tasks addObject:task];
+		// The request timeout only covers idle time, a slow provider must not hold back the others.
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(provider.timeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+			if (generation == _generation && !done) {
+				[task cancel];
+				handler(nil, [NSError errorWithDomain:NSURLErrorDomain
+												 code:NSURLErrorTimedOut
+											 userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"%@ timed out", provider.name]}]);
+			}
+		});
+	}
+}
+
+- (void)mergeItems:(NSArray *)items intoHashedItems:(NSMutableDictionary *)hashedItems otherItems:(NSMutableArray *)otherItems {
+	for (TRBRSSItem * item in items) {
+		NSString * infoHash = [item infoHash];
+		if (infoHash) {
+			// The same torrent listed by several sites, keep the best swarm figures.
+			TRBRSSItem * existing = hashedItems[infoHash];
+			if (!existing || [existing seedCount] < [item seedCount])
+				hashedItems[infoHash] = item;
+		} else
+			[otherItems addObject:item];
+	}
+}
+
+- (TRBRSSFeed *)feedWithHashedItems:(NSDictionary *)hashedItems otherItems:(NSArray *)otherItems {
+	NSMutableArray * items = [NSMutableArray arrayWithArray:[hashedItems allValues]];
+	[items addObjectsFromArray:otherItems];
+	[items sortUsingComparator:^NSComparisonResult(TRBRSSItem * item1, TRBRSSItem * item2) {
+		NSUInteger seeds1 = [item1 seedCount];
+		NSUInteger seeds2 = [item2 seedCount];
+		NSComparisonResult result = NSOrderedSame;
+		if (seeds1 != seeds2)
+			result = seeds1 > seeds2 ? NSOrderedAscending : NSOrderedDescending;
+		else
+			result = [item1.title localizedCaseInsensitiveCompare:item2.title];
+		return result;
+	}];
+	TRBRSSFeed * result = [TRBRSSFeed new];
+	result.title = @"Search";
+	result.items = items;
+	return result;
+}
+
+@end
@@ -0,0 +1,47 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+@class TRBHTTPSession;
+
+// An RSS search feed, %QUERY% and %PAGE% in the template are replaced when searching.
+// file: URLs are read directly so local fixture feeds can stand in for a site.
+@interface TRBTorrentSearchProvider : NSObject
+
+@property (nonatomic, copy, readonly) NSString * identifier;
+@property (nonatomic, copy, readonly) NSString * name;
+@property (nonatomic, copy, readonly) NSString * URLTemplate;
+@property (nonatomic, assign) NSUInteger firstPage;
+@property (nonatomic, assign) NSTimeInterval timeout;
+@property (nonatomic, assign, getter = isEnabled) BOOL enabled;
+
++ (instancetype)providerWithIdentifier:(NSString *)identifier name:(NSString *)name URLTemplate:(NSString *)URLTemplate;
++ (NSArray *)registeredProviders;
++ (NSArray *)enabledProviders;
++ (void)registerProvider:(TRBTorrentSearchProvider *)provider;
++ (void)unregisterProviderWithIdentifier:(NSString *)identifier;
+
+- (NSURL *)URLForQuery:(NSString *)query page:(NSUInteger)page;
+- (NSURLSessionDataTask *)searchQuery:(NSString *)query page:(NSUInteger)page session:(TRBHTTPSession *)session completion:(void(^)(NSArray * items, NSError * error))completion;
+
+@end
@@ -0,0 +1,154 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrentSearchProvider.h"
+#import "TRBHTTPSession.h"
+#import "TRBXMLElement.h"
+#import "TRBRSSFeed.h"
+
+#define DEFAULT_PROVIDER_TIMEOUT 10.0
+
+static NSString * const TRBTorrentSearchDisabledProvidersKey = @"TRBTorrentSearchDisabledProviders";
+
+static NSMutableArray * TRBTorrentSearchProviders = nil;
+
+@implementation TRBTorrentSearchProvider
+
++ (void)initialize {
+	if (self == [TRBTorrentSearchProvider class]) {
+		TRBTorrentSearchProviders = [NSMutableArray new];
+		[self registerProvider:[self providerWithIdentifier:@"torrentz"
+													   name:@"Torrentz"
+												URLTemplate:@"http://torrentz.eu/feed?q=%QUERY%&p=%PAGE%"]];
+		// Sorted by seeders, pages start at 0 like on the site.
+		[self registerProvider:[self providerWithIdentifier:@"thepiratebay"
+													   name:@"The Pirate Bay"
+												URLTemplate:@"http://rss.thepiratebay.se/search/%QUERY%/%PAGE%/7/0"]];
+	}
+}
+
++ (instancetype)providerWithIdentifier:(NSString *)identifier name:(NSString *)name URLTemplate:(NSString *)URLTemplate {
+	return [[self alloc] initWithIdentifier:identifier name:name URLTemplate:URLTemplate];
+}
+
++ (NSArray *)registeredProviders {
+	@synchronized(self) {
+		return [TRBTorrentSearchProviders copy];
+	}
+}
+
++ (NSArray *)enabledProviders {
+	return [[self registeredProviders] filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"enabled == YES"]];
+}
+
++ (void)registerProvider:(TRBTorrentSearchProvider *)provider {
+	@synchronized(self) {
+		[self unregisterProviderWithIdentifier:provider.identifier];
+		[TRBTorrentSearchProviders addObject:provider];
+	}
+}
+
++ (void)unregisterProviderWithIdentifier:(NSString *)identifier {
+	@synchronized(self) {
+		NSIndexSet * indexes = [TRBTorrentSearchProviders indexesOfObjectsPassingTest:^BOOL(TRBTorrentSearchProvider * provider, NSUInteger idx, BOOL *stop) {
+			return [provider.identifier isEqualToString:identifier];
+		}];
+		[TRBTorrentSearchProviders removeObjectsAtIndexes:indexes];
+	}
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier name:(NSString *)name URLTemplate:(NSString *)URLTemplate {
+	self = [super init];
+	if (self) {
+		_identifier = [identifier copy];
+		_name = [name copy];
+		_URLTemplate = [URLTemplate copy];
+		_timeout = DEFAULT_PROVIDER_TIMEOUT;
+	}
+	return self;
+}
+
+#pragma mark - Dynamic Properties
+
+- (BOOL)isEnabled {
+	NSArray * disabled = [[NSUserDefaults standardUserDefaults] arrayForKey:TRBTorrentSearchDisabledProvidersKey];
+	return ![disabled containsObject:_identifier];
+}
+
+- (void)setEnabled:(BOOL)enabled {
+	NSUserDefaults * defaults = [NSUserDefaults standardUserDefaults];
+	NSMutableArray * disabled = [NSMutableArray arrayWithArray:[defaults arrayForKey:TRBTorrentSearchDisabledProvidersKey]];
+	[disabled removeObject:_identifier];
+	if (!enabled)
+		[disabled addObject:_identifier];
+	[defaults setObject:disabled forKey:TRBTorrentSearchDisabledProvidersKey];
+}
+
+#pragma mark - Public Methods
+
+- (NSURL *)URLForQuery:(NSString *)query page:(NSUInteger)page {
+	NSString * escapedQuery = (__bridge_transfer NSString *)CFURLCreateStringByAddingPercentEscapes(kCFAllocatorDefault,
+																									  (__bridge CFStringRef)query,
+																									  NULL,
+																									  CFSTR(":/?#[]@!$&'()*+,;="),
+																									  kCFStringEncodingUTF8);
+	NSString * URLString = [_URLTemplate stringByReplacingOccurrencesOfString:@"%QUERY%" withString:escapedQuery];
+	URLString = [URLString stringByReplacingOccurrencesOfString:@"%PAGE%" withString:[@(_firstPage + page) description]];
+	return [NSURL URLWithString:URLString];
+}
+
+- (NSURLSessionDataTask *)searchQuery:(NSString *)query page:(NSUInteger)page session:(TRBHTTPSession *)session completion:(void(^)(NSArray * items, NSError * error))completion {
+	NSURLSessionDataTask * result = nil;
+	NSURL * URL = [self URLForQuery:query page:page];
+	if ([URL isFileURL]) {
+		dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+			NSError * error = nil;
+			NSData * data = [NSData dataWithContentsOfURL:URL options:kNilOptions error:&error];
+			TRBXMLElement * element = data ? [TRBXMLElement XMLElementWithData:data error:&error] : nil;
+			NSArray * items = element ? [[TRBRSSFeed alloc] initWithXMLElement:element].items : nil;
+			dispatch_async(dispatch_get_main_queue(), ^{
+				if (completion)
+					completion(items, error);
+			});
+		});
+	} else {
+		NSMutableURLRequest * request = [NSMutableURLRequest requestWithURL:URL];
+		request.timeoutInterval = _timeout;
+		result = [session startRequest:request parser:[TRBHTTPXMLResponseParser new] completion:^(id data, NSURLResponse * response, NSError * error) {
+			NSArray * items = nil;
+			if (!error && [data isKindOfClass:[TRBXMLElement class]])
+				items = [[TRBRSSFeed alloc] initWithXMLElement:data].items;
+			else if (!error) {
+				error = [NSError errorWithDomain:NSURLErrorDomain
+											code:NSURLErrorBadServerResponse
+										userInfo:@{NSLocalizedDescriptionKey: @"Unsupported status code"}];
+			}
+			if (completion)
+				completion(items, error);
+		}];
+	}
+	return result;
+}
+
+@end
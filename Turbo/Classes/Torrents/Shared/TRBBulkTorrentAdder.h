@@ -0,0 +1,42 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+// Adds a set of torrent URLs to several hosts at once. Every host gets its own
+// queue of batches and all hosts run side by side, so a slow or unreachable host
+// doesn't hold back the others. Batches that fail because of the network are
+// retried, with backoff, up to maxAttempts times.
+@interface TRBBulkTorrentAdder : NSObject
+
+@property (nonatomic, assign) NSUInteger batchSize;
+@property (nonatomic, assign) NSUInteger maxAttempts;
+@property (nonatomic, assign) NSTimeInterval retryDelay;
+@property (nonatomic, copy) void(^progressHandler)(NSUInteger added, NSUInteger failed, NSUInteger total);
+@property (nonatomic, readonly, getter = isAdding) BOOL adding;
+
+// added and failed count torrent/host pairs. error is the last one a host
+// reported, if any. Starting a new run cancels the one in progress.
+- (void)addTorrentsAtURLs:(NSArray *)URLs toHosts:(NSArray *)hosts completion:(void(^)(NSUInteger added, NSUInteger failed, NSError * error))completion;
+- (void)cancel;
+
+@end
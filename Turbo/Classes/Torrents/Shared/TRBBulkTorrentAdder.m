@@ -0,0 +1,172 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBBulkTorrentAdder.h"
+#import "TRBHost.h"
+#import "TRBTorrentClient.h"
+
+static BOOL TRBIsTransientError(NSError * error) {
+	if (![error.domain isEqualToString:NSURLErrorDomain])
+		return NO;
+	switch (error.code) {
+		case NSURLErrorTimedOut:
+		case NSURLErrorCannotFindHost:
+		case NSURLErrorCannotConnectToHost:
+		case NSURLErrorNetworkConnectionLost:
+		case NSURLErrorDNSLookupFailed:
+		case NSURLErrorNotConnectedToInternet:
+			return YES;
+		default:
+			return NO;
+	}
+}
+
+@implementation TRBBulkTorrentAdder {
+	NSUInteger _generation;
+	NSUInteger _pendingHosts;
+	NSUInteger _added;
+	NSUInteger _failed;
+	NSUInteger _total;
+	NSError * _lastError;
+	void(^_completion)(NSUInteger added, NSUInteger failed, NSError * error);
+}
+
+- (instancetype)init {
+	self = [super init];
+	if (self) {
+		_batchSize = 25;
+		_maxAttempts = 3;
+		_retryDelay = 1.0;
+	}
+	return self;
+}
+
+#pragma mark - Public Methods
+
+- (void)addTorrentsAtURLs:(NSArray *)URLs toHosts:(NSArray *)hosts completion:(void(^)(NSUInteger added, NSUInteger failed, NSError * error))completion {
+	[self cancel];
+	NSUInteger generation = _generation;
+	_added = 0;
+	_failed = 0;
+	_lastError = nil;
+	_total = [URLs count] * [hosts count];
+	_pendingHosts = [hosts count];
+	_completion = [completion copy];
+	_adding = YES;
+	if (!_total) {
+		[self finish];
+		return;
+	}
+	for (TRBHost * host in hosts)
+		[self sendNextBatchToHost:host remaining:URLs generation:generation];
+}
+
+- (void)cancel {
+	_generation++;
+	_adding = NO;
+	_completion = nil;
+}
+
+#pragma mark - Private Methods
+
+- (void)sendNextBatchToHost:(TRBHost *)host remaining:(NSArray *)URLs generation:(NSUInteger)generation {
+	if (![URLs count]) {
+		[self finishHost];
+		return;
+	}
+	// Clients that can't batch still get their URLs one after the other, so
+	// a host is never hit with more than one add at a time.
+	BOOL batches = (host.client.capabilities & TRBTorrentClientCapabilityBatchAdd) != 0;
+	NSUInteger length = MIN([URLs count], batches ? MAX(_batchSize, (NSUInteger)1) : 1);
+	NSArray * batch = [URLs subarrayWithRange:NSMakeRange(0, length)];
+	NSArray * rest = [URLs subarrayWithRange:NSMakeRange(length, [URLs count] - length)];
+	[self sendBatch:batch toHost:host rest:rest attempt:1 generation:generation];
+}
+
+- (void)sendBatch:(NSArray *)batch toHost:(TRBHost *)host rest:(NSArray *)rest attempt:(NSUInteger)attempt generation:(NSUInteger)generation {
+	if (generation != _generation)
+		return;
+	typeof(self) __weak selfWeak = self;
+	void(^handler)(NSArray *, NSError *) = ^(NSArray * results, NSError * error) {
+		[selfWeak host:host didAddBatch:batch rest:rest results:results error:error attempt:attempt generation:generation];
+	};
+	TRBTorrentClient * client = host.client;
+	if (client.capabilities & TRBTorrentClientCapabilityBatchAdd) {
+		[client addTorrentsAtURLs:batch completion:handler];
+	} else {
+		[client addTorrentAtURL:[batch firstObject] completion:^(BOOL valid, NSError * error) {
+			handler(@[@(valid)], error);
+		}];
+	}
+}
+
+- (void)host:(TRBHost *)host didAddBatch:(NSArray *)batch rest:(NSArray *)rest results:(NSArray *)results error:(NSError *)error attempt:(NSUInteger)attempt generation:(NSUInteger)generation {
+	if (generation != _generation)
+		return;
+	NSMutableArray * missing = [NSMutableArray new];
+	[batch enumerateObjectsUsingBlock:^(NSString * URL, NSUInteger idx, BOOL * stop) {
+		if (idx < [results count] && [results[idx] boolValue])
+			_added++;
+		else
+			[missing addObject:URL];
+	}];
+	BOOL retry = [missing count] && attempt < _maxAttempts && TRBIsTransientError(error);
+	if (!retry) {
+		_failed += [missing count];
+		if ([missing count] && error)
+			_lastError = error;
+	}
+	if (_progressHandler)
+		_progressHandler(_added, _failed, _total);
+	if (generation != _generation)
+		return;
+	if (retry) {
+		// Only what didn't make it goes again; the jitter keeps hosts that share
+		// a flaky network from retrying in lockstep.
+		NSTimeInterval delay = _retryDelay * pow(2.0, (double)(attempt - 1));
+		delay += _retryDelay * (arc4random_uniform(1000) / 1000.0);
+		LogV(@"Retrying %lu torrents on %@ in %.1fs: %@", (unsigned long)[missing count], host.name, delay, error);
+		typeof(self) __weak selfWeak = self;
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+			[selfWeak sendBatch:missing toHost:host rest:rest attempt:attempt + 1 generation:generation];
+		});
+	} else {
+		[self sendNextBatchToHost:host remaining:rest generation:generation];
+	}
+}
+
+- (void)finishHost {
+	if (_pendingHosts && !--_pendingHosts)
+		[self finish];
+}
+
+- (void)finish {
+	void(^completion)(NSUInteger, NSUInteger, NSError *) = _completion;
+	_completion = nil;
+	_adding = NO;
+	if (completion)
+		completion(_added, _failed, _lastError);
+}
+
+@end
@@ -50,6 +50,10 @@ typedef NS_ENUM(NSUInteger, HTTPProtocol) {
 
 @end
 
+@interface TRBQBittorrentHost : TRBHost
+
+@end
+
 @protocol TRBHostListDelegate;
 
 @interface TRBHostList : NSObject
@@ -37,6 +37,7 @@ static NSString * const HTTPProtocols[HTTPProtocolCount] = {
 #define TRBProtocolAtIndex(index) HTTPProtocols[SanitizeProtocolIndex(index)]
 
 static NSString * const TRBHostDefaultPath = @"/transmission/rpc";
+static NSString * const TRBQBittorrentHostDefaultPath = @"/";
 
 static NSString * const TRBHostNameKey = @"TRBHostName";
 static NSString * const TRBHostDescriptionKey = @"TRBHostDescription";
@@ -172,6 +173,53 @@ static NSString * const TRBHostPathKey = @"TRBHostPath";
 
 @end
 
+@implementation TRBQBittorrentHost {
+	TRBQBittorrentClient * _client;
+}
+
+- (instancetype)init {
+	self = [super init];
+	if (self) {
+		self.path = TRBQBittorrentHostDefaultPath;
+		self.icon = [UIImage imageNamed:@"hosts"];
+	}
+	return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+	self = [super initWithCoder:aDecoder];
+	if (self) {
+		if (![self.path length])
+			self.path = TRBQBittorrentHostDefaultPath;
+		self.icon = [UIImage imageNamed:@"hosts"];
+	}
+	return self;
+}
+
+- (void)setDomain:(NSString *)domain {
+	if (![self.domain isEqualToString:domain]) {
+		[super setDomain:domain];
+		if (_client)
+			_client = [[TRBQBittorrentClient alloc] initWithURL:[self URL]];
+	}
+}
+
+- (void)setPath:(NSString *)path {
+	if (![self.path isEqualToString:path]) {
+		[super setPath:path];
+		if (_client)
+			_client = [[TRBQBittorrentClient alloc] initWithURL:[self URL]];
+	}
+}
+
+- (TRBTorrentClient *)client {
+	if (!_client)
+		_client = [[TRBQBittorrentClient alloc] initWithURL:[self URL]];
+	return _client;
+}
+
+@end
+
 @implementation TRBHostList {
 	NSMutableArray * _inactiveHosts;
 	NSMutableArray * _activeHosts;
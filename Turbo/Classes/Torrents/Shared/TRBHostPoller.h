@@ -0,0 +1,52 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+@class TRBHost;
+@protocol TRBHostPollerDelegate;
+
+@interface TRBHostPoller : NSObject
+
+@property (nonatomic, strong, readonly) TRBHost * host;
+@property (nonatomic, weak) id<TRBHostPollerDelegate> delegate;
+@property (nonatomic, assign) NSTimeInterval refreshInterval;
+@property (nonatomic, assign) NSTimeInterval idleMultiplier;
+@property (nonatomic, assign) NSTimeInterval maxInterval;
+@property (nonatomic, readonly) NSUInteger consecutiveFailures;
+@property (nonatomic, readonly, getter = isPolling) BOOL polling;
+
+- (instancetype)initWithHost:(TRBHost *)host;
+- (void)start;
+- (void)stop;
+- (NSTimeInterval)nextInterval;
+
+@end
+
+@protocol TRBHostPollerDelegate <NSObject>
+
+- (void)hostPoller:(TRBHostPoller *)poller didFetchTorrents:(NSArray *)torrents error:(NSError *)error;
+
+@optional
+
+- (BOOL)hostPollerShouldPoll:(TRBHostPoller *)poller;
+
+@end
@@ -0,0 +1,152 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "TRBHostPoller.h"
+#import "TRBHost.h"
+#import "TRBTorrent.h"
+#import "TRBTorrentClient.h"
+
+@implementation TRBHostPoller {
+	NSTimer * _timer;
+	NSUInteger _generation;
+	BOOL _active;
+	BOOL _fetching;
+}
+
+- (instancetype)initWithHost:(TRBHost *)host {
+	self = [super init];
+	if (self) {
+		_host = host;
+		_refreshInterval = 1.0;
+		_idleMultiplier = 5.0;
+		_maxInterval = 60.0;
+		_active = YES;
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[_timer invalidate];
+}
+
+#pragma mark - Public Methods
+
+- (void)start {
+	if (!_polling) {
+		_polling = YES;
+		_consecutiveFailures = 0;
+		_active = YES;
+		[self poll];
+	}
+}
+
+- (void)stop {
+	_polling = NO;
+	_fetching = NO;
+	_generation++;
+	[_timer invalidate];
+	_timer = nil;
+}
+
+- (NSTimeInterval)nextInterval {
+	NSTimeInterval interval = _refreshInterval;
+	if (_consecutiveFailures)
+		interval = _refreshInterval * pow(2.0, (double)MIN(_consecutiveFailures, (NSUInteger)16));
+	else if (!_active)
+		interval = MAX(_refreshInterval, MIN(_refreshInterval * _idleMultiplier, _maxInterval));
+	return MIN(MAX(interval, _refreshInterval), MAX(_maxInterval, _refreshInterval));
+}
+
+#pragma mark - Custom Setters
+
+- (void)setRefreshInterval:(NSTimeInterval)refreshInterval {
+	NSTimeInterval previous = _refreshInterval;
+	_refreshInterval = refreshInterval;
+	// Pick up a faster rate right away instead of waiting out the old delay.
+	if (_polling && !_fetching && refreshInterval < previous)
+		[self scheduleNextPoll];
+}
+
+#pragma mark - Private Methods
+
+- (void)poll {
+	_timer = nil;
+	if (!_polling || _fetching)
+		return;
+	_fetching = YES;
+	NSUInteger generation = _generation;
+	typeof(self) __weak selfWeak = self;
+	[_host.client fetchTorrentsWithCompletion:^(NSArray * torrents, NSError * error) {
+		[selfWeak didFetchTorrents:torrents error:error generation:generation];
+	}];
+}
+
+- (void)didFetchTorrents:(NSArray *)torrents error:(NSError *)error generation:(NSUInteger)generation {
+	if (generation != _generation)
+		return;
+	_fetching = NO;
+	_host.error = error;
+	if (error)
+		_consecutiveFailures++;
+	else {
+		_consecutiveFailures = 0;
+		_active = [self hasActiveTransfers:torrents];
+	}
+	[_delegate hostPoller:self didFetchTorrents:torrents error:error];
+	[self scheduleNextPoll];
+}
+
+- (void)scheduleNextPoll {
+	[_timer invalidate];
+	_timer = nil;
+	if (_polling) {
+		_timer = [NSTimer scheduledTimerWithTimeInterval:[self nextInterval]
+												  target:self
+												selector:@selector(timerFired:)
+												userInfo:nil
+												 repeats:NO];
+	}
+}
+
+- (void)timerFired:(NSTimer *)timer {
+	_timer = nil;
+	if ([_delegate respondsToSelector:@selector(hostPollerShouldPoll:)] && ![_delegate hostPollerShouldPoll:self])
+		[self stop];
+	else
+		[self poll];
+}
+
+- (BOOL)hasActiveTransfers:(NSArray *)torrents {
+	BOOL result = NO;
+	for (TRBTorrent * torrent in torrents) {
+		TRBTorrentStatus status = torrent.status;
+		if (status == TRBTorrentStatusDownload || status == TRBTorrentStatusCheck ||
+			[torrent.rateDownload longLongValue] > 0 || [torrent.rateUpload longLongValue] > 0) {
+			result = YES;
+			break;
+		}
+	}
+	return result;
+}
+
+@end
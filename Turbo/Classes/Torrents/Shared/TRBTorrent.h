@@ -35,10 +35,30 @@ typedef NS_ENUM(NSInteger, TRBTorrentStatus) {
 	TRBTorrentStatusCount
 };
 
+typedef NS_OPTIONS(uint32_t, TRBTorrentField) {
+	TRBTorrentFieldIdentifier = 1 << 0,
+	TRBTorrentFieldHashString = 1 << 1,
+	TRBTorrentFieldName = 1 << 2,
+	TRBTorrentFieldStatus = 1 << 3,
+	TRBTorrentFieldPercentDone = 1 << 4,
+	TRBTorrentFieldPeersConnected = 1 << 5,
+	TRBTorrentFieldPeersSendingToUs = 1 << 6,
+	TRBTorrentFieldETA = 1 << 7,
+	TRBTorrentFieldErrorString = 1 << 8,
+	TRBTorrentFieldRateDownload = 1 << 9,
+	TRBTorrentFieldRateUpload = 1 << 10,
+	TRBTorrentFieldHaveValid = 1 << 11,
+	TRBTorrentFieldSizeWhenDone = 1 << 12,
+	TRBTorrentFieldIsFinished = 1 << 13,
+	TRBTorrentFieldIsPrivate = 1 << 14,
+	TRBTorrentFieldIsStalled = 1 << 15,
+	TRBTorrentFieldAll = (1 << 16) - 1
+};
+
 @interface TRBTorrent : NSObject
 
 @property (assign, nonatomic, readonly) TRBTorrentStatus status;
-@property (strong, nonatomic, readonly) NSNumber * identifier;
+@property (strong, nonatomic, readonly) id identifier;
 @property (strong, nonatomic, readonly) NSString * name;
 @property (strong, nonatomic, readonly) NSNumber * percentDone;
 @property (strong, nonatomic, readonly) NSNumber * peersConnected;
@@ -52,8 +72,11 @@ typedef NS_ENUM(NSInteger, TRBTorrentStatus) {
 @property (strong, nonatomic, readonly) NSNumber * isFinished;
 @property (strong, nonatomic, readonly) NSNumber * isPrivate;
 @property (strong, nonatomic, readonly) NSNumber * isStalled;
+// Torrents are updated in place across fetches, revision goes up with every update
+// that changes a value and changedFields holds what that update changed.
+@property (assign, nonatomic, readonly) NSUInteger revision;
+@property (assign, nonatomic, readonly) TRBTorrentField changedFields;
 
-- (instancetype)initWithTransmissionJSON:(NSDictionary *)json;
 - (BOOL)isEqualToTorrent:(TRBTorrent *)torrent;
 
 @end
@@ -22,38 +22,207 @@
  */
 
 #import "TRBTorrent.h"
+#import "TRBTorrentTable.h"
 
 @interface TRBTorrent ()
 @end
 
-@implementation TRBTorrent
+static TRBTorrentStatus TRBTorrentStatusFromQBittorrentState(NSString * state) {
+	static NSDictionary * statuses = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		statuses = @{@"pausedDL": @(TRBTorrentStatusStopped),
+					 @"pausedUP": @(TRBTorrentStatusStopped),
+					 @"stoppedDL": @(TRBTorrentStatusStopped),
+					 @"stoppedUP": @(TRBTorrentStatusStopped),
+					 @"error": @(TRBTorrentStatusStopped),
+					 @"missingFiles": @(TRBTorrentStatusStopped),
+					 @"checkingDL": @(TRBTorrentStatusCheck),
+					 @"checkingUP": @(TRBTorrentStatusCheck),
+					 @"checkingResumeData": @(TRBTorrentStatusCheck),
+					 @"queuedDL": @(TRBTorrentStatusDownloadWait),
+					 @"allocating": @(TRBTorrentStatusDownload),
+					 @"metaDL": @(TRBTorrentStatusDownload),
+					 @"forcedMetaDL": @(TRBTorrentStatusDownload),
+					 @"downloading": @(TRBTorrentStatusDownload),
+					 @"forcedDL": @(TRBTorrentStatusDownload),
+					 @"stalledDL": @(TRBTorrentStatusDownload),
+					 @"queuedUP": @(TRBTorrentStatusSeedWait),
+					 @"uploading": @(TRBTorrentStatusSeed),
+					 @"forcedUP": @(TRBTorrentStatusSeed),
+					 @"stalledUP": @(TRBTorrentStatusSeed)};
+	});
+	NSNumber * status = state ? statuses[state] : nil;
+	return status ? [status integerValue] : TRBTorrentStatusUnknown;
+}
+
+// Fills record from the accumulated qBittorrent properties of one torrent.
+static void TRBTorrentRecordFromQBittorrentJSON(TRBTorrentRecord * record, TRBTorrentTable * table, NSDictionary * json) {
+	NSString * state = json[@"state"];
+	long long eta = [json[@"eta"] longLongValue];
+	record->name = [table addString:json[@"name"]];
+	record->status = (int32_t)TRBTorrentStatusFromQBittorrentState(state);
+	record->percentDone = [json[@"progress"] doubleValue];
+	record->peersConnected = [json[@"num_seeds"] intValue] + [json[@"num_leechs"] intValue];
+	record->peersSendingToUs = [json[@"num_seeds"] intValue];
+	// qBittorrent reports an unknown ETA as 100 days.
+	record->eta = eta >= 8640000 ? -1 : eta;
+	if ([state isEqualToString:@"error"])
+		record->errorString = [table addString:@"Error"];
+	else if ([state isEqualToString:@"missingFiles"])
+		record->errorString = [table addString:@"Missing files"];
+	record->rateDownload = [json[@"dlspeed"] longLongValue];
+	record->rateUpload = [json[@"upspeed"] longLongValue];
+	record->haveValid = [json[@"completed"] longLongValue];
+	record->sizeWhenDone = [json[@"size"] longLongValue];
+	record->isFinished = record->percentDone >= 1.0;
+	record->isPrivate = [json[@"private"] boolValue];
+	record->isStalled = [state hasPrefix:@"stalled"];
+	record->fields = TRBTorrentFieldAll & ~(TRBTorrentFieldIdentifier | TRBTorrentFieldHashString);
+}
 
-- (instancetype)initWithTransmissionJSON:(NSDictionary *)json {
+@implementation TRBTorrent {
+	// The string members of _record are unused, strings are kept in the ivars below.
+	TRBTorrentRecord _record;
+	NSString * _hashString;
+	NSString * _name;
+	NSString * _errorString;
+}
+
+- (instancetype)initWithRecord:(const TRBTorrentRecord *)record table:(TRBTorrentTable *)table {
 	self = [super init];
 	if (self) {
-		_identifier = json[@"id"];
-		_name = json[@"name"];
-		_status = [json[@"status"] integerValue];
-		_percentDone = json[@"percentDone"];
-		_peersConnected = json[@"peersConnected"];
-		_peersSendingToUs = json[@"peersSendingToUs"];
-		_eta = json[@"eta"];
-		_errorString = json[@"errorString"];
-		_rateDownload = json[@"rateDownload"];
-		_rateUpload = json[@"rateUpload"];
-		_haveValid = json[@"haveValid"];
-		_sizeWhenDone = json[@"sizeWhenDone"];
-		_isFinished = json[@"isFinished"];
-		_isPrivate = json[@"isPrivate"];
-		_isStalled = json[@"isStalled"];
+		[self updateWithRecord:record table:table];
+		_revision = 0;
 	}
 	return self;
 }
 
+- (instancetype)initWithQBittorrentJSON:(NSDictionary *)json hash:(NSString *)hash table:(TRBTorrentTable *)table {
+	TRBTorrentRecord * record = [table appendRecord];
+	TRBTorrentRecordFromQBittorrentJSON(record, table, json);
+	record->hashString = [table addString:hash];
+	record->fields |= TRBTorrentFieldHashString;
+	return [self initWithRecord:record table:table];
+}
+
 #pragma mark - Public Methods
 
 - (BOOL)isEqualToTorrent:(TRBTorrent *)torrent {
-	return [self.identifier isEqualToNumber:torrent.identifier];
+	return [self.identifier isEqual:torrent.identifier];
+}
+
+- (TRBTorrentField)updateWithQBittorrentJSON:(NSDictionary *)json table:(TRBTorrentTable *)table {
+	TRBTorrentRecord * record = [table appendRecord];
+	TRBTorrentRecordFromQBittorrentJSON(record, table, json);
+	return [self updateWithRecord:record table:table];
+}
+
+- (TRBTorrentField)updateWithRecord:(const TRBTorrentRecord *)record table:(TRBTorrentTable *)table {
+	uint32_t fields = record->fields;
+	// A field seen for the first time counts as changed even when it holds the zero value.
+	uint32_t changed = fields & ~_record.fields;
+#define TRBUpdateValue(field, member) \
+	if ((fields & field) && _record.member != record->member) { \
+		_record.member = record->member; \
+		changed |= field; \
+	}
+#define TRBUpdateString(field, member, ivar) \
+	if (fields & field) { \
+		NSString * value = [table stringAtIndex:record->member]; \
+		if (value != ivar && ![value isEqualToString:ivar]) { \
+			ivar = value; \
+			changed |= field; \
+		} \
+	}
+	TRBUpdateValue(TRBTorrentFieldIdentifier, identifier)
+	TRBUpdateString(TRBTorrentFieldHashString, hashString, _hashString)
+	TRBUpdateString(TRBTorrentFieldName, name, _name)
+	TRBUpdateValue(TRBTorrentFieldStatus, status)
+	TRBUpdateValue(TRBTorrentFieldPercentDone, percentDone)
+	TRBUpdateValue(TRBTorrentFieldPeersConnected, peersConnected)
+	TRBUpdateValue(TRBTorrentFieldPeersSendingToUs, peersSendingToUs)
+	TRBUpdateValue(TRBTorrentFieldETA, eta)
+	TRBUpdateString(TRBTorrentFieldErrorString, errorString, _errorString)
+	TRBUpdateValue(TRBTorrentFieldRateDownload, rateDownload)
+	TRBUpdateValue(TRBTorrentFieldRateUpload, rateUpload)
+	TRBUpdateValue(TRBTorrentFieldHaveValid, haveValid)
+	TRBUpdateValue(TRBTorrentFieldSizeWhenDone, sizeWhenDone)
+	TRBUpdateValue(TRBTorrentFieldIsFinished, isFinished)
+	TRBUpdateValue(TRBTorrentFieldIsPrivate, isPrivate)
+	TRBUpdateValue(TRBTorrentFieldIsStalled, isStalled)
+#undef TRBUpdateValue
+#undef TRBUpdateString
+	_record.fields |= fields;
+	if (changed) {
+		_changedFields = changed;
+		_revision++;
+	}
+	return changed;
+}
+
+#pragma mark - Properties
+
+- (TRBTorrentStatus)status {
+	return (_record.fields & TRBTorrentFieldStatus) ? _record.status : TRBTorrentStatusUnknown;
+}
+
+- (id)identifier {
+	if (_record.fields & TRBTorrentFieldIdentifier)
+		return @(_record.identifier);
+	return _hashString;
+}
+
+- (NSString *)name {
+	return _name;
+}
+
+- (NSNumber *)percentDone {
+	return (_record.fields & TRBTorrentFieldPercentDone) ? @(_record.percentDone) : nil;
+}
+
+- (NSNumber *)peersConnected {
+	return (_record.fields & TRBTorrentFieldPeersConnected) ? @(_record.peersConnected) : nil;
+}
+
+- (NSNumber *)peersSendingToUs {
+	return (_record.fields & TRBTorrentFieldPeersSendingToUs) ? @(_record.peersSendingToUs) : nil;
+}
+
+- (NSNumber *)eta {
+	return (_record.fields & TRBTorrentFieldETA) ? @(_record.eta) : nil;
+}
+
+- (NSString *)errorString {
+	return _errorString;
+}
+
+- (NSNumber *)rateDownload {
+	return (_record.fields & TRBTorrentFieldRateDownload) ? @(_record.rateDownload) : nil;
+}
+
+- (NSNumber *)rateUpload {
+	return (_record.fields & TRBTorrentFieldRateUpload) ? @(_record.rateUpload) : nil;
+}
+
+- (NSNumber *)haveValid {
+	return (_record.fields & TRBTorrentFieldHaveValid) ? @(_record.haveValid) : nil;
+}
+
+- (NSNumber *)sizeWhenDone {
+	return (_record.fields & TRBTorrentFieldSizeWhenDone) ? @(_record.sizeWhenDone) : nil;
+}
+
+- (NSNumber *)isFinished {
+	return (_record.fields & TRBTorrentFieldIsFinished) ? @((BOOL)_record.isFinished) : nil;
+}
+
+- (NSNumber *)isPrivate {
+	return (_record.fields & TRBTorrentFieldIsPrivate) ? @((BOOL)_record.isPrivate) : nil;
+}
+
+- (NSNumber *)isStalled {
+	return (_record.fields & TRBTorrentFieldIsStalled) ? @((BOOL)_record.isStalled) : nil;
 }
 
 #pragma mark - NSObject Overrides
@@ -23,15 +23,24 @@
 
 @class TRBTorrent;
 
+typedef NS_OPTIONS(NSUInteger, TRBTorrentClientCapabilities) {
+	TRBTorrentClientCapabilityNone = 0,
+	TRBTorrentClientCapabilityDeltaSync = 1 << 0,	/* fetchTorrents only transfers what changed and keeps its sync state until reset */
+	TRBTorrentClientCapabilityBatchAdd = 1 << 1,	/* addTorrentsAtURLs: doesn't cost a round-trip per torrent */
+};
+
 @interface TRBTorrentClient : NSObject
 
 @property (nonatomic, strong, readonly) NSURL * URL;
+@property (nonatomic, assign, readonly) TRBTorrentClientCapabilities capabilities;
 
 - (instancetype)initWithURL:(NSURL *)URL;
 - (void)validateRemoteWithCompletion:(void(^)(BOOL valid, NSError * error))completion;
 - (void)fetchTorrentsWithCompletion:(void(^)(NSArray * torrents, NSError * error))completion;
 - (void)addTorrentAtURL:(NSString *)URL completion:(void(^)(BOOL valid, NSError * error))completion;
 - (void)addTorrentWithBase64String:(NSString *)base64Data completion:(void(^)(BOOL valid, NSError * error))completion;
+- (void)addTorrentWithData:(NSData *)torrent completion:(void(^)(BOOL valid, NSError * error))completion;
+- (void)addTorrentsAtURLs:(NSArray *)URLs completion:(void(^)(NSArray * results, NSError * error))completion;
 - (void)removeTorrent:(TRBTorrent *)torrent completion:(void(^)(BOOL valid, NSError * error))completion;
 - (void)reset;
 
@@ -39,4 +48,13 @@
 
 @interface TRBTransmissionClient : TRBTorrentClient
 
+// Sends the calls ({method, arguments} dictionaries) back-to-back over the host's
+// session, sharing a single session id refresh. Each entry of responses is either
+// the decoded reply or the NSError for that call, in the same order as calls.
+- (void)performRPCCalls:(NSArray *)calls completion:(void(^)(NSArray * responses, NSError * error))completion;
+
+@end
+
+@interface TRBQBittorrentClient : TRBTorrentClient
+
 @end
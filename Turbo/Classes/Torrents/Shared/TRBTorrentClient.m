@@ -23,8 +23,13 @@
 
 #import "TRBTorrentClient.h"
 #import "TRBTorrent.h"
+#import "TRBTorrentPool.h"
+#import "TRBTorrentTable.h"
+#import "TRBTorrentTableParser.h"
 #import "TRBHTTPSession.h"
+#import "TRBJSONBodyStream.h"
 #import "TKAlertCenter.h"
+#import "NSString+TRBAdditions.h"
 
 @implementation TRBTorrentClient
 
@@ -52,6 +57,14 @@
 	[NSException raise:@"Method not implemented" format:@"%@ needs to be implemented by a concrete subclass", NSStringFromSelector(_cmd)];
 }
 
+- (void)addTorrentWithData:(NSData *)torrent completion:(void(^)(BOOL valid, NSError * error))completion {
+	[NSException raise:@"Method not implemented" format:@"%@ needs to be implemented by a concrete subclass", NSStringFromSelector(_cmd)];
+}
+
+- (void)addTorrentsAtURLs:(NSArray *)URLs completion:(void(^)(NSArray * results, NSError * error))completion {
+	[NSException raise:@"Method not implemented" format:@"%@ needs to be implemented by a concrete subclass", NSStringFromSelector(_cmd)];
+}
+
 - (void)removeTorrent:(TRBTorrent *)identifier completion:(void(^)(BOOL valid, NSError * error))completion {
 	[NSException raise:@"Method not implemented" format:@"%@ needs to be implemented by a concrete subclass", NSStringFromSelector(_cmd)];
 }
@@ -60,10 +73,32 @@
 	[NSException raise:@"Method not implemented" format:@"%@ needs to be implemented by a concrete subclass", NSStringFromSelector(_cmd)];
 }
 
+- (TRBTorrentClientCapabilities)capabilities {
+	return TRBTorrentClientCapabilityNone;
+}
+
 @end
 
 static NSString * const TokenHeader = @"X-Transmission-Session-Id";
 
+// Transmission reports a torrent as recently active for 60 seconds after its last change,
+// polling less often than that could miss updates so a full snapshot is taken instead.
+static NSTimeInterval const TRBRecentlyActiveWindow = 50.0;
+
+#define TRBTransmissionStaticFields @[@"name", @"sizeWhenDone", @"isPrivate"]
+#define TRBTransmissionDynamicFields @[@"id", \
+									   @"status", \
+									   @"percentDone", \
+									   @"peersConnected", \
+									   @"peersSendingToUs", \
+									   @"eta", \
+									   @"errorString", \
+									   @"rateDownload", \
+									   @"rateUpload", \
+									   @"haveValid", \
+									   @"isFinished", \
+									   @"isStalled"]
+
 @interface TRBTransmissionClient ()<UIAlertViewDelegate>
 @property (nonatomic, copy) void(^authHandler)(NSURLSessionAuthChallengeDisposition disposition, NSURLCredential * credential);
 @end
@@ -73,7 +108,10 @@ static NSString * const TokenHeader = @"X-Transmission-Session-Id";
 	TRBHTTPSession * _session;
 	TRBHTTPJSONRequestBuilder * _requestBuilder;
 	TRBHTTPJSONResponseParser * _responseParser;
+	TRBTorrentTableParser * _tableParser;
 	NSError * _noHostError;
+	TRBTorrentPool * _pool;
+	NSDate * _lastFetchDate;
 }
 
 - (instancetype)initWithURL:(NSURL *)URL {
@@ -81,12 +119,17 @@ static NSString * const TokenHeader = @"X-Transmission-Session-Id";
 	if (self) {
 		_requestBuilder = [TRBHTTPJSONRequestBuilder new];
 		_responseParser = [TRBHTTPJSONResponseParser new];
+		_tableParser = [TRBTorrentTableParser new];
 		_noHostError = [NSError errorWithDomain:NSStringFromClass([self class]) code:1337 userInfo:@{NSLocalizedDescriptionKey: @"No host selected"}];
-		[self reset];
+		[self setupSession];
 	}
 	return self;
 }
 
+- (void)dealloc {
+	[_session invalidateAndCancel];
+}
+
 #pragma mark - UIAlertViewDelegate Implementation
 
 - (void)alertView:(UIAlertView *)alertView didDismissWithButtonIndex:(NSInteger)buttonIndex {
@@ -113,115 +156,114 @@ static NSString * const TokenHeader = @"X-Transmission-Session-Id";
 #pragma mark - Public Methods
 
 - (void)validateRemoteWithCompletion:(void(^)(BOOL valid, NSError * error))completion {
-	NSMutableURLRequest * request = [self newRequest];
-	if (request) {
-		[_session startRequest:request
-					parameters:@{@"method": @"session-get"}
-					   builder:_requestBuilder
-						parser:_responseParser
-					completion:^(id data, NSURLResponse *response, NSError *error) {
-						if (!error && completion)
-							completion([self validateResponse:data], nil);
-						else {
-							NSHTTPURLResponse * httpResponse = ((NSHTTPURLResponse *)response);
-							if (httpResponse.statusCode == 409) {
-								_token = [httpResponse allHeaderFields][TokenHeader];
-								[self validateRemoteWithCompletion:completion];
-							} else if (completion) {
-								LogE([error localizedDescription]);
-								completion(NO, error);
-							}
-						}
-					}];
-	} else if (completion)
-		completion(NO, _noHostError);
+	[self performRPCCall:@{@"method": @"session-get"} completion:^(NSDictionary * response, NSError * error) {
+		if (completion)
+			completion(response != nil, error);
+	}];
 }
 
 - (void)fetchTorrentsWithCompletion:(void(^)(NSArray * torrents, NSError * error))completion {
-	NSMutableURLRequest * request = [self newRequest];
-	if (request) {
-		NSDictionary * jsonBody = @{@"method": @"torrent-get",
-									@"arguments": @{@"fields": @[@"id",
-																 @"name",
-																 @"status",
-																 @"percentDone",
-																 @"peersConnected",
-																 @"peersSendingToUs",
-																 @"eta",
-																 @"errorString",
-																 @"rateDownload",
-																 @"rateUpload",
-																 @"haveValid",
-																 @"sizeWhenDone",
-																 @"isFinished",
-																 @"isPrivate",
-																 @"isStalled"]}};
-		[_session startRequest:request
-					parameters:jsonBody
-					   builder:_requestBuilder
-						parser:_responseParser
-					completion:^(id data, NSURLResponse *response, NSError *error) {
-						NSHTTPURLResponse * httpResponse = ((NSHTTPURLResponse *)response);
-						if (!error && completion)
-							completion([self processTorrents:data], nil);
-						else {
-							if (httpResponse.statusCode == 409) {
-								_token = [httpResponse allHeaderFields][TokenHeader];
-								[self fetchTorrentsWithCompletion:completion];
-							} else if (completion) {
-								LogE([error localizedDescription]);
-								completion(nil, error);
-							}
-						}
-					}];
-	} else if (completion)
-		completion(nil, _noHostError);
+	if (!self.URL) {
+		if (completion)
+			completion(nil, _noHostError);
+		return;
+	}
+	BOOL fullSnapshot = !_pool || !_lastFetchDate || -[_lastFetchDate timeIntervalSinceNow] > TRBRecentlyActiveWindow;
+	id ids = fullSnapshot ? nil : @"recently-active";
+	NSArray * fields = fullSnapshot ? [TRBTransmissionStaticFields arrayByAddingObjectsFromArray:TRBTransmissionDynamicFields] : TRBTransmissionDynamicFields;
+	NSDate * fetchDate = [NSDate date];
+	[self fetchTorrentsWithIDs:ids fields:fields completion:^(NSDictionary * arguments, NSError * error) {
+		if (error) {
+			if (completion)
+				completion(nil, error);
+			return;
+		}
+		TRBTorrentTable * torrents = arguments[@"torrents"];
+		if (fullSnapshot) {
+			if (!_pool)
+				_pool = [TRBTorrentPool new];
+			[_pool replaceWithTable:torrents];
+			[_tableParser pruneStringsNotInSnapshot:torrents];
+		} else {
+			NSArray * removed = arguments[@"removed"];
+			NSArray * unknown = [_pool identifiersMissingFromTable:torrents];
+			if ([unknown count]) {
+				// Torrents added since the last snapshot still miss their static fields.
+				NSArray * allFields = [TRBTransmissionStaticFields arrayByAddingObjectsFromArray:TRBTransmissionDynamicFields];
+				[self fetchTorrentsWithIDs:unknown fields:allFields completion:^(NSDictionary * added, NSError * addedError) {
+					[_pool updateWithTable:(!addedError ? added[@"torrents"] : nil) removedIdentifiers:removed insertingNew:YES];
+					[_pool updateWithTable:torrents removedIdentifiers:nil insertingNew:NO];
+					_lastFetchDate = fetchDate;
+					if (completion)
+						completion([self cachedTorrents], nil);
+				}];
+				return;
+			}
+			[_pool updateWithTable:torrents removedIdentifiers:removed insertingNew:NO];
+		}
+		_lastFetchDate = fetchDate;
+		if (completion)
+			completion([self cachedTorrents], nil);
+	}];
 }
 
 - (void)addTorrentAtURL:(NSString *)URL completion:(void(^)(BOOL valid, NSError * error))completion {
-	NSMutableURLRequest * request = [self newRequest];
-	if (request) {
-		[self addTorrentWithRequest:request torrentInfo:@{@"filename": URL} completion:completion];
-	} else
-		completion(NO, _noHostError);
+	[self addTorrentWithInfo:@{@"filename": URL} completion:completion];
 }
 
 - (void)addTorrentWithBase64String:(NSString *)base64Data completion:(void(^)(BOOL valid, NSError * error))completion {
-	NSMutableURLRequest * request = [self newRequest];
-	if (request) {
-		[self addTorrentWithRequest:request torrentInfo:@{@"metainfo": base64Data} completion:completion];
-	} else
-		completion(NO, _noHostError);
+	[self addTorrentWithInfo:@{@"metainfo": base64Data} completion:completion];
+}
+
+- (void)addTorrentWithData:(NSData *)torrent completion:(void(^)(BOOL valid, NSError * error))completion {
+	// Encoded while the request is sent, the base64 text is never held in memory.
+	[self addTorrentWithInfo:@{@"metainfo": [TRBJSONBase64String stringWithData:torrent]} completion:completion];
+}
+
+- (void)addTorrentsAtURLs:(NSArray *)URLs completion:(void(^)(NSArray * results, NSError * error))completion {
+	NSMutableArray * calls = [[NSMutableArray alloc] initWithCapacity:[URLs count]];
+	for (NSString * URL in URLs)
+		[calls addObject:@{@"method": @"torrent-add", @"arguments": @{@"filename": URL}}];
+	[self performRPCCalls:calls completion:^(NSArray * responses, NSError * error) {
+		if (!completion)
+			return;
+		NSMutableArray * results = nil;
+		if (responses) {
+			results = [[NSMutableArray alloc] initWithCapacity:[responses count]];
+			for (id response in responses)
+				[results addObject:@([response isKindOfClass:[NSDictionary class]])];
+		}
+		completion(results, error);
+	}];
 }
 
 - (void)removeTorrent:(TRBTorrent *)torrent completion:(void(^)(BOOL valid, NSError * error))completion {
-	NSMutableURLRequest * request = [self newRequest];
-	if (request) {
-		[_session startRequest:request
-					parameters:@{@"method": @"torrent-remove", @"arguments": @{@"ids": @[torrent.identifier], @"delete-local-data": @YES}}
-					   builder:_requestBuilder
-						parser:_responseParser
-					completion:^(id data, NSURLResponse *response, NSError * error) {
-						if (!error && completion)
-							completion([self validateResponse:data], nil);
-						else {
-							NSHTTPURLResponse * httpResponse = ((NSHTTPURLResponse *)response);
-							if (httpResponse.statusCode == 409) {
-								_token = [httpResponse allHeaderFields][TokenHeader];
-								[self removeTorrent:torrent completion:completion];
-							} else if (completion) {
-								LogE([error localizedDescription]);
-								completion(NO, error);
-							}
-						}
-					}];
-	} else if (completion)
-		completion(NO, _noHostError);
+	[self performRPCCall:@{@"method": @"torrent-remove", @"arguments": @{@"ids": @[torrent.identifier], @"delete-local-data": @YES}}
+			  completion:^(NSDictionary * response, NSError * error) {
+				  if (completion)
+					  completion(response != nil, error);
+			  }];
+}
+
+- (void)performRPCCalls:(NSArray *)calls completion:(void(^)(NSArray * responses, NSError * error))completion {
+	[self performRPCCalls:calls parser:_responseParser completion:completion];
 }
 
 - (void)reset {
-	[_session invalidateAndCancel];
-	_session = [[TRBHTTPSession alloc] initWithConfiguration:nil];
+	_pool = nil;
+	_lastFetchDate = nil;
+}
+
+- (TRBTorrentClientCapabilities)capabilities {
+	return TRBTorrentClientCapabilityDeltaSync | TRBTorrentClientCapabilityBatchAdd;
+}
+
+#pragma mark - Private Methods
+
+- (void)setupSession {
+	NSURLSessionConfiguration * configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+	configuration.HTTPShouldUsePipelining = YES;
+	_session = [[TRBHTTPSession alloc] initWithConfiguration:configuration];
 	_session.acceptedHTTPStatusCodes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(200, 100)];
 	typeof(self) __weak selfWeak = self;
 	[_session onSessionTaskAuthenticationChallenge:^(NSURLSessionTask *task, NSURLAuthenticationChallenge *challenge, void(^completionHandler)(NSURLSessionAuthChallengeDisposition disposition, NSURLCredential * credential)) {
@@ -244,8 +286,6 @@ static NSString * const TokenHeader = @"X-Transmission-Session-Id";
 	}];
 }
 
-#pragma mark - Private Methods
-
 - (NSMutableURLRequest *)newRequest {
 	NSMutableURLRequest * request = nil;
 	if (self.URL) {
@@ -257,43 +297,427 @@ static NSString * const TokenHeader = @"X-Transmission-Session-Id";
 	return request;
 }
 
-- (void)addTorrentWithRequest:(NSMutableURLRequest *)request torrentInfo:(NSDictionary *)info completion:(void(^)(BOOL valid, NSError * error))completion {
-	[_session startRequest:request
-				parameters:@{@"method": @"torrent-add", @"arguments": info}
-				   builder:_requestBuilder
-					parser:_responseParser
-				completion:^(id data, NSURLResponse *response, NSError *error) {
-					if (!error && completion)
-						completion([self validateResponse:data], nil);
-					else {
+- (void)performRPCCalls:(NSArray *)calls parser:(TRBHTTPResponseParser *)parser completion:(void(^)(NSArray * responses, NSError * error))completion {
+	if (!self.URL) {
+		if (completion)
+			completion(nil, _noHostError);
+		return;
+	}
+	NSMutableArray * responses = [[NSMutableArray alloc] initWithCapacity:[calls count]];
+	for (NSUInteger i = 0; i < [calls count]; i++)
+		[responses addObject:[NSNull null]];
+	if (![calls count]) {
+		if (completion)
+			completion(responses, nil);
+		return;
+	}
+	// Without a session id every call would bounce with a 409, so the first one goes
+	// alone to pick it up and the rest follow on the same connection.
+	NSIndexSet * all = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [calls count])];
+	NSIndexSet * first = _token ? all : [NSIndexSet indexSetWithIndex:0];
+	[self sendRPCCalls:calls atIndexes:first parser:parser responses:responses completion:^(NSIndexSet * conflicted) {
+		NSMutableIndexSet * pending = [all mutableCopy];
+		[pending removeIndexes:first];
+		[pending addIndexes:conflicted];
+		if (![pending count] || ([first count] == 1 && ![conflicted count] && [responses[0] isKindOfClass:[NSError class]])) {
+			if (completion)
+				completion(responses, [pending count] ? responses[0] : nil);
+			return;
+		}
+		[self sendRPCCalls:calls atIndexes:pending parser:parser responses:responses completion:^(NSIndexSet * stillConflicted) {
+			if (completion)
+				completion(responses, nil);
+		}];
+	}];
+}
+
+- (void)sendRPCCalls:(NSArray *)calls atIndexes:(NSIndexSet *)indexes parser:(TRBHTTPResponseParser *)parser responses:(NSMutableArray *)responses completion:(void(^)(NSIndexSet * conflicted))completion {
+	NSMutableIndexSet * conflicted = [NSMutableIndexSet new];
+	__block NSUInteger remaining = [indexes count];
+	[indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+		[_session startRequest:[self newRequest]
+					parameters:calls[index]
+					   builder:_requestBuilder
+						parser:parser
+					completion:^(id data, NSURLResponse *response, NSError *error) {
 						NSHTTPURLResponse * httpResponse = ((NSHTTPURLResponse *)response);
-						if (httpResponse.statusCode == 409) {
-							_token = [httpResponse allHeaderFields][TokenHeader];
-							[request setValue:_token forHTTPHeaderField:TokenHeader];
-							[self addTorrentWithRequest:request torrentInfo:info completion:completion];
-						} else if (completion) {
-							LogE([error localizedDescription]);
-							completion(NO, error);
+						if (!error) {
+							if ([self validateResponse:data])
+								responses[index] = data;
+							else
+								responses[index] = [NSError errorWithDomain:NSStringFromClass([self class]) code:1338 userInfo:@{NSLocalizedDescriptionKey: @"Invalid response"}];
+						} else {
+							if (httpResponse.statusCode == 409) {
+								NSString * token = [httpResponse allHeaderFields][TokenHeader];
+								if (token)
+									_token = token;
+								[conflicted addIndex:index];
+							} else
+								LogE([error localizedDescription]);
+							responses[index] = error;
 						}
+						if (--remaining == 0)
+							completion(conflicted);
+					}];
+	}];
+}
+
+- (void)performRPCCall:(NSDictionary *)call completion:(void(^)(NSDictionary * response, NSError * error))completion {
+	[self performRPCCall:call parser:_responseParser completion:completion];
+}
+
+- (void)performRPCCall:(NSDictionary *)call parser:(TRBHTTPResponseParser *)parser completion:(void(^)(NSDictionary * response, NSError * error))completion {
+	[self performRPCCalls:@[call] parser:parser completion:^(NSArray * responses, NSError * error) {
+		id response = [responses firstObject];
+		if ([response isKindOfClass:[NSDictionary class]])
+			completion(response, nil);
+		else
+			completion(nil, error ?: ([response isKindOfClass:[NSError class]] ? response : nil));
+	}];
+}
+
+- (void)addTorrentWithInfo:(NSDictionary *)info completion:(void(^)(BOOL valid, NSError * error))completion {
+	[self performRPCCall:@{@"method": @"torrent-add", @"arguments": info} completion:^(NSDictionary * response, NSError * error) {
+		if (completion)
+			completion(response != nil, error);
+	}];
+}
+
+- (void)fetchTorrentsWithIDs:(id)ids fields:(NSArray *)fields completion:(void(^)(NSDictionary * arguments, NSError * error))completion {
+	// The table format sends the field names once instead of once per torrent,
+	// older servers ignore it and answer with objects, which the parser reads too.
+	NSMutableDictionary * arguments = [NSMutableDictionary dictionaryWithObjectsAndKeys:fields, @"fields", @"table", @"format", nil];
+	if (ids)
+		arguments[@"ids"] = ids;
+	[self performRPCCall:@{@"method": @"torrent-get", @"arguments": arguments} parser:_tableParser completion:^(NSDictionary * response, NSError * error) {
+		completion(response[@"arguments"], error);
+	}];
+}
+
+- (NSArray *)cachedTorrents {
+	return _pool.torrents ?: @[];
+}
+
+- (BOOL)validateResponse:(NSDictionary *)json {
+	return [json[@"result"] isEqualToString:@"success"];
+}
+
+@end
+
+static NSString * const TRBQBittorrentRealm = @"qBittorrent";
+
+@interface TRBQBittorrentClient ()<UIAlertViewDelegate>
+@end
+
+@implementation TRBQBittorrentClient {
+	TRBHTTPSession * _session;
+	TRBHTTPRequestBuilder * _requestBuilder;
+	TRBHTTPJSONResponseParser * _responseParser;
+	NSError * _noHostError;
+	NSMutableArray * _loginCompletions;
+	NSInteger _rid;
+	NSMutableDictionary * _properties;
+	NSMutableDictionary * _torrents;
+	NSMutableArray * _hashes;
+	// Holds the records of one sync, emptied and refilled by every mergeMainData:.
+	TRBTorrentTable * _table;
+	// Handed out until the set or order of torrents changes, like TRBTorrentPool.
+	NSArray * _orderedTorrents;
+}
+
+- (instancetype)initWithURL:(NSURL *)URL {
+	self = [super initWithURL:URL];
+	if (self) {
+		_requestBuilder = [TRBHTTPRequestBuilder new];
+		_responseParser = [TRBHTTPJSONResponseParser new];
+		_table = [TRBTorrentTable new];
+		_noHostError = [NSError errorWithDomain:NSStringFromClass([self class]) code:1337 userInfo:@{NSLocalizedDescriptionKey: @"No host selected"}];
+		_session = [[TRBHTTPSession alloc] initWithConfiguration:nil];
+		_session.acceptedHTTPStatusCodes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(200, 100)];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	[_session invalidateAndCancel];
+}
+
+#pragma mark - UIAlertViewDelegate Implementation
+
+- (void)alertView:(UIAlertView *)alertView didDismissWithButtonIndex:(NSInteger)buttonIndex {
+	if (buttonIndex == 1) {
+		NSURLCredential * credential = [NSURLCredential credentialWithUser:[alertView textFieldAtIndex:0].text
+																  password:[alertView textFieldAtIndex:1].text
+															   persistence:NSURLCredentialPersistencePermanent];
+		[self loginWithCredential:credential];
+	} else
+		[self finishLoginWithError:[NSError errorWithDomain:NSStringFromClass([self class]) code:1339 userInfo:@{NSLocalizedDescriptionKey: @"Login cancelled"}]];
+}
+
+#pragma mark - Public Methods
+
+- (void)validateRemoteWithCompletion:(void(^)(BOOL valid, NSError * error))completion {
+	[self startRequestWithMethod:@"GET" path:@"app/version" parameters:nil parser:nil completion:^(id data, NSError * error) {
+		if (completion)
+			completion([data length] > 0, error);
+	}];
+}
+
+- (void)fetchTorrentsWithCompletion:(void(^)(NSArray * torrents, NSError * error))completion {
+	[self startRequestWithMethod:@"GET"
+							path:@"sync/maindata"
+					  parameters:@{@"rid": [@(_rid) stringValue]}
+						  parser:_responseParser
+					  completion:^(NSDictionary * data, NSError * error) {
+						  if (!error && ![data isKindOfClass:[NSDictionary class]])
+							  error = [NSError errorWithDomain:NSStringFromClass([self class]) code:1338 userInfo:@{NSLocalizedDescriptionKey: @"Invalid response"}];
+						  if (error) {
+							  if (completion)
+								  completion(nil, error);
+							  return;
+						  }
+						  [self mergeMainData:data];
+						  if (completion)
+							  completion([self cachedTorrents], nil);
+					  }];
+}
+
+- (void)addTorrentAtURL:(NSString *)URL completion:(void(^)(BOOL valid, NSError * error))completion {
+	[self addTorrentsAtURLs:@[URL] completion:^(NSArray * results, NSError * error) {
+		if (completion)
+			completion([[results firstObject] boolValue], error);
+	}];
+}
+
+- (void)addTorrentWithBase64String:(NSString *)base64Data completion:(void(^)(BOOL valid, NSError * error))completion {
+	NSData * torrent = [[NSData alloc] initWithBase64EncodedString:base64Data options:NSDataBase64DecodingIgnoreUnknownCharacters];
+	[self addTorrentWithData:torrent completion:completion];
+}
+
+- (void)addTorrentWithData:(NSData *)torrent completion:(void(^)(BOOL valid, NSError * error))completion {
+	NSMutableURLRequest * request = [self newRequestWithMethod:@"POST" path:@"torrents/add"];
+	if (!request) {
+		if (completion)
+			completion(NO, _noHostError);
+		return;
+	}
+	NSString * boundary = [[NSUUID UUID] UUIDString];
+	NSMutableData * body = [NSMutableData new];
+	[body appendData:[[NSString stringWithFormat:@"--%@\r\nContent-Disposition: form-data; name=\"torrents\"; filename=\"upload.torrent\"\r\nContent-Type: application/x-bittorrent\r\n\r\n", boundary] dataUsingEncoding:NSUTF8StringEncoding]];
+	if (torrent)
+		[body appendData:torrent];
+	[body appendData:[[NSString stringWithFormat:@"\r\n--%@--\r\n", boundary] dataUsingEncoding:NSUTF8StringEncoding]];
+	[request setHTTPBody:body];
+	[request setValue:[NSString stringWithFormat:@"multipart/form-data; boundary=%@", boundary] forHTTPHeaderField:@"Content-Type"];
+	[self startRequest:request parameters:nil parser:nil retryLogin:YES completion:^(id data, NSError * error) {
+		if (completion)
+			completion([self validateResponse:data], error);
+	}];
+}
+
+- (void)addTorrentsAtURLs:(NSArray *)URLs completion:(void(^)(NSArray * results, NSError * error))completion {
+	// torrents/add takes a newline separated list, so the whole batch is one request.
+	NSString * urls = [URLs componentsJoinedByString:@"\n"];
+	[self startRequestWithMethod:@"POST" path:@"torrents/add" parameters:@{@"urls": [urls URLEncodedString]} parser:nil completion:^(id data, NSError * error) {
+		if (!completion)
+			return;
+		NSMutableArray * results = nil;
+		if (!error) {
+			BOOL added = [self validateResponse:data];
+			results = [[NSMutableArray alloc] initWithCapacity:[URLs count]];
+			for (NSUInteger i = 0; i < [URLs count]; i++)
+				[results addObject:@(added)];
+		}
+		completion(results, error);
+	}];
+}
+
+- (void)removeTorrent:(TRBTorrent *)torrent completion:(void(^)(BOOL valid, NSError * error))completion {
+	[self startRequestWithMethod:@"POST"
+							path:@"torrents/delete"
+					  parameters:@{@"hashes": torrent.identifier, @"deleteFiles": @"true"}
+						  parser:nil
+					  completion:^(id data, NSError * error) {
+						  if (completion)
+							  completion(!error, error);
+					  }];
+}
+
+- (void)reset {
+	_rid = 0;
+	_properties = nil;
+	_torrents = nil;
+	_hashes = nil;
+	_orderedTorrents = nil;
+}
+
+- (TRBTorrentClientCapabilities)capabilities {
+	return TRBTorrentClientCapabilityDeltaSync | TRBTorrentClientCapabilityBatchAdd;
+}
+
+#pragma mark - Private Methods
+
+- (NSMutableURLRequest *)newRequestWithMethod:(NSString *)method path:(NSString *)path {
+	NSMutableURLRequest * request = nil;
+	if (self.URL) {
+		request = [NSMutableURLRequest requestWithURL:[[self.URL URLByAppendingPathComponent:@"api/v2"] URLByAppendingPathComponent:path]];
+		[request setHTTPMethod:method];
+		// The Web UI rejects requests whose Referer doesn't match the host as CSRF.
+		[request setValue:[self.URL absoluteString] forHTTPHeaderField:@"Referer"];
+	}
+	return request;
+}
+
+- (void)startRequestWithMethod:(NSString *)method path:(NSString *)path parameters:(NSDictionary *)parameters parser:(TRBHTTPResponseParser *)parser completion:(void(^)(id data, NSError * error))completion {
+	NSMutableURLRequest * request = [self newRequestWithMethod:method path:path];
+	if (request)
+		[self startRequest:request parameters:parameters parser:parser retryLogin:YES completion:completion];
+	else
+		completion(nil, _noHostError);
+}
+
+- (void)startRequest:(NSURLRequest *)request parameters:(NSDictionary *)parameters parser:(TRBHTTPResponseParser *)parser retryLogin:(BOOL)retry completion:(void(^)(id data, NSError * error))completion {
+	[_session startRequest:request
+				parameters:parameters
+				   builder:_requestBuilder
+					parser:parser
+				completion:^(id data, NSURLResponse * response, NSError * error) {
+					NSHTTPURLResponse * httpResponse = ((NSHTTPURLResponse *)response);
+					if (!error)
+						completion(data, nil);
+					else if (httpResponse.statusCode == 403 && retry) {
+						[self loginWithCompletion:^(NSError * loginError) {
+							if (!loginError)
+								[self startRequest:request parameters:parameters parser:parser retryLogin:NO completion:completion];
+							else
+								completion(nil, loginError);
+						}];
+					} else {
+						LogE([error localizedDescription]);
+						completion(nil, error);
 					}
 				}];
 }
 
-- (NSArray *)processTorrents:(NSDictionary *)json {
-	NSMutableArray * result = nil;
-	if ([self validateResponse:json]) {
-		NSArray * torrents = json[@"arguments"][@"torrents"];
-		result = [[NSMutableArray alloc] initWithCapacity:[torrents count]];
-		for (NSDictionary * torrent in torrents) {
-			TRBTorrent * t = [[TRBTorrent alloc] initWithTransmissionJSON:torrent];
-			[result addObject:t];
-		}
+- (void)loginWithCompletion:(void(^)(NSError * error))completion {
+	BOOL inProgress = [_loginCompletions count] > 0;
+	if (!_loginCompletions)
+		_loginCompletions = [NSMutableArray new];
+	[_loginCompletions addObject:[completion copy]];
+	if (inProgress)
+		return;
+	NSURLCredential * credential = [[NSURLCredentialStorage sharedCredentialStorage] defaultCredentialForProtectionSpace:[self protectionSpace]];
+	if ([credential hasPassword])
+		[self loginWithCredential:credential];
+	else
+		[self showLoginAlertWithUser:credential.user];
+}
+
+- (void)loginWithCredential:(NSURLCredential *)credential {
+	NSMutableURLRequest * request = [self newRequestWithMethod:@"POST" path:@"auth/login"];
+	if (!request) {
+		[self finishLoginWithError:_noHostError];
+		return;
 	}
-	return result;
+	NSDictionary * parameters = @{@"username": [credential.user ?: @"" URLEncodedString], @"password": [credential.password ?: @"" URLEncodedString]};
+	[self startRequest:request parameters:parameters parser:nil retryLogin:NO completion:^(id data, NSError * error) {
+		NSURLCredentialStorage * storage = [NSURLCredentialStorage sharedCredentialStorage];
+		if (!error && [self validateResponse:data]) {
+			[storage setDefaultCredential:credential forProtectionSpace:[self protectionSpace]];
+			[self finishLoginWithError:nil];
+		} else if (!error) {
+			[storage removeCredential:credential forProtectionSpace:[self protectionSpace]];
+			[self showLoginAlertWithUser:credential.user];
+		} else
+			[self finishLoginWithError:error];
+	}];
 }
 
-- (BOOL)validateResponse:(NSDictionary *)json {
-	return [json[@"result"] isEqualToString:@"success"];
+- (void)showLoginAlertWithUser:(NSString *)user {
+	UIAlertView * alertView = [[UIAlertView alloc] initWithTitle:@"Login"
+														 message:@"Provide credential"
+														delegate:self
+											   cancelButtonTitle:@"Cancel"
+											   otherButtonTitles:@"Login", nil];
+	alertView.alertViewStyle = UIAlertViewStyleLoginAndPasswordInput;
+	[alertView textFieldAtIndex:0].text = user;
+	[alertView show];
+}
+
+- (void)finishLoginWithError:(NSError *)error {
+	NSArray * completions = _loginCompletions;
+	_loginCompletions = nil;
+	for (void(^completion)(NSError *) in completions)
+		completion(error);
+}
+
+- (NSURLProtectionSpace *)protectionSpace {
+	return [[NSURLProtectionSpace alloc] initWithHost:[self.URL host]
+												 port:[[self.URL port] integerValue]
+											 protocol:[self.URL scheme]
+												realm:TRBQBittorrentRealm
+								 authenticationMethod:NSURLAuthenticationMethodHTMLForm];
+}
+
+- (void)mergeMainData:(NSDictionary *)data {
+	BOOL fullUpdate = [data[@"full_update"] boolValue] || !_properties;
+	// Torrents that survive a full update keep their instance.
+	NSDictionary * previous = fullUpdate ? _torrents : nil;
+	if (fullUpdate) {
+		_properties = [NSMutableDictionary new];
+		_torrents = [NSMutableDictionary new];
+		_hashes = [NSMutableArray new];
+	}
+	NSArray * removed = data[@"torrents_removed"];
+	if ([removed count]) {
+		[_properties removeObjectsForKeys:removed];
+		[_torrents removeObjectsForKeys:removed];
+		[_hashes removeObjectsInArray:removed];
+		_orderedTorrents = nil;
+	}
+	NSDictionary * changes = data[@"torrents"];
+	[_table removeAllRecords];
+	[changes enumerateKeysAndObjectsUsingBlock:^(NSString * hash, NSDictionary * changed, BOOL * stop) {
+		NSMutableDictionary * properties = _properties[hash];
+		if (!properties) {
+			properties = [changed mutableCopy];
+			_properties[hash] = properties;
+			[_hashes addObject:hash];
+			_orderedTorrents = nil;
+		} else
+			[properties addEntriesFromDictionary:changed];
+		TRBTorrent * torrent = _torrents[hash] ?: previous[hash];
+		if (torrent)
+			[torrent updateWithQBittorrentJSON:properties table:_table];
+		else
+			torrent = [[TRBTorrent alloc] initWithQBittorrentJSON:properties hash:hash table:_table];
+		_torrents[hash] = torrent;
+	}];
+	if (fullUpdate) {
+		[_hashes sortUsingComparator:^NSComparisonResult(NSString * hash1, NSString * hash2) {
+			return [_properties[hash1][@"added_on"] compare:_properties[hash2][@"added_on"]];
+		}];
+	}
+	_rid = [data[@"rid"] integerValue];
+}
+
+- (NSArray *)cachedTorrents {
+	if (!_orderedTorrents) {
+		NSMutableArray * result = [[NSMutableArray alloc] initWithCapacity:[_hashes count]];
+		for (NSString * hash in _hashes)
+			[result addObject:_torrents[hash]];
+		_orderedTorrents = [result copy];
+	}
+	return _orderedTorrents;
+}
+
+- (BOOL)validateResponse:(id)data {
+	BOOL result = NO;
+	if ([data isKindOfClass:[NSData class]]) {
+		NSString * text = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+		result = [[text stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]] hasPrefix:@"Ok"];
+	}
+	return result;
 }
 
 @end
@@ -0,0 +1,74 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrent.h"
+
+@class TRBHost;
+
+typedef NS_ENUM(NSUInteger, TRBTorrentSortKey) {
+	TRBTorrentSortKeyName = 0,		/* A to Z */
+	TRBTorrentSortKeyProgress,		/* Most complete first */
+	TRBTorrentSortKeyRateDownload,	/* Fastest first */
+	TRBTorrentSortKeyRateUpload,	/* Fastest first */
+	TRBTorrentSortKeyETA,			/* Soonest first, no estimate last */
+
+	TRBTorrentSortKeyCount
+};
+
+// Only downloading torrents are counted in the ETA distribution.
+typedef NS_ENUM(NSUInteger, TRBTorrentETABucket) {
+	TRBTorrentETABucketUnknown = 0,	/* No estimate available */
+	TRBTorrentETABucketHour,		/* Done within an hour */
+	TRBTorrentETABucketDay,			/* Done within a day */
+	TRBTorrentETABucketWeek,		/* Done within a week */
+	TRBTorrentETABucketLonger,
+
+	TRBTorrentETABucketCount
+};
+
+@interface TRBDashboardItem : NSObject
+
+@property (nonatomic, strong, readonly) TRBHost * host;
+@property (nonatomic, strong, readonly) TRBTorrent * torrent;
+
+@end
+
+@interface TRBTorrentDashboard : NSObject
+
+@property (nonatomic, assign) TRBTorrentSortKey sortKey;
+@property (nonatomic, readonly) long long rateDownload;
+@property (nonatomic, readonly) long long rateUpload;
+@property (nonatomic, readonly) NSUInteger torrentCount;
+
+- (void)updateHost:(TRBHost *)host withTorrents:(NSArray *)torrents;
+- (void)removeHost:(TRBHost *)host;
+- (NSArray *)hosts;
+
+- (NSUInteger)countForStatus:(TRBTorrentStatus)status;
+- (NSUInteger)countForETABucket:(TRBTorrentETABucket)bucket;
+
+// Torrents of all hosts as TRBDashboardItem, ordered by sortKey.
+- (NSArray *)allItems;
+
+@end
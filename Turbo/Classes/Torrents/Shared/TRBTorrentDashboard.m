@@ -0,0 +1,351 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrentDashboard.h"
+#import "TRBHost.h"
+
+static NSUInteger TRBStatusSlot(TRBTorrentStatus status) {
+	return (status >= 0 && status < TRBTorrentStatusCount) ? (NSUInteger)status : TRBTorrentStatusCount;
+}
+
+static TRBTorrentETABucket TRBETABucketForTorrent(TRBTorrent * torrent) {
+	long long eta = [torrent.eta longLongValue];
+	TRBTorrentETABucket result = TRBTorrentETABucketUnknown;
+	if (!torrent.eta || eta < 0)
+		result = TRBTorrentETABucketUnknown;
+	else if (eta <= 3600)
+		result = TRBTorrentETABucketHour;
+	else if (eta <= 86400)
+		result = TRBTorrentETABucketDay;
+	else if (eta <= 604800)
+		result = TRBTorrentETABucketWeek;
+	else
+		result = TRBTorrentETABucketLonger;
+	return result;
+}
+
+static NSComparisonResult TRBCompareValues(double a, double b) {
+	return a < b ? NSOrderedAscending : (a > b ? NSOrderedDescending : NSOrderedSame);
+}
+
+static NSComparisonResult TRBCompareTorrents(TRBTorrent * a, TRBTorrent * b, TRBTorrentSortKey key) {
+	NSComparisonResult result = NSOrderedSame;
+	switch (key) {
+		case TRBTorrentSortKeyProgress:
+			result = TRBCompareValues([b.percentDone doubleValue], [a.percentDone doubleValue]);
+			break;
+		case TRBTorrentSortKeyRateDownload:
+			result = TRBCompareValues([b.rateDownload doubleValue], [a.rateDownload doubleValue]);
+			break;
+		case TRBTorrentSortKeyRateUpload:
+			result = TRBCompareValues([b.rateUpload doubleValue], [a.rateUpload doubleValue]);
+			break;
+		case TRBTorrentSortKeyETA: {
+			double etaA = a.eta && [a.eta longLongValue] >= 0 ? [a.eta doubleValue] : DBL_MAX;
+			double etaB = b.eta && [b.eta longLongValue] >= 0 ? [b.eta doubleValue] : DBL_MAX;
+			result = TRBCompareValues(etaA, etaB);
+			break;
+		} default:
+			break;
+	}
+	if (result == NSOrderedSame)
+		result = [(a.name ?: @"") localizedStandardCompare:(b.name ?: @"")];
+	return result;
+}
+
+static TRBTorrentField TRBSortFieldsForKey(TRBTorrentSortKey key) {
+	TRBTorrentField result = TRBTorrentFieldName;
+	switch (key) {
+		case TRBTorrentSortKeyProgress:
+			result |= TRBTorrentFieldPercentDone;
+			break;
+		case TRBTorrentSortKeyRateDownload:
+			result |= TRBTorrentFieldRateDownload;
+			break;
+		case TRBTorrentSortKeyRateUpload:
+			result |= TRBTorrentFieldRateUpload;
+			break;
+		case TRBTorrentSortKeyETA:
+			result |= TRBTorrentFieldETA;
+			break;
+		default:
+			break;
+	}
+	return result;
+}
+
+@interface TRBDashboardItem ()
+// What the torrent added to the totals. Torrents change in place, so the values
+// are kept to take them out again.
+@property (nonatomic, assign) NSUInteger revision;
+@property (nonatomic, assign) long long rateDownload;
+@property (nonatomic, assign) long long rateUpload;
+@property (nonatomic, assign) TRBTorrentStatus status;
+@property (nonatomic, assign) TRBTorrentETABucket etaBucket;
+- (instancetype)initWithHost:(TRBHost *)host torrent:(TRBTorrent *)torrent;
+@end
+
+@implementation TRBDashboardItem
+
+- (instancetype)initWithHost:(TRBHost *)host torrent:(TRBTorrent *)torrent {
+	self = [super init];
+	if (self) {
+		_host = host;
+		_torrent = torrent;
+	}
+	return self;
+}
+
+#pragma mark - NSObject Overrides
+
+// Identifiers are only unique within a host, Transmission numbers torrents from 1 on every host.
+- (BOOL)isEqual:(id)object {
+	BOOL result = NO;
+	if ([object isKindOfClass:[TRBDashboardItem class]]) {
+		TRBDashboardItem * item = object;
+		result = item.host == _host && [_torrent isEqualToTorrent:item.torrent];
+	}
+	return result;
+}
+
+- (NSUInteger)hash {
+	return [_torrent hash] ^ (NSUInteger)_host;
+}
+
+@end
+
+@interface TRBDashboardHostState : NSObject
+@property (nonatomic, strong) NSMutableDictionary * items;
+@property (nonatomic, strong) NSArray * sortedItems;
+@end
+
+@implementation TRBDashboardHostState
+@end
+
+@implementation TRBTorrentDashboard {
+	NSMapTable * _states;
+	NSMutableArray * _hosts;
+	NSUInteger _statusCounts[TRBTorrentStatusCount + 1];
+	NSUInteger _etaCounts[TRBTorrentETABucketCount];
+}
+
+- (instancetype)init {
+	self = [super init];
+	if (self) {
+		_states = [NSMapTable strongToStrongObjectsMapTable];
+		_hosts = [NSMutableArray new];
+	}
+	return self;
+}
+
+#pragma mark - Public Methods
+
+- (void)updateHost:(TRBHost *)host withTorrents:(NSArray *)torrents {
+	TRBDashboardHostState * state = [_states objectForKey:host];
+	if (!state) {
+		state = [TRBDashboardHostState new];
+		state.items = [[NSMutableDictionary alloc] initWithCapacity:[torrents count]];
+		[_states setObject:state forKey:host];
+		[_hosts addObject:host];
+	}
+	NSMutableDictionary * items = state.items;
+	TRBTorrentField sortFields = TRBSortFieldsForKey(_sortKey);
+	NSUInteger seen = 0;
+	BOOL changed = NO;
+	for (TRBTorrent * torrent in torrents) {
+		id identifier = torrent.identifier;
+		if (!identifier)
+			continue;
+		seen++;
+		TRBDashboardItem * item = items[identifier];
+		// Clients update torrents in place, the revision tells whether the item is behind.
+		if (item.torrent == torrent) {
+			if (item.revision == torrent.revision)
+				continue;
+			if (item.revision + 1 != torrent.revision || (torrent.changedFields & sortFields))
+				changed = YES;
+			[self removeContributionOfItem:item];
+		} else {
+			if (item)
+				[self removeContributionOfItem:item];
+			item = [[TRBDashboardItem alloc] initWithHost:host torrent:torrent];
+			items[identifier] = item;
+			changed = YES;
+		}
+		[self addContributionOfItem:item];
+	}
+	if ([items count] > seen) {
+		NSMutableSet * current = [[NSMutableSet alloc] initWithCapacity:[torrents count]];
+		for (TRBTorrent * torrent in torrents) {
+			if (torrent.identifier)
+				[current addObject:torrent.identifier];
+		}
+		for (id identifier in [items allKeys]) {
+			if (![current containsObject:identifier]) {
+				[self removeContributionOfItem:items[identifier]];
+				[items removeObjectForKey:identifier];
+			}
+		}
+		changed = YES;
+	}
+	if (changed)
+		state.sortedItems = nil;
+}
+
+- (void)removeHost:(TRBHost *)host {
+	TRBDashboardHostState * state = [_states objectForKey:host];
+	if (state) {
+		for (TRBDashboardItem * item in [state.items objectEnumerator])
+			[self removeContributionOfItem:item];
+		[_states removeObjectForKey:host];
+		[_hosts removeObjectIdenticalTo:host];
+	}
+}
+
+- (NSArray *)hosts {
+	return [_hosts copy];
+}
+
+- (NSUInteger)countForStatus:(TRBTorrentStatus)status {
+	return _statusCounts[TRBStatusSlot(status)];
+}
+
+- (NSUInteger)countForETABucket:(TRBTorrentETABucket)bucket {
+	return bucket < TRBTorrentETABucketCount ? _etaCounts[bucket] : 0;
+}
+
+- (NSArray *)allItems {
+	NSUInteger count = [_hosts count];
+	NSMutableArray * lists = [[NSMutableArray alloc] initWithCapacity:count];
+	for (TRBHost * host in _hosts) {
+		NSArray * sorted = [self sortedItemsForState:[_states objectForKey:host]];
+		if ([sorted count])
+			[lists addObject:sorted];
+	}
+	return [self mergeSortedLists:lists];
+}
+
+#pragma mark - Custom Setters
+
+- (void)setSortKey:(TRBTorrentSortKey)sortKey {
+	if (_sortKey != sortKey) {
+		_sortKey = sortKey;
+		for (TRBDashboardHostState * state in [_states objectEnumerator])
+			state.sortedItems = nil;
+	}
+}
+
+#pragma mark - Private Methods
+
+- (void)addContributionOfItem:(TRBDashboardItem *)item {
+	TRBTorrent * torrent = item.torrent;
+	item.revision = torrent.revision;
+	item.rateDownload = [torrent.rateDownload longLongValue];
+	item.rateUpload = [torrent.rateUpload longLongValue];
+	item.status = torrent.status;
+	item.etaBucket = TRBETABucketForTorrent(torrent);
+	_rateDownload += item.rateDownload;
+	_rateUpload += item.rateUpload;
+	_torrentCount++;
+	_statusCounts[TRBStatusSlot(item.status)]++;
+	if (item.status == TRBTorrentStatusDownload)
+		_etaCounts[item.etaBucket]++;
+}
+
+- (void)removeContributionOfItem:(TRBDashboardItem *)item {
+	_rateDownload -= item.rateDownload;
+	_rateUpload -= item.rateUpload;
+	_torrentCount--;
+	_statusCounts[TRBStatusSlot(item.status)]--;
+	if (item.status == TRBTorrentStatusDownload)
+		_etaCounts[item.etaBucket]--;
+}
+
+- (NSArray *)sortedItemsForState:(TRBDashboardHostState *)state {
+	if (!state.sortedItems) {
+		TRBTorrentSortKey key = _sortKey;
+		state.sortedItems = [[state.items allValues] sortedArrayUsingComparator:^NSComparisonResult(TRBDashboardItem * item1, TRBDashboardItem * item2) {
+			return TRBCompareTorrents(item1.torrent, item2.torrent, key);
+		}];
+	}
+	return state.sortedItems;
+}
+
+// Each host's list is already sorted, a min-heap over the list heads merges them in O(n log k).
+- (NSArray *)mergeSortedLists:(NSArray *)lists {
+	NSUInteger k = [lists count];
+	if (k == 0)
+		return @[];
+	if (k == 1)
+		return lists[0];
+	NSUInteger total = 0;
+	for (NSArray * list in lists)
+		total += [list count];
+	NSMutableArray * result = [[NSMutableArray alloc] initWithCapacity:total];
+	NSUInteger * heap = malloc(sizeof(NSUInteger) * k);
+	NSUInteger * positions = calloc(k, sizeof(NSUInteger));
+	TRBTorrentSortKey key = _sortKey;
+	NSUInteger size = 0;
+	for (NSUInteger i = 0; i < k; i++) {
+		NSUInteger child = size++;
+		heap[child] = i;
+		while (child > 0) {
+			NSUInteger parent = (child - 1) / 2;
+			if (TRBCompareTorrents([lists[heap[child]][0] torrent], [lists[heap[parent]][0] torrent], key) != NSOrderedAscending)
+				break;
+			NSUInteger swap = heap[parent];
+			heap[parent] = heap[child];
+			heap[child] = swap;
+			child = parent;
+		}
+	}
+	while (size) {
+		NSUInteger top = heap[0];
+		NSArray * list = lists[top];
+		[result addObject:list[positions[top]++]];
+		if (positions[top] == [list count])
+			heap[0] = heap[--size];
+		NSUInteger parent = 0;
+		while (YES) {
+			NSUInteger smallest = parent;
+			for (NSUInteger child = 2 * parent + 1; child <= 2 * parent + 2 && child < size; child++) {
+				TRBTorrent * candidate = [lists[heap[child]][positions[heap[child]]] torrent];
+				TRBTorrent * current = [lists[heap[smallest]][positions[heap[smallest]]] torrent];
+				if (TRBCompareTorrents(candidate, current, key) == NSOrderedAscending)
+					smallest = child;
+			}
+			if (smallest == parent)
+				break;
+			NSUInteger swap = heap[parent];
+			heap[parent] = heap[smallest];
+			heap[smallest] = swap;
+			parent = smallest;
+		}
+	}
+	free(heap);
+	free(positions);
+	return result;
+}
+
+@end
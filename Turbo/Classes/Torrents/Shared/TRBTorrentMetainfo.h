@@ -0,0 +1,47 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+@interface TRBTorrentFile : NSObject
+
+@property (nonatomic, strong, readonly) NSString * path;
+@property (nonatomic, assign, readonly) long long length;
+
+@end
+
+// What a .torrent file describes, read locally before it's handed to a host.
+@interface TRBTorrentMetainfo : NSObject
+
+// SHA-1 of the raw info dictionary, lowercase hex like -[TRBRSSItem infoHash].
+@property (nonatomic, strong, readonly) NSString * infoHash;
+@property (nonatomic, strong, readonly) NSString * name;
+@property (nonatomic, strong, readonly) NSString * announce;
+@property (nonatomic, strong, readonly) NSArray * files;
+@property (nonatomic, assign, readonly) long long totalLength;
+@property (nonatomic, assign, readonly) long long pieceLength;
+@property (nonatomic, assign, readonly) NSUInteger pieceCount;
+@property (nonatomic, assign, readonly) BOOL isPrivate;
+
++ (instancetype)metainfoWithData:(NSData *)data error:(NSError **)error;
+
+@end
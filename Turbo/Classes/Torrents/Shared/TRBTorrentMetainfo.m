@@ -0,0 +1,139 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrentMetainfo.h"
+#import "TRBBencode.h"
+#import <CommonCrypto/CommonDigest.h>
+
+static NSString * TRBMetainfoString(id value) {
+	NSString * result = nil;
+	if ([value isKindOfClass:[NSData class]]) {
+		result = [[NSString alloc] initWithData:value encoding:NSUTF8StringEncoding];
+		if (!result)
+			result = [[NSString alloc] initWithData:value encoding:NSISOLatin1StringEncoding];
+	}
+	return result;
+}
+
+static NSNumber * TRBMetainfoNumber(id value) {
+	return [value isKindOfClass:[NSNumber class]] ? value : nil;
+}
+
+@interface TRBTorrentFile ()
+- (instancetype)initWithPath:(NSString *)path length:(long long)length;
+@end
+
+@implementation TRBTorrentFile
+
+- (instancetype)initWithPath:(NSString *)path length:(long long)length {
+	self = [super init];
+	if (self) {
+		_path = path;
+		_length = length;
+	}
+	return self;
+}
+
+@end
+
+@implementation TRBTorrentMetainfo
+
++ (instancetype)metainfoWithData:(NSData *)data error:(NSError **)error {
+	TRBTorrentMetainfo * result = nil;
+	NSDictionary * torrent = [TRBBencode objectWithData:data error:error];
+	if (torrent) {
+		result = [[self alloc] initWithDictionary:torrent data:data];
+		if (!result && error)
+			*error = [NSError errorWithDomain:NSStringFromClass(self) code:-1 userInfo:@{NSLocalizedDescriptionKey: @"Not a valid torrent file"}];
+	}
+	return result;
+}
+
+#pragma mark - Private Methods
+
+- (instancetype)initWithDictionary:(NSDictionary *)torrent data:(NSData *)data {
+	if (![torrent isKindOfClass:[NSDictionary class]])
+		return nil;
+	NSDictionary * info = torrent[@"info"];
+	NSRange infoRange = [TRBBencode rangeOfValueForKey:@"info" inData:data];
+	if (![info isKindOfClass:[NSDictionary class]] || infoRange.location == NSNotFound)
+		return nil;
+	self = [super init];
+	if (self) {
+		// The hash is over the bytes as they were sent, re-encoding could reorder them.
+		unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+		CC_SHA1((const uint8_t *)[data bytes] + infoRange.location, (CC_LONG)infoRange.length, digest);
+		NSMutableString * infoHash = [NSMutableString stringWithCapacity:CC_SHA1_DIGEST_LENGTH * 2];
+		for (int i = 0; i < CC_SHA1_DIGEST_LENGTH; i++)
+			[infoHash appendFormat:@"%02x", digest[i]];
+		_infoHash = infoHash;
+		_name = TRBMetainfoString(info[@"name.utf-8"]) ?: TRBMetainfoString(info[@"name"]);
+		_announce = TRBMetainfoString(torrent[@"announce"]);
+		_pieceLength = [TRBMetainfoNumber(info[@"piece length"]) longLongValue];
+		_pieceCount = [info[@"pieces"] isKindOfClass:[NSData class]] ? [info[@"pieces"] length] / CC_SHA1_DIGEST_LENGTH : 0;
+		_isPrivate = [TRBMetainfoNumber(info[@"private"]) boolValue];
+		if (![_name length] || _pieceLength <= 0 || !_pieceCount || ![self readFilesFromInfo:info])
+			return nil;
+	}
+	return self;
+}
+
+- (BOOL)readFilesFromInfo:(NSDictionary *)info {
+	NSNumber * length = TRBMetainfoNumber(info[@"length"]);
+	NSArray * entries = info[@"files"];
+	if (length) {
+		if ([length longLongValue] < 0)
+			return NO;
+		_files = @[[[TRBTorrentFile alloc] initWithPath:_name length:[length longLongValue]]];
+		_totalLength = [length longLongValue];
+		return YES;
+	}
+	if (![entries isKindOfClass:[NSArray class]] || ![entries count])
+		return NO;
+	NSMutableArray * files = [[NSMutableArray alloc] initWithCapacity:[entries count]];
+	long long total = 0;
+	for (NSDictionary * entry in entries) {
+		if (![entry isKindOfClass:[NSDictionary class]])
+			return NO;
+		long long fileLength = [TRBMetainfoNumber(entry[@"length"]) longLongValue];
+		NSArray * components = entry[@"path.utf-8"] ?: entry[@"path"];
+		if (fileLength < 0 || total > LLONG_MAX - fileLength || ![components isKindOfClass:[NSArray class]] || ![components count])
+			return NO;
+		NSMutableArray * path = [[NSMutableArray alloc] initWithCapacity:[components count] + 1];
+		[path addObject:_name];
+		for (id component in components) {
+			NSString * string = TRBMetainfoString(component);
+			if (!string)
+				return NO;
+			[path addObject:string];
+		}
+		[files addObject:[[TRBTorrentFile alloc] initWithPath:[path componentsJoinedByString:@"/"] length:fileLength]];
+		total += fileLength;
+	}
+	_files = files;
+	_totalLength = total;
+	return YES;
+}
+
+@end
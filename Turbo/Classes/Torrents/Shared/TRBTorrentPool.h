@@ -0,0 +1,45 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+@class TRBTorrent;
+@class TRBTorrentTable;
+
+// The torrents of one host, keyed by identifier. Fetched tables update the pooled
+// TRBTorrent objects in place, so a torrent keeps its instance for as long as the
+// host reports it and steady polling allocates no torrents.
+@interface TRBTorrentPool : NSObject
+
+@property (nonatomic, readonly) NSUInteger count;
+// In the order the host first reported them, the same array until torrents are
+// added or removed.
+@property (nonatomic, readonly) NSArray * torrents;
+
+- (TRBTorrent *)torrentWithIdentifier:(int64_t)identifier;
+- (NSArray *)identifiersMissingFromTable:(TRBTorrentTable *)table;
+// Rows of table without a pooled torrent are added when insert is set.
+- (void)updateWithTable:(TRBTorrentTable *)table removedIdentifiers:(NSArray *)removed insertingNew:(BOOL)insert;
+// Full snapshot, torrents the table doesn't contain are dropped.
+- (void)replaceWithTable:(TRBTorrentTable *)table;
+
+@end
@@ -0,0 +1,136 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrentPool.h"
+#import "TRBTorrentTable.h"
+
+static inline const void * TRBTorrentPoolKey(int64_t identifier) {
+	return (const void *)(intptr_t)identifier;
+}
+
+@implementation TRBTorrentPool {
+	// Transmission identifiers are small integers and are used as keys directly.
+	CFMutableDictionaryRef _byIdentifier;
+	NSMutableArray * _ordered;
+	NSArray * _torrents;
+}
+
+- (id)init {
+	self = [super init];
+	if (self) {
+		_byIdentifier = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+		_ordered = [NSMutableArray new];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	CFRelease(_byIdentifier);
+}
+
+#pragma mark - Public Methods
+
+- (NSUInteger)count {
+	return [_ordered count];
+}
+
+- (NSArray *)torrents {
+	if (!_torrents)
+		_torrents = [_ordered copy];
+	return _torrents;
+}
+
+- (TRBTorrent *)torrentWithIdentifier:(int64_t)identifier {
+	return (__bridge TRBTorrent *)CFDictionaryGetValue(_byIdentifier, TRBTorrentPoolKey(identifier));
+}
+
+- (NSArray *)identifiersMissingFromTable:(TRBTorrentTable *)table {
+	NSMutableArray * result = [NSMutableArray new];
+	for (NSUInteger i = 0; i < table.count; i++) {
+		const TRBTorrentRecord * record = [table recordAtIndex:i];
+		if ((record->fields & TRBTorrentFieldIdentifier) && ![self torrentWithIdentifier:record->identifier])
+			[result addObject:@(record->identifier)];
+	}
+	return result;
+}
+
+- (void)updateWithTable:(TRBTorrentTable *)table removedIdentifiers:(NSArray *)removed insertingNew:(BOOL)insert {
+	if ([removed count]) {
+		NSMutableIndexSet * indexes = [NSMutableIndexSet new];
+		for (NSNumber * identifier in removed) {
+			TRBTorrent * torrent = [self torrentWithIdentifier:[identifier longLongValue]];
+			if (!torrent)
+				continue;
+			[indexes addIndex:[_ordered indexOfObjectIdenticalTo:torrent]];
+			CFDictionaryRemoveValue(_byIdentifier, TRBTorrentPoolKey([identifier longLongValue]));
+		}
+		if ([indexes count]) {
+			[_ordered removeObjectsAtIndexes:indexes];
+			_torrents = nil;
+		}
+	}
+	for (NSUInteger i = 0; i < table.count; i++) {
+		const TRBTorrentRecord * record = [table recordAtIndex:i];
+		if (!(record->fields & TRBTorrentFieldIdentifier))
+			continue;
+		TRBTorrent * torrent = [self torrentWithIdentifier:record->identifier];
+		if (torrent) {
+			[torrent updateWithRecord:record table:table];
+		} else if (insert) {
+			torrent = [[TRBTorrent alloc] initWithRecord:record table:table];
+			CFDictionarySetValue(_byIdentifier, TRBTorrentPoolKey(record->identifier), (__bridge const void *)torrent);
+			[_ordered addObject:torrent];
+			_torrents = nil;
+		}
+	}
+}
+
+- (void)replaceWithTable:(TRBTorrentTable *)table {
+	NSMutableArray * ordered = [[NSMutableArray alloc] initWithCapacity:table.count];
+	CFMutableDictionaryRef byIdentifier = CFDictionaryCreateMutable(kCFAllocatorDefault, (CFIndex)table.count, NULL, &kCFTypeDictionaryValueCallBacks);
+	BOOL reordered = NO;
+	for (NSUInteger i = 0; i < table.count; i++) {
+		const TRBTorrentRecord * record = [table recordAtIndex:i];
+		if (!(record->fields & TRBTorrentFieldIdentifier) || CFDictionaryContainsKey(byIdentifier, TRBTorrentPoolKey(record->identifier)))
+			continue;
+		TRBTorrent * torrent = [self torrentWithIdentifier:record->identifier];
+		if (torrent)
+			[torrent updateWithRecord:record table:table];
+		else
+			torrent = [[TRBTorrent alloc] initWithRecord:record table:table];
+		NSUInteger position = [ordered count];
+		if (position >= [_ordered count] || _ordered[position] != torrent)
+			reordered = YES;
+		[ordered addObject:torrent];
+		CFDictionarySetValue(byIdentifier, TRBTorrentPoolKey(record->identifier), (__bridge const void *)torrent);
+	}
+	if (reordered || [ordered count] != [_ordered count]) {
+		_ordered = ordered;
+		_torrents = nil;
+	}
+	CFRelease(_byIdentifier);
+	_byIdentifier = byIdentifier;
+}
+
+@end
@@ -0,0 +1,43 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+// Select mode of the torrent lists: a Select/Cancel button, an Add button counting
+// the picked torrents and the bulk add of the picked URLs to every active host.
+// The selection is kept by URL so it survives reloads of the table.
+@interface TRBTorrentSelectionController : NSObject
+
+@property (nonatomic, weak, readonly) UITableViewController * viewController;
+
+- (instancetype)initWithViewController:(UITableViewController *)viewController;
+
+// Adds the Select button to the view controller's navigation item, from viewDidLoad.
+- (void)installButtons;
+// To be called from the view controller's setEditing:animated:, after super.
+- (void)setEditing:(BOOL)editing animated:(BOOL)animated;
+
+- (BOOL)isURLSelected:(NSString *)URL;
+- (void)selectURL:(NSString *)URL;
+- (void)deselectURL:(NSString *)URL;
+
+@end
@@ -0,0 +1,117 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrentSelectionController.h"
+#import "TRBBulkTorrentAdder.h"
+#import "TRBHost.h"
+#import "TKAlertCenter.h"
+
+@implementation TRBTorrentSelectionController {
+	TRBBulkTorrentAdder * _torrentAdder;
+	NSMutableOrderedSet * _selectedURLs;
+	UIBarButtonItem * _selectButton;
+	UIBarButtonItem * _addSelectedButton;
+}
+
+- (instancetype)initWithViewController:(UITableViewController *)viewController {
+	self = [super init];
+	if (self) {
+		_viewController = viewController;
+		_torrentAdder = [TRBBulkTorrentAdder new];
+		_selectedURLs = [NSMutableOrderedSet new];
+	}
+	return self;
+}
+
+#pragma mark - Public Methods
+
+- (void)installButtons {
+	UINavigationItem * navigationItem = _viewController.navigationItem;
+	_viewController.tableView.allowsMultipleSelectionDuringEditing = YES;
+	_selectButton = [[UIBarButtonItem alloc] initWithTitle:@"Select" style:UIBarButtonItemStylePlain target:self action:@selector(toggleSelection:)];
+	_addSelectedButton = [[UIBarButtonItem alloc] initWithTitle:@"Add" style:UIBarButtonItemStyleDone target:self action:@selector(addSelectedTorrents:)];
+	navigationItem.rightBarButtonItems = [(navigationItem.rightBarButtonItems ?: @[]) arrayByAddingObject:_selectButton];
+}
+
+- (void)setEditing:(BOOL)editing animated:(BOOL)animated {
+	UINavigationItem * navigationItem = _viewController.navigationItem;
+	[_selectedURLs removeAllObjects];
+	_selectButton.title = editing ? @"Cancel" : @"Select";
+	NSMutableArray * items = [navigationItem.rightBarButtonItems mutableCopy];
+	[items removeObject:_addSelectedButton];
+	if (editing)
+		[items addObject:_addSelectedButton];
+	[navigationItem setRightBarButtonItems:items animated:animated];
+	[self updateAddSelectedButton];
+}
+
+- (BOOL)isURLSelected:(NSString *)URL {
+	return URL && [_selectedURLs containsObject:URL];
+}
+
+- (void)selectURL:(NSString *)URL {
+	if (URL)
+		[_selectedURLs addObject:URL];
+	[self updateAddSelectedButton];
+}
+
+- (void)deselectURL:(NSString *)URL {
+	if (URL)
+		[_selectedURLs removeObject:URL];
+	[self updateAddSelectedButton];
+}
+
+#pragma mark - IBActions
+
+- (IBAction)toggleSelection:(id)sender {
+	[_viewController setEditing:!_viewController.editing animated:YES];
+}
+
+- (IBAction)addSelectedTorrents:(id)sender {
+	NSArray * hosts = [[TRBHostList new] activeHosts];
+	if (![hosts count]) {
+		[[TKAlertCenter defaultCenter] postAlertWithMessage:@"No active host"];
+		return;
+	}
+	NSArray * URLs = [_selectedURLs array];
+	[_viewController setEditing:NO animated:YES];
+	[_torrentAdder addTorrentsAtURLs:URLs toHosts:hosts completion:^(NSUInteger added, NSUInteger failed, NSError * error) {
+		NSString * message = [NSString stringWithFormat:@"%lu added", (unsigned long)added];
+		if (failed)
+			message = [message stringByAppendingFormat:@", %lu failed", (unsigned long)failed];
+		if (error && error.code != 1337)
+			message = [message stringByAppendingFormat:@"\n%@", [error localizedDescription]];
+		[[TKAlertCenter defaultCenter] postAlertWithMessage:message];
+	}];
+}
+
+#pragma mark - Private Methods
+
+- (void)updateAddSelectedButton {
+	NSUInteger count = [_selectedURLs count];
+	_addSelectedButton.title = count ? [NSString stringWithFormat:@"Add (%lu)", (unsigned long)count] : @"Add";
+	_addSelectedButton.enabled = count > 0;
+}
+
+@end
@@ -0,0 +1,78 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrent.h"
+
+// One torrent as reported by a host. Strings are indexes into the owning table,
+// fields says which members the host actually sent.
+typedef struct {
+	int64_t identifier;
+	int64_t eta;
+	int64_t rateDownload;
+	int64_t rateUpload;
+	int64_t haveValid;
+	int64_t sizeWhenDone;
+	double percentDone;
+	int32_t status;
+	int32_t peersConnected;
+	int32_t peersSendingToUs;
+	uint32_t hashString;
+	uint32_t name;
+	uint32_t errorString;
+	uint32_t fields;
+	uint8_t isFinished;
+	uint8_t isPrivate;
+	uint8_t isStalled;
+} TRBTorrentRecord;
+
+// Contiguous storage for the torrents of one fetch, filled by the response parser
+// and then applied to a TRBTorrentPool.
+@interface TRBTorrentTable : NSObject
+
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) NSUInteger stringCount;
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+// Empties the table for the next fetch, keeping the record storage.
+- (void)removeAllRecords;
+
+// The returned record is zeroed and only valid until the next append.
+- (TRBTorrentRecord *)appendRecord;
+- (const TRBTorrentRecord *)recordAtIndex:(NSUInteger)index;
+- (uint32_t)addString:(NSString *)string;
+- (NSString *)stringAtIndex:(uint32_t)index;
+
+@end
+
+@interface TRBTorrent (TRBTorrentTable)
+
+- (instancetype)initWithRecord:(const TRBTorrentRecord *)record table:(TRBTorrentTable *)table;
+// Copies the fields the record carries and returns the ones whose value changed.
+- (TRBTorrentField)updateWithRecord:(const TRBTorrentRecord *)record table:(TRBTorrentTable *)table;
+// The accumulated qBittorrent properties go through a record appended to table.
+- (instancetype)initWithQBittorrentJSON:(NSDictionary *)json hash:(NSString *)hash table:(TRBTorrentTable *)table;
+- (TRBTorrentField)updateWithQBittorrentJSON:(NSDictionary *)json table:(TRBTorrentTable *)table;
+
+@end
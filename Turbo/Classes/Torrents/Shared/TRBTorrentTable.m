@@ -0,0 +1,89 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrentTable.h"
+
+@implementation TRBTorrentTable {
+	TRBTorrentRecord * _records;
+	NSUInteger _capacity;
+	NSMutableArray * _strings;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+	self = [super init];
+	if (self) {
+		_capacity = MAX(capacity, (NSUInteger)1);
+		_records = calloc(_capacity, sizeof(TRBTorrentRecord));
+		// Index 0 is the empty string, which is what most error strings are.
+		_strings = [[NSMutableArray alloc] initWithObjects:@"", nil];
+	}
+	return self;
+}
+
+- (id)init {
+	return [self initWithCapacity:16];
+}
+
+- (void)dealloc {
+	free(_records);
+}
+
+#pragma mark - Public Methods
+
+- (void)removeAllRecords {
+	_count = 0;
+	[_strings removeObjectsInRange:NSMakeRange(1, [_strings count] - 1)];
+}
+
+- (TRBTorrentRecord *)appendRecord {
+	if (_count == _capacity) {
+		_capacity *= 2;
+		_records = realloc(_records, _capacity * sizeof(TRBTorrentRecord));
+	}
+	TRBTorrentRecord * result = &_records[_count++];
+	memset(result, 0, sizeof(TRBTorrentRecord));
+	return result;
+}
+
+- (const TRBTorrentRecord *)recordAtIndex:(NSUInteger)index {
+	NSParameterAssert(index < _count);
+	return &_records[index];
+}
+
+- (uint32_t)addString:(NSString *)string {
+	if (![string length])
+		return 0;
+	[_strings addObject:string];
+	return (uint32_t)([_strings count] - 1);
+}
+
+- (NSString *)stringAtIndex:(uint32_t)index {
+	return _strings[index];
+}
+
+- (NSUInteger)stringCount {
+	return [_strings count];
+}
+
+@end
@@ -0,0 +1,38 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBHTTPSession.h"
+
+// Decodes torrent-get responses straight into a TRBTorrentTable, skipping the
+// NSJSONSerialization object graph. Both the "table" format and the default
+// object format are understood. The result mirrors the JSON envelope, with the
+// table in place of the torrents array:
+// @{@"result": ..., @"arguments": @{@"torrents": TRBTorrentTable, @"removed": NSArray}}
+@interface TRBTorrentTableParser : TRBHTTPJSONResponseParser
+
+// Interned strings are only dropped against a full snapshot: deltas leave out
+// the names of idle torrents, which must stay interned for the next snapshot.
+- (void)pruneStringsNotInSnapshot:(TRBTorrentTable *)table;
+
+@end
@@ -0,0 +1,609 @@
+/*
+ The MIT License (MIT)
+
+ Copyright (c) 2014 Mike Godenzi
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "TRBTorrentTableParser.h"
+#import "TRBTorrentTable.h"
+
+#define TRBTorrentTableParserMaxDepth 64
+
+typedef struct {
+	const uint8_t * start;
+	const uint8_t * p;
+	const uint8_t * end;
+} TRBJSONScanner;
+
+static inline void TRBJSONSkipWhitespace(TRBJSONScanner * s) {
+	while (s->p < s->end && (*s->p == ' ' || *s->p == '\n' || *s->p == '\r' || *s->p == '\t'))
+		s->p++;
+}
+
+static inline BOOL TRBJSONConsume(TRBJSONScanner * s, uint8_t c) {
+	TRBJSONSkipWhitespace(s);
+	if (s->p < s->end && *s->p == c) {
+		s->p++;
+		return YES;
+	}
+	return NO;
+}
+
+static inline BOOL TRBJSONPeek(TRBJSONScanner * s, uint8_t c) {
+	TRBJSONSkipWhitespace(s);
+	return s->p < s->end && *s->p == c;
+}
+
+static BOOL TRBJSONScanLiteral(TRBJSONScanner * s, const char * literal, size_t length) {
+	TRBJSONSkipWhitespace(s);
+	if ((size_t)(s->end - s->p) < length || memcmp(s->p, literal, length))
+		return NO;
+	s->p += length;
+	return YES;
+}
+
+// Returns the raw bytes between the quotes, escaped tells whether they still
+// need unescaping before use.
+static BOOL TRBJSONScanString(TRBJSONScanner * s, const uint8_t ** bytes, size_t * length, BOOL * escaped) {
+	if (!TRBJSONConsume(s, '"'))
+		return NO;
+	const uint8_t * p = s->p;
+	BOOL hasEscapes = NO;
+	while (p < s->end) {
+		uint8_t c = *p;
+		if (c == '"') {
+			*bytes = s->p;
+			*length = (size_t)(p - s->p);
+			if (escaped)
+				*escaped = hasEscapes;
+			s->p = p + 1;
+			return YES;
+		} else if (c == '\\') {
+			if (s->end - p < 2)
+				return NO;
+			hasEscapes = YES;
+			p += 2;
+		} else if (c < 0x20) {
+			return NO;
+		} else {
+			p++;
+		}
+	}
+	return NO;
+}
+
+// Integers are read as such, anything with a fraction or exponent goes
+// through strtod. Both are always filled in.
+static BOOL TRBJSONScanNumber(TRBJSONScanner * s, int64_t * integer, double * real) {
+	TRBJSONSkipWhitespace(s);
+	const uint8_t * p = s->p;
+	BOOL isReal = NO;
+	if (p < s->end && *p == '-')
+		p++;
+	while (p < s->end) {
+		uint8_t c = *p;
+		if (c >= '0' && c <= '9') {
+			p++;
+		} else if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+			isReal = YES;
+			p++;
+		} else {
+			break;
+		}
+	}
+	char buffer[64];
+	size_t length = (size_t)(p - s->p);
+	if (!length || length >= sizeof(buffer))
+		return NO;
+	memcpy(buffer, s->p, length);
+	buffer[length] = '\0';
+	char * parsed = NULL;
+	if (isReal) {
+		*real = strtod(buffer, &parsed);
+		*integer = (int64_t)*real;
+	} else {
+		*integer = strtoll(buffer, &parsed, 10);
+		*real = (double)*integer;
+	}
+	if (parsed != buffer + length)
+		return NO;
+	s->p = p;
+	return YES;
+}
+
+static BOOL TRBJSONSkipValue(TRBJSONScanner * s, NSUInteger depth) {
+	if (depth > TRBTorrentTableParserMaxDepth)
+		return NO;
+	TRBJSONSkipWhitespace(s);
+	if (s->p >= s->end)
+		return NO;
+	const uint8_t * bytes = NULL;
+	size_t length = 0;
+	int64_t integer = 0;
+	double real = 0.0;
+	switch (*s->p) {
+		case '"':
+			return TRBJSONScanString(s, &bytes, &length, NULL);
+		case '{':
+			s->p++;
+			if (TRBJSONConsume(s, '}'))
+				return YES;
+			do {
+				if (!TRBJSONScanString(s, &bytes, &length, NULL) || !TRBJSONConsume(s, ':') || !TRBJSONSkipValue(s, depth + 1))
+					return NO;
+			} while (TRBJSONConsume(s, ','));
+			return TRBJSONConsume(s, '}');
+		case '[':
+			s->p++;
+			if (TRBJSONConsume(s, ']'))
+				return YES;
+			do {
+				if (!TRBJSONSkipValue(s, depth + 1))
+					return NO;
+			} while (TRBJSONConsume(s, ','));
+			return TRBJSONConsume(s, ']');
+		case 't':
+			return TRBJSONScanLiteral(s, "true", 4);
+		case 'f':
+			return TRBJSONScanLiteral(s, "false", 5);
+		case 'n':
+			return TRBJSONScanLiteral(s, "null", 4);
+		default:
+			return TRBJSONScanNumber(s, &integer, &real);
+	}
+}
+
+static inline int TRBJSONHexValue(uint8_t c) {
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+static BOOL TRBJSONScanUnicodeEscape(const uint8_t * p, const uint8_t * end, uint32_t * value) {
+	if (end - p < 6 || p[0] != '\\' || p[1] != 'u')
+		return NO;
+	uint32_t result = 0;
+	for (int i = 2; i < 6; i++) {
+		int digit = TRBJSONHexValue(p[i]);
+		if (digit < 0)
+			return NO;
+		result = (result << 4) | (uint32_t)digit;
+	}
+	*value = result;
+	return YES;
+}
+
+static size_t TRBJSONWriteUTF8(uint32_t codePoint, uint8_t * out) {
+	if (codePoint < 0x80) {
+		out[0] = (uint8_t)codePoint;
+		return 1;
+	} else if (codePoint < 0x800) {
+		out[0] = (uint8_t)(0xC0 | (codePoint >> 6));
+		out[1] = (uint8_t)(0x80 | (codePoint & 0x3F));
+		return 2;
+	} else if (codePoint < 0x10000) {
+		out[0] = (uint8_t)(0xE0 | (codePoint >> 12));
+		out[1] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+		out[2] = (uint8_t)(0x80 | (codePoint & 0x3F));
+		return 3;
+	}
+	out[0] = (uint8_t)(0xF0 | (codePoint >> 18));
+	out[1] = (uint8_t)(0x80 | ((codePoint >> 12) & 0x3F));
+	out[2] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+	out[3] = (uint8_t)(0x80 | (codePoint & 0x3F));
+	return 4;
+}
+
+// Unescaping never grows a string, so out needs at most length bytes. Unpaired
+// surrogates become U+FFFD. Returns the unescaped length, or -1 on a bad escape.
+static ssize_t TRBJSONUnescape(const uint8_t * bytes, size_t length, uint8_t * out) {
+	const uint8_t * p = bytes;
+	const uint8_t * end = bytes + length;
+	uint8_t * o = out;
+	while (p < end) {
+		if (*p != '\\') {
+			*o++ = *p++;
+			continue;
+		}
+		if (end - p < 2)
+			return -1;
+		switch (p[1]) {
+			case '"': *o++ = '"'; break;
+			case '\\': *o++ = '\\'; break;
+			case '/': *o++ = '/'; break;
+			case 'b': *o++ = '\b'; break;
+			case 'f': *o++ = '\f'; break;
+			case 'n': *o++ = '\n'; break;
+			case 'r': *o++ = '\r'; break;
+			case 't': *o++ = '\t'; break;
+			case 'u': {
+				uint32_t codePoint = 0;
+				uint32_t low = 0;
+				if (!TRBJSONScanUnicodeEscape(p, end, &codePoint))
+					return -1;
+				p += 6;
+				if (codePoint >= 0xD800 && codePoint <= 0xDBFF && TRBJSONScanUnicodeEscape(p, end, &low) && low >= 0xDC00 && low <= 0xDFFF) {
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+					p += 6;
+				} else if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+					codePoint = 0xFFFD;
+				}
+				o += TRBJSONWriteUTF8(codePoint, o);
+				continue;
+			}
+			default:
+				return -1;
+		}
+		p += 2;
+	}
+	return o - out;
+}
+
+static NSString * TRBJSONCreateString(const uint8_t * bytes, size_t length, BOOL escaped) {
+	if (!escaped)
+		return [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+	uint8_t stackBuffer[256];
+	uint8_t * buffer = length <= sizeof(stackBuffer) ? stackBuffer : malloc(length);
+	ssize_t unescapedLength = TRBJSONUnescape(bytes, length, buffer);
+	NSString * result = nil;
+	if (unescapedLength >= 0)
+		result = [[NSString alloc] initWithBytes:buffer length:(NSUInteger)unescapedLength encoding:NSUTF8StringEncoding];
+	if (buffer != stackBuffer)
+		free(buffer);
+	return result;
+}
+
+static inline BOOL TRBJSONBytesEqual(const uint8_t * bytes, size_t length, const char * string) {
+	return strlen(string) == length && !memcmp(bytes, string, length);
+}
+
+static inline uintptr_t TRBJSONHashBytes(const uint8_t * bytes, size_t length) {
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < length; i++)
+		hash = (hash ^ bytes[i]) * 16777619u;
+	return hash ? hash : 1;
+}
+
+static TRBTorrentField TRBTorrentFieldForName(const uint8_t * bytes, size_t length) {
+	static const struct {
+		const char * name;
+		TRBTorrentField field;
+	} fields[] = {
+		{"id", TRBTorrentFieldIdentifier},
+		{"hashString", TRBTorrentFieldHashString},
+		{"name", TRBTorrentFieldName},
+		{"status", TRBTorrentFieldStatus},
+		{"percentDone", TRBTorrentFieldPercentDone},
+		{"peersConnected", TRBTorrentFieldPeersConnected},
+		{"peersSendingToUs", TRBTorrentFieldPeersSendingToUs},
+		{"eta", TRBTorrentFieldETA},
+		{"errorString", TRBTorrentFieldErrorString},
+		{"rateDownload", TRBTorrentFieldRateDownload},
+		{"rateUpload", TRBTorrentFieldRateUpload},
+		{"haveValid", TRBTorrentFieldHaveValid},
+		{"sizeWhenDone", TRBTorrentFieldSizeWhenDone},
+		{"isFinished", TRBTorrentFieldIsFinished},
+		{"isPrivate", TRBTorrentFieldIsPrivate},
+		{"isStalled", TRBTorrentFieldIsStalled},
+	};
+	for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+		if (fields[i].name[0] == bytes[0] && TRBJSONBytesEqual(bytes, length, fields[i].name))
+			return fields[i].field;
+	}
+	return 0;
+}
+
+@interface TRBInternedString : NSObject
+@property (nonatomic, strong) NSData * bytes;
+@property (nonatomic, strong) NSString * string;
+@end
+
+@implementation TRBInternedString
+@end
+
+@implementation TRBTorrentTableParser {
+	dispatch_queue_t _queue;
+	// Hash of the raw JSON bytes to TRBInternedString. Names rarely change between
+	// polls, so most strings of a response are looked up instead of created.
+	CFMutableDictionaryRef _strings;
+	NSUInteger _lastCount;
+}
+
+- (id)init {
+	self = [super init];
+	if (self) {
+		_queue = dispatch_queue_create("com.caffeineapps.TRBTorrentTableParserQueue", DISPATCH_QUEUE_SERIAL);
+		_strings = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+	}
+	return self;
+}
+
+- (void)dealloc {
+	CFRelease(_strings);
+}
+
+#pragma mark - Public Methods
+
+- (void)parse:(NSData *)data response:(NSURLResponse *)response completion:(void(^)(id, NSError *))completion {
+	dispatch_async(_queue, ^{
+		NSError * error = nil;
+		id parsedData = [self parseData:data error:&error];
+		completion(parsedData, error);
+	});
+}
+
+- (void)pruneStringsNotInSnapshot:(TRBTorrentTable *)table {
+	NSHashTable * used = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+	for (uint32_t i = 0; i < table.stringCount; i++)
+		[used addObject:[table stringAtIndex:i]];
+	dispatch_async(_queue, ^{
+		[self pruneStringsUsedBy:used];
+	});
+}
+
+#pragma mark - Private Methods
+
+- (id)parseData:(NSData *)data error:(NSError **)error {
+	TRBJSONScanner scanner = {[data bytes], [data bytes], (const uint8_t *)[data bytes] + [data length]};
+	TRBJSONScanner * s = &scanner;
+	NSMutableDictionary * result = [NSMutableDictionary new];
+	BOOL valid = TRBJSONConsume(s, '{');
+	if (valid && !TRBJSONConsume(s, '}')) {
+		do {
+			const uint8_t * key = NULL;
+			size_t length = 0;
+			valid = TRBJSONScanString(s, &key, &length, NULL) && TRBJSONConsume(s, ':');
+			if (!valid)
+				break;
+			if (TRBJSONBytesEqual(key, length, "result")) {
+				NSString * string = [self scanString:s];
+				valid = string != nil;
+				result[@"result"] = string;
+			} else if (TRBJSONBytesEqual(key, length, "arguments")) {
+				NSDictionary * arguments = [self scanArguments:s];
+				valid = arguments != nil;
+				result[@"arguments"] = arguments;
+			} else {
+				valid = TRBJSONSkipValue(s, 1);
+			}
+		} while (valid && TRBJSONConsume(s, ','));
+		valid = valid && TRBJSONConsume(s, '}');
+	}
+	TRBJSONSkipWhitespace(s);
+	if (valid && s->p == s->end)
+		return result;
+	if (error) {
+		NSString * message = [NSString stringWithFormat:@"Malformed torrent-get response at offset %lu", (unsigned long)(s->p - s->start)];
+		*error = [NSError errorWithDomain:NSStringFromClass([self class]) code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+	}
+	return nil;
+}
+
+- (NSDictionary *)scanArguments:(TRBJSONScanner *)s {
+	NSMutableDictionary * result = [NSMutableDictionary new];
+	if (!TRBJSONConsume(s, '{'))
+		return nil;
+	if (TRBJSONConsume(s, '}'))
+		return result;
+	BOOL valid = YES;
+	do {
+		const uint8_t * key = NULL;
+		size_t length = 0;
+		valid = TRBJSONScanString(s, &key, &length, NULL) && TRBJSONConsume(s, ':');
+		if (!valid)
+			break;
+		if (TRBJSONBytesEqual(key, length, "torrents")) {
+			TRBTorrentTable * table = [self scanTorrents:s];
+			valid = table != nil;
+			result[@"torrents"] = table;
+		} else if (TRBJSONBytesEqual(key, length, "removed")) {
+			NSArray * removed = [self scanIdentifiers:s];
+			valid = removed != nil;
+			result[@"removed"] = removed;
+		} else {
+			valid = TRBJSONSkipValue(s, 2);
+		}
+	} while (valid && TRBJSONConsume(s, ','));
+	return valid && TRBJSONConsume(s, '}') ? result : nil;
+}
+
+- (NSArray *)scanIdentifiers:(TRBJSONScanner *)s {
+	NSMutableArray * result = [NSMutableArray new];
+	if (!TRBJSONConsume(s, '['))
+		return nil;
+	if (TRBJSONConsume(s, ']'))
+		return result;
+	do {
+		int64_t identifier = 0;
+		double real = 0.0;
+		if (!TRBJSONScanNumber(s, &identifier, &real))
+			return nil;
+		[result addObject:@(identifier)];
+	} while (TRBJSONConsume(s, ','));
+	return TRBJSONConsume(s, ']') ? result : nil;
+}
+
+- (TRBTorrentTable *)scanTorrents:(TRBJSONScanner *)s {
+	if (!TRBJSONConsume(s, '['))
+		return nil;
+	TRBTorrentTable * result = [[TRBTorrentTable alloc] initWithCapacity:_lastCount];
+	if (TRBJSONConsume(s, ']'))
+		return result;
+	BOOL valid = YES;
+	if (TRBJSONPeek(s, '[')) {
+		// Table format, a row of field names followed by one row of values per torrent.
+		NSMutableData * columns = [NSMutableData new];
+		s->p++;
+		if (!TRBJSONConsume(s, ']')) {
+			do {
+				const uint8_t * name = NULL;
+				size_t length = 0;
+				valid = TRBJSONScanString(s, &name, &length, NULL);
+				TRBTorrentField field = valid ? TRBTorrentFieldForName(name, length) : 0;
+				[columns appendBytes:&field length:sizeof(field)];
+			} while (valid && TRBJSONConsume(s, ','));
+			valid = valid && TRBJSONConsume(s, ']');
+		}
+		const TRBTorrentField * fields = [columns bytes];
+		NSUInteger columnCount = [columns length] / sizeof(TRBTorrentField);
+		while (valid && TRBJSONConsume(s, ',')) {
+			valid = TRBJSONConsume(s, '[');
+			if (!valid || TRBJSONConsume(s, ']'))
+				continue;
+			TRBTorrentRecord * record = [result appendRecord];
+			NSUInteger column = 0;
+			do {
+				TRBTorrentField field = column < columnCount ? fields[column] : 0;
+				valid = [self scanField:field scanner:s record:record table:result];
+				column++;
+			} while (valid && TRBJSONConsume(s, ','));
+			valid = valid && TRBJSONConsume(s, ']');
+		}
+	} else {
+		do {
+			valid = TRBJSONConsume(s, '{');
+			if (!valid || TRBJSONConsume(s, '}'))
+				continue;
+			TRBTorrentRecord * record = [result appendRecord];
+			do {
+				const uint8_t * name = NULL;
+				size_t length = 0;
+				valid = TRBJSONScanString(s, &name, &length, NULL) && TRBJSONConsume(s, ':');
+				if (valid)
+					valid = [self scanField:TRBTorrentFieldForName(name, length) scanner:s record:record table:result];
+			} while (valid && TRBJSONConsume(s, ','));
+			valid = valid && TRBJSONConsume(s, '}');
+		} while (valid && TRBJSONConsume(s, ','));
+	}
+	if (!valid || !TRBJSONConsume(s, ']'))
+		return nil;
+	_lastCount = result.count;
+	return result;
+}
+
+- (BOOL)scanField:(TRBTorrentField)field scanner:(TRBJSONScanner *)s record:(TRBTorrentRecord *)record table:(TRBTorrentTable *)table {
+	if (!field)
+		return TRBJSONSkipValue(s, 4);
+	if (TRBJSONScanLiteral(s, "null", 4))
+		return YES;
+	int64_t integer = 0;
+	double real = 0.0;
+	BOOL valid = YES;
+	switch (field) {
+		case TRBTorrentFieldHashString:
+		case TRBTorrentFieldName:
+		case TRBTorrentFieldErrorString: {
+			NSString * string = [self scanString:s];
+			uint32_t index = [table addString:string];
+			valid = string != nil;
+			if (field == TRBTorrentFieldHashString)
+				record->hashString = index;
+			else if (field == TRBTorrentFieldName)
+				record->name = index;
+			else
+				record->errorString = index;
+			break;
+		}
+		case TRBTorrentFieldIsFinished:
+		case TRBTorrentFieldIsPrivate:
+		case TRBTorrentFieldIsStalled: {
+			uint8_t value = 0;
+			if (TRBJSONScanLiteral(s, "true", 4))
+				value = 1;
+			else if (TRBJSONScanLiteral(s, "false", 5))
+				value = 0;
+			else if ((valid = TRBJSONScanNumber(s, &integer, &real)))
+				value = integer != 0;
+			if (field == TRBTorrentFieldIsFinished)
+				record->isFinished = value;
+			else if (field == TRBTorrentFieldIsPrivate)
+				record->isPrivate = value;
+			else
+				record->isStalled = value;
+			break;
+		}
+		default:
+			valid = TRBJSONScanNumber(s, &integer, &real);
+			switch (field) {
+				case TRBTorrentFieldIdentifier: record->identifier = integer; break;
+				case TRBTorrentFieldStatus: record->status = (int32_t)integer; break;
+				case TRBTorrentFieldPercentDone: record->percentDone = real; break;
+				case TRBTorrentFieldPeersConnected: record->peersConnected = (int32_t)integer; break;
+				case TRBTorrentFieldPeersSendingToUs: record->peersSendingToUs = (int32_t)integer; break;
+				case TRBTorrentFieldETA: record->eta = integer; break;
+				case TRBTorrentFieldRateDownload: record->rateDownload = integer; break;
+				case TRBTorrentFieldRateUpload: record->rateUpload = integer; break;
+				case TRBTorrentFieldHaveValid: record->haveValid = integer; break;
+				case TRBTorrentFieldSizeWhenDone: record->sizeWhenDone = integer; break;
+				default: break;
+			}
+			break;
+	}
+	if (valid)
+		record->fields |= field;
+	return valid;
+}
+
+- (NSString *)scanString:(TRBJSONScanner *)s {
+	const uint8_t * bytes = NULL;
+	size_t length = 0;
+	BOOL escaped = NO;
+	if (!TRBJSONScanString(s, &bytes, &length, &escaped))
+		return nil;
+	if (!length)
+		return @"";
+	uintptr_t hash = TRBJSONHashBytes(bytes, length);
+	TRBInternedString * entry = (__bridge TRBInternedString *)CFDictionaryGetValue(_strings, (const void *)hash);
+	if (entry && [entry.bytes length] == length && !memcmp([entry.bytes bytes], bytes, length)) {
+		return entry.string;
+	}
+	NSString * result = TRBJSONCreateString(bytes, length, escaped);
+	if (result && !entry) {
+		entry = [TRBInternedString new];
+		entry.bytes = [NSData dataWithBytes:bytes length:length];
+		entry.string = result;
+		CFDictionarySetValue(_strings, (const void *)hash, (__bridge const void *)entry);
+	}
+	return result;
+}
+
+// Drops the strings the snapshot doesn't use once the pool clearly outgrew it.
+- (void)pruneStringsUsedBy:(NSHashTable *)used {
+	CFIndex count = CFDictionaryGetCount(_strings);
+	if ((NSUInteger)count <= [used count] * 2 + 256)
+		return;
+	const void ** keys = malloc(sizeof(void *) * count);
+	const void ** values = malloc(sizeof(void *) * count);
+	CFDictionaryGetKeysAndValues(_strings, keys, values);
+	for (CFIndex i = 0; i < count; i++) {
+		if (![used containsObject:((__bridge TRBInternedString *)values[i]).string])
+			CFDictionaryRemoveValue(_strings, keys[i]);
+	}
+	free(keys);
+	free(values);
+}
+
+@end